@@ -0,0 +1,54 @@
+/* backend.h  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+#include <bench/bench.h>
+
+typedef struct bench_suite_t bench_suite_t;
+
+//! Kernel table with its chain values and constants, compiled for one backend
+struct bench_suite_t {
+	const char* name;
+	size_t length;
+	const bench_entry_t* entries;
+	size_t count;
+	const void* initial;
+	size_t value_size;
+	const void* constants;
+};
+
+//! Number of suites, the vector, matrix and quaternion kernel tables
+#define BENCH_SUITE_COUNT 5
+
+/* Get the kernel suites compiled with the given backend. All backends return the same suites
+   in the same order. Returns false if the backend is not available in this build, in which
+   case the suites are left untouched. */
+
+bool
+bench_suites_fallback(bench_suite_t* suites);
+
+bool
+bench_suites_sse2(bench_suite_t* suites);
+
+bool
+bench_suites_sse3(bench_suite_t* suites);
+
+bool
+bench_suites_sse4(bench_suite_t* suites);
@@ -0,0 +1,74 @@
+/* kernel.h  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/* Kernel suites, included once by each backend translation unit after selecting the backend
+   with test/backend.h and including vector.h */
+
+#include "backend.h"
+
+#if VECTOR_TEST_BACKEND_AVAILABLE
+
+#include "../vector/kernels.h"
+#include "../matrix/kernels.h"
+#include "../quaternion/kernels.h"
+
+#define BENCH_SUITE(suite, suite_name, table, initial_values, constant_values) \
+	suite.name = suite_name; \
+	suite.length = sizeof(suite_name) - 1; \
+	suite.entries = table; \
+	suite.count = sizeof(table) / sizeof(table[0]); \
+	suite.initial = initial_values; \
+	suite.value_size = sizeof(initial_values[0]); \
+	suite.constants = constant_values
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(bench_suites)(bench_suite_t* suites) {
+	static VECTOR_ALIGN vector_t vector_initial[BENCH_STREAMS];
+	static VECTOR_ALIGN vector_t vector_constants[3];
+	static VECTOR_ALIGN matrix_t matrix_initial[BENCH_STREAMS];
+	static VECTOR_ALIGN vector_t matrix_initial_vector[BENCH_STREAMS];
+	static VECTOR_ALIGN matrix_t matrix_constants[3];
+	static VECTOR_ALIGN quaternion_t quaternion_initial[BENCH_STREAMS];
+	static VECTOR_ALIGN vector_t quaternion_initial_vector[BENCH_STREAMS];
+	static VECTOR_ALIGN quaternion_t quaternion_constants[3];
+
+	bench_vector_setup(vector_initial, vector_constants);
+	bench_matrix_setup(matrix_initial, matrix_initial_vector, matrix_constants);
+	bench_quaternion_setup(quaternion_initial, quaternion_initial_vector, quaternion_constants);
+
+	BENCH_SUITE(suites[0], "vector", bench_vector_kernels, vector_initial, vector_constants);
+	BENCH_SUITE(suites[1], "matrix", bench_matrix_kernels, matrix_initial, matrix_constants);
+	BENCH_SUITE(suites[2], "matrix, vector chains", bench_matrix_vector_kernels, matrix_initial_vector,
+	            matrix_constants);
+	BENCH_SUITE(suites[3], "quaternion", bench_quaternion_kernels, quaternion_initial,
+	            quaternion_constants);
+	BENCH_SUITE(suites[4], "quaternion, vector chains", bench_quaternion_vector_kernels, quaternion_initial_vector,
+	            quaternion_constants);
+
+	return true;
+}
+
+#undef BENCH_SUITE
+
+#else
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(bench_suites)(bench_suite_t* suites) {
+	FOUNDATION_UNUSED(suites);
+	return false;
+}
+
+#endif
@@ -0,0 +1,164 @@
+/* main.c  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <vector/vector.h>
+#include <bench/bench.h>
+
+#include "backend.h"
+#include "../../test/test/backend.h"
+
+/* The same kernels compiled once per backend, printed side by side as latency and throughput
+   per backend. A backend slower than a lower tier backend by more than the threshold is marked
+   with '!', for example when a dot product instruction is slower than the shuffle sequence */
+
+//Relative slowdown compared to the best lower tier backend before a result is marked
+#define BENCH_BACKEND_THRESHOLD 1.1
+
+static const char* const _backend_name[VECTOR_TEST_BACKEND_COUNT] = {
+	"fallback",
+	"SSE2",
+	"SSE3",
+	"SSE4"
+};
+
+//Backend names in output records, see bench_record_t
+static const char* const _backend_id[VECTOR_TEST_BACKEND_COUNT] = {
+	"fallback",
+	"sse2",
+	"sse3",
+	"sse4"
+};
+
+int
+main_initialize(void) {
+	int ret = 0;
+	application_t application;
+	foundation_config_t config;
+	vector_config_t vector_config;
+
+	memset(&application, 0, sizeof(application));
+	application.name = string_const(STRING_CONST("Backend benchmarks"));
+	application.short_name = string_const(STRING_CONST("bench_backend"));
+	application.company = string_const(STRING_CONST("Rampant Pixels"));
+	application.version = vector_module_version();
+	application.flags = APPLICATION_UTILITY;
+
+	log_enable_prefix(false);
+
+	memset(&config, 0, sizeof(config));
+	if ((ret = foundation_initialize(memory_system_malloc(), application, config)) < 0)
+		return ret;
+
+	memset(&vector_config, 0, sizeof(vector_config));
+	if ((ret = vector_module_initialize(vector_config)) < 0)
+		return ret;
+
+	return bench_initialize();
+}
+
+static void
+bench_backend_header(const char* name, size_t length, const bool* available) {
+	char buffer[256];
+	string_t line;
+	int ibackend;
+
+	log_infof(HASH_TOOL, STRING_CONST("\n%.*s (%s per operation, latency/throughput)"), (int)length, name,
+	          bench_has_cycles() ? "cycles" : "ns");
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-32s"), "function");
+	for (ibackend = 0; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+		if (available[ibackend])
+			line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %17s"),
+			                            _backend_name[ibackend]);
+	}
+	log_info(HASH_TOOL, STRING_ARGS(line));
+}
+
+static void
+bench_backend_row(const char* name, size_t length, const bool* available, const bench_result_t* results) {
+	char buffer[256];
+	string_t line;
+	double latency, throughput;
+	double best_latency = 0, best_throughput = 0;
+	bool have_best = false;
+	int ibackend;
+
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-32.*s"), (int)length, name);
+	for (ibackend = 0; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+		bool slower;
+		if (!available[ibackend])
+			continue;
+		latency = bench_has_cycles() ? results[ibackend].latency_cycles : results[ibackend].latency_ns;
+		throughput = bench_has_cycles() ? results[ibackend].throughput_cycles : results[ibackend].throughput_ns;
+		slower = have_best && ((latency > best_latency * BENCH_BACKEND_THRESHOLD) ||
+		                       (throughput > best_throughput * BENCH_BACKEND_THRESHOLD));
+		line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %8.2f/%-7.2f%c"),
+		                            latency, throughput, slower ? '!' : ' ');
+		if (!have_best || (latency < best_latency))
+			best_latency = latency;
+		if (!have_best || (throughput < best_throughput))
+			best_throughput = throughput;
+		have_best = true;
+	}
+	log_info(HASH_TOOL, STRING_ARGS(line));
+}
+
+int
+main_run(void* main_arg) {
+	bench_suite_t suites[VECTOR_TEST_BACKEND_COUNT][BENCH_SUITE_COUNT];
+	bench_result_t results[VECTOR_TEST_BACKEND_COUNT];
+	bool available[VECTOR_TEST_BACKEND_COUNT];
+	size_t isuite, ientry;
+	int ibackend;
+	FOUNDATION_UNUSED(main_arg);
+
+	available[VECTOR_TEST_BACKEND_FALLBACK] = bench_suites_fallback(suites[VECTOR_TEST_BACKEND_FALLBACK]);
+	available[VECTOR_TEST_BACKEND_SSE2] = bench_suites_sse2(suites[VECTOR_TEST_BACKEND_SSE2]);
+	available[VECTOR_TEST_BACKEND_SSE3] = bench_suites_sse3(suites[VECTOR_TEST_BACKEND_SSE3]);
+	available[VECTOR_TEST_BACKEND_SSE4] = bench_suites_sse4(suites[VECTOR_TEST_BACKEND_SSE4]);
+
+	for (isuite = 0; isuite < BENCH_SUITE_COUNT; ++isuite) {
+		const bench_suite_t* reference = &suites[VECTOR_TEST_BACKEND_FALLBACK][isuite];
+		bench_backend_header(reference->name, reference->length, available);
+		for (ientry = 0; ientry < reference->count; ++ientry) {
+			const bench_entry_t* entry = &reference->entries[ientry];
+			if (!bench_enabled(entry->name, entry->length))
+				continue;
+			for (ibackend = 0; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+				const bench_suite_t* suite = &suites[ibackend][isuite];
+				if (!available[ibackend])
+					continue;
+				FOUNDATION_ASSERT(suite->count == reference->count);
+				bench_measure_function(suite->entries[ientry].latency, suite->entries[ientry].throughput,
+				                       suite->initial, suite->value_size, suite->constants, &results[ibackend]);
+				bench_output_result(string_const(reference->name, reference->length),
+				                    string_const(entry->name, entry->length),
+				                    string_const(_backend_id[ibackend], string_length(_backend_id[ibackend])),
+				                    &results[ibackend]);
+			}
+			bench_backend_row(entry->name, entry->length, available, results);
+		}
+	}
+
+	return 0;
+}
+
+void
+main_finalize(void) {
+	bench_finalize();
+	vector_module_finalize();
+	foundation_finalize();
+}
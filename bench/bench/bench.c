@@ -0,0 +1,531 @@
+/* bench.c  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+//For syscall, used for perf_event_open
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
+#include <foundation/foundation.h>
+#include <vector/vector.h>
+
+#include <bench/bench.h>
+
+#if FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64
+#  if FOUNDATION_COMPILER_MSVC
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#  define BENCH_HAVE_TSC 1
+#else
+#  define BENCH_HAVE_TSC 0
+#endif
+
+#if FOUNDATION_PLATFORM_LINUX || FOUNDATION_PLATFORM_ANDROID
+#  include <foundation/posix.h>
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  define BENCH_HAVE_PERF 1
+#else
+#  define BENCH_HAVE_PERF 0
+#endif
+
+static string_const_t _bench_filter;
+static unsigned int _bench_samples = 9;
+static tick_t _bench_sample_ticks;
+static vector_fpenv_t _bench_fpenv;
+static VECTOR_ALIGN uint8_t _bench_state[BENCH_STREAMS * BENCH_VALUE_MAX_SIZE];
+static bool _bench_counters;
+static string_const_t _bench_group;
+static stream_t* _bench_output;
+static bool _bench_output_csv;
+static size_t _bench_output_count;
+
+#if BENCH_HAVE_PERF
+//File descriptors of the counter group, the cycle counter is the group leader
+static int _bench_counter_fd[BENCH_COUNTER_COUNT];
+//Position of each counter in the group read, or -1 if the event could not be opened
+static int _bench_counter_index[BENCH_COUNTER_COUNT];
+static int _bench_counter_open;
+#endif
+
+static uint64_t
+bench_tsc(void) {
+#if BENCH_HAVE_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+#if BENCH_HAVE_PERF
+
+static int
+bench_perf_open(uint32_t type, uint64_t config, int group) {
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = (group < 0) ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+	return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static bool
+bench_counters_open(void) {
+	static const uint32_t type[BENCH_COUNTER_COUNT] = {
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE
+	};
+	static const uint64_t config[BENCH_COUNTER_COUNT] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES
+	};
+	int icounter;
+
+	_bench_counter_open = 0;
+	for (icounter = 0; icounter < BENCH_COUNTER_COUNT; ++icounter) {
+		const int group = icounter ? _bench_counter_fd[BENCH_COUNTER_CYCLES] : -1;
+		_bench_counter_fd[icounter] = bench_perf_open(type[icounter], config[icounter], group);
+		_bench_counter_index[icounter] = (_bench_counter_fd[icounter] >= 0) ? _bench_counter_open++ : -1;
+		if (!icounter && (_bench_counter_fd[icounter] < 0)) {
+			log_warnf(HASH_TOOL, WARNING_UNSUPPORTED,
+			          STRING_CONST("Unable to open performance counters (error %d), check perf_event_paranoid"),
+			          system_error());
+			return false;
+		}
+	}
+	return true;
+}
+
+static void
+bench_counters_close(void) {
+	int icounter;
+	for (icounter = 0; icounter < BENCH_COUNTER_COUNT; ++icounter) {
+		if (_bench_counter_index[icounter] >= 0)
+			close(_bench_counter_fd[icounter]);
+		_bench_counter_index[icounter] = -1;
+	}
+}
+
+#endif
+
+static bool
+bench_output_open(string_const_t path, string_const_t format) {
+	if (format.length)
+		_bench_output_csv = string_equal(STRING_ARGS(format), STRING_CONST("csv"));
+	else
+		_bench_output_csv = (path.length > 4) &&
+		                    string_equal(path.str + path.length - 4, 4, STRING_CONST(".csv"));
+	if (format.length && !_bench_output_csv && !string_equal(STRING_ARGS(format), STRING_CONST("json"))) {
+		log_errorf(HASH_TOOL, ERROR_INVALID_VALUE, STRING_CONST("Unknown output format: %.*s"),
+		           STRING_FORMAT(format));
+		return false;
+	}
+
+	_bench_output = stream_open(STRING_ARGS(path), STREAM_OUT | STREAM_CREATE | STREAM_TRUNCATE);
+	if (!_bench_output) {
+		log_errorf(HASH_TOOL, ERROR_SYSTEM_CALL_FAIL, STRING_CONST("Unable to open output file: %.*s"),
+		           STRING_FORMAT(path));
+		return false;
+	}
+	_bench_output_count = 0;
+	if (_bench_output_csv)
+		stream_write_format(_bench_output, STRING_CONST("group,function,backend,mode,size,ns,cycles,noise,"
+		                                                "counter_cycles,instructions,l1d_misses,llc_misses,"
+		                                                "branch_misses\n"));
+	else
+		stream_write_format(_bench_output, STRING_CONST("{\n  \"results\": ["));
+	return true;
+}
+
+static void
+bench_output_close(void) {
+	if (!_bench_output)
+		return;
+	if (!_bench_output_csv)
+		stream_write_format(_bench_output, STRING_CONST("%s]\n}\n"), _bench_output_count ? "\n  " : "");
+	stream_deallocate(_bench_output);
+	_bench_output = 0;
+}
+
+int
+bench_initialize(void) {
+	const string_const_t* cmdline = environment_command_line();
+	size_t iarg, asize;
+	unsigned int sample_ms = 2;
+	string_const_t output = string_null();
+	string_const_t format = string_null();
+
+	for (iarg = 1, asize = array_size(cmdline); iarg < asize; ++iarg) {
+		const string_const_t arg = cmdline[iarg];
+		const string_const_t value = (iarg < asize - 1) ? cmdline[iarg + 1] : string_null();
+		if (string_equal(STRING_ARGS(arg), STRING_CONST("--counters"))) {
+			_bench_counters = true;
+			continue;
+		}
+		if (!value.length)
+			continue;
+		if (string_equal(STRING_ARGS(arg), STRING_CONST("--filter")))
+			_bench_filter = value;
+		else if (string_equal(STRING_ARGS(arg), STRING_CONST("--samples")))
+			_bench_samples = string_to_uint(STRING_ARGS(value), false);
+		else if (string_equal(STRING_ARGS(arg), STRING_CONST("--time")))
+			sample_ms = string_to_uint(STRING_ARGS(value), false);
+		else if (string_equal(STRING_ARGS(arg), STRING_CONST("--output")))
+			output = value;
+		else if (string_equal(STRING_ARGS(arg), STRING_CONST("--format")))
+			format = value;
+		else
+			continue;
+		++iarg;
+	}
+	if (!_bench_samples)
+		_bench_samples = 1;
+	if (_bench_samples > BENCH_SAMPLES_MAX)
+		_bench_samples = BENCH_SAMPLES_MAX;
+	_bench_sample_ticks = (time_ticks_per_second() * sample_ms) / 1000;
+	if (!_bench_sample_ticks)
+		_bench_sample_ticks = 1;
+
+#if BENCH_HAVE_PERF
+	if (_bench_counters)
+		_bench_counters = bench_counters_open();
+#else
+	if (_bench_counters)
+		log_warn(HASH_TOOL, WARNING_UNSUPPORTED, STRING_CONST("Performance counters not supported on this platform"));
+	_bench_counters = false;
+#endif
+
+	if (output.length && !bench_output_open(output, format))
+		return -1;
+
+	//Denormals would make the timing depend on how chain values drift
+	_bench_fpenv = vector_fpenv_set(VECTOR_FPENV_FLUSH_TO_ZERO | VECTOR_FPENV_DENORMALS_ARE_ZERO,
+	                                VECTOR_ROUND_DEFAULT);
+
+	return 0;
+}
+
+void
+bench_finalize(void) {
+	vector_fpenv_restore(_bench_fpenv);
+	bench_output_close();
+#if BENCH_HAVE_PERF
+	if (_bench_counters)
+		bench_counters_close();
+#endif
+	_bench_counters = false;
+}
+
+void
+bench_group(const char* name, size_t length) {
+	char buffer[256];
+	string_t line;
+	_bench_group = string_const(name, length);
+	log_infof(HASH_TOOL, STRING_CONST("\n%.*s"), (int)length, name);
+#if BENCH_HAVE_TSC
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-32s %12s %10s %12s %10s"),
+	                     "function", "latency ns", "cycles", "through ns", "cycles");
+#else
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-32s %12s %12s"), "function", "latency ns",
+	                     "through ns");
+#endif
+	if (_bench_counters)
+		line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %7s %8s %8s %8s %8s"),
+		                            "ipc", "inst", "l1d miss", "llc miss", "br miss");
+	log_info(HASH_TOOL, STRING_ARGS(line));
+}
+
+//Returns the calibrated iteration count
+static size_t
+bench_measure(bench_kernel_fn kernel, const void* initial, size_t state_size, const void* constants,
+              size_t ops_per_iteration, double* ns, double* cycles, double* noise) {
+	size_t count = 16;
+	tick_t elapsed, best_ticks = 0;
+	tick_t ticks[BENCH_SAMPLES_MAX];
+	uint64_t tsc, best_tsc = 0;
+	unsigned int isample;
+
+	//Calibrate, also serves as warmup
+	do {
+		count *= 2;
+		memcpy(_bench_state, initial, state_size);
+		elapsed = time_current();
+		kernel(_bench_state, constants, count);
+		elapsed = time_elapsed_ticks(elapsed);
+	} while ((elapsed < _bench_sample_ticks) && (count < ((size_t)1 << 30)));
+
+	for (isample = 0; isample < _bench_samples; ++isample) {
+		memcpy(_bench_state, initial, state_size);
+		elapsed = time_current();
+		tsc = bench_tsc();
+		kernel(_bench_state, constants, count);
+		tsc = bench_tsc() - tsc;
+		elapsed = time_elapsed_ticks(elapsed);
+		ticks[isample] = elapsed;
+		if (!isample || (elapsed < best_ticks)) {
+			best_ticks = elapsed;
+			best_tsc = tsc;
+		}
+	}
+
+	*ns = (time_ticks_to_seconds(best_ticks) * 1000000000.0) / (double)(count * ops_per_iteration);
+	*cycles = (double)best_tsc / (double)(count * ops_per_iteration);
+	*noise = bench_sample_noise(ticks, _bench_samples);
+	return count;
+}
+
+bool
+bench_enabled(const char* name, size_t length) {
+	return !_bench_filter.length ||
+	       (string_find_string(name, length, STRING_ARGS(_bench_filter), 0) != STRING_NPOS);
+}
+
+bool
+bench_has_cycles(void) {
+	return BENCH_HAVE_TSC;
+}
+
+unsigned int
+bench_sample_count(void) {
+	return _bench_samples;
+}
+
+tick_t
+bench_sample_time(void) {
+	return _bench_sample_ticks;
+}
+
+double
+bench_sample_noise(tick_t* samples, unsigned int count) {
+	unsigned int isample, imove;
+	tick_t median;
+
+	if (!count)
+		return 0;
+	//Insertion sort, sample counts are small
+	for (isample = 1; isample < count; ++isample) {
+		const tick_t sample = samples[isample];
+		for (imove = isample; (imove > 0) && (samples[imove - 1] > sample); --imove)
+			samples[imove] = samples[imove - 1];
+		samples[imove] = sample;
+	}
+	median = (count & 1) ? samples[count / 2] : (samples[(count / 2) - 1] + samples[count / 2]) / 2;
+	return (samples[0] > 0) ? (double)(median - samples[0]) / (double)samples[0] : 0;
+}
+
+string_const_t
+bench_backend(void) {
+#if VECTOR_IMPLEMENTATION_SSE4
+	return string_const(STRING_CONST("sse4"));
+#elif VECTOR_IMPLEMENTATION_SSE3
+	return string_const(STRING_CONST("sse3"));
+#elif VECTOR_IMPLEMENTATION_SSE2
+	return string_const(STRING_CONST("sse2"));
+#elif VECTOR_IMPLEMENTATION_NEON
+	return string_const(STRING_CONST("neon"));
+#else
+	return string_const(STRING_CONST("fallback"));
+#endif
+}
+
+//Write a value, or an empty CSV field or JSON null if negative (not available)
+static void
+bench_output_value(const char* name, double value) {
+	if (_bench_output_csv) {
+		if (value >= 0)
+			stream_write_format(_bench_output, STRING_CONST(",%.6g"), value);
+		else
+			stream_write_format(_bench_output, STRING_CONST(","));
+	}
+	else {
+		if (value >= 0)
+			stream_write_format(_bench_output, STRING_CONST(", \"%s\": %.6g"), name, value);
+		else
+			stream_write_format(_bench_output, STRING_CONST(", \"%s\": null"), name);
+	}
+}
+
+void
+bench_output(const bench_record_t* record) {
+	static const char* const counter_name[BENCH_COUNTER_COUNT] = {
+		"counter_cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+	};
+	int icounter;
+
+	if (!_bench_output)
+		return;
+
+	//Names are identifiers or plain text from the benchmarks and need no quoting or escaping
+	if (_bench_output_csv)
+		stream_write_format(_bench_output, STRING_CONST("%.*s,%.*s,%.*s,%.*s,%" PRIsize ",%.6g"),
+		                    STRING_FORMAT(record->group), STRING_FORMAT(record->function),
+		                    STRING_FORMAT(record->backend), STRING_FORMAT(record->mode), record->size, record->ns);
+	else
+		stream_write_format(_bench_output, STRING_CONST("%s\n    {\"group\": \"%.*s\", \"function\": \"%.*s\", "
+		                                                "\"backend\": \"%.*s\", \"mode\": \"%.*s\", "
+		                                                "\"size\": %" PRIsize ", \"ns\": %.6g"),
+		                    _bench_output_count ? "," : "", STRING_FORMAT(record->group),
+		                    STRING_FORMAT(record->function), STRING_FORMAT(record->backend),
+		                    STRING_FORMAT(record->mode), record->size, record->ns);
+	bench_output_value("cycles", record->cycles);
+	bench_output_value("noise", record->noise);
+	for (icounter = 0; icounter < BENCH_COUNTER_COUNT; ++icounter)
+		bench_output_value(counter_name[icounter], record->counters ? record->counters[icounter] : -1.0);
+	stream_write_format(_bench_output, _bench_output_csv ? "\n" : "}", 1);
+	++_bench_output_count;
+}
+
+void
+bench_output_result(string_const_t group, string_const_t function, string_const_t backend,
+                    const bench_result_t* result) {
+	bench_record_t record;
+
+	memset(&record, 0, sizeof(record));
+	record.group = group;
+	record.function = function;
+	record.backend = backend;
+	record.mode = string_const(STRING_CONST("latency"));
+	record.ns = result->latency_ns;
+	record.cycles = bench_has_cycles() ? result->latency_cycles : -1.0;
+	record.noise = result->latency_noise;
+	bench_output(&record);
+
+	//Counters are only captured in throughput mode
+	record.mode = string_const(STRING_CONST("throughput"));
+	record.ns = result->throughput_ns;
+	record.cycles = bench_has_cycles() ? result->throughput_cycles : -1.0;
+	record.noise = result->throughput_noise;
+	record.counters = result->counters;
+	bench_output(&record);
+}
+
+bool
+bench_has_counters(void) {
+	return _bench_counters;
+}
+
+void
+bench_counters_start(void) {
+#if BENCH_HAVE_PERF
+	if (!_bench_counters)
+		return;
+	ioctl(_bench_counter_fd[BENCH_COUNTER_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(_bench_counter_fd[BENCH_COUNTER_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void
+bench_counters_stop(double* counters, size_t ops) {
+	int icounter;
+#if BENCH_HAVE_PERF
+	uint64_t values[BENCH_COUNTER_COUNT + 1];
+	if (_bench_counters) {
+		ioctl(_bench_counter_fd[BENCH_COUNTER_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		//Group read format is the number of counters followed by the values
+		if (read(_bench_counter_fd[BENCH_COUNTER_CYCLES], values, sizeof(values)) > 0) {
+			for (icounter = 0; icounter < BENCH_COUNTER_COUNT; ++icounter) {
+				const int index = _bench_counter_index[icounter];
+				counters[icounter] = ((index >= 0) && ops) ? (double)values[index + 1] / (double)ops : -1.0;
+			}
+			return;
+		}
+	}
+#endif
+	FOUNDATION_UNUSED(ops);
+	for (icounter = 0; icounter < BENCH_COUNTER_COUNT; ++icounter)
+		counters[icounter] = -1.0;
+}
+
+void
+bench_measure_function(bench_kernel_fn latency, bench_kernel_fn throughput, const void* initial,
+                       size_t value_size, const void* constants, bench_result_t* result) {
+	size_t count;
+
+	FOUNDATION_ASSERT(value_size <= BENCH_VALUE_MAX_SIZE);
+	bench_measure(latency, initial, value_size, constants, 1, &result->latency_ns, &result->latency_cycles,
+	              &result->latency_noise);
+	count = bench_measure(throughput, initial, value_size * BENCH_STREAMS, constants, BENCH_STREAMS,
+	                      &result->throughput_ns, &result->throughput_cycles, &result->throughput_noise);
+
+	//Counters are captured in a separate throughput run so the timed samples are not disturbed
+	memcpy(_bench_state, initial, value_size * BENCH_STREAMS);
+	bench_counters_start();
+	if (_bench_counters)
+		throughput(_bench_state, constants, count);
+	bench_counters_stop(result->counters, count * BENCH_STREAMS);
+}
+
+static void
+bench_format_counters(char* buffer, size_t capacity, string_t* line, const double* counters) {
+	const double cycles = counters[BENCH_COUNTER_CYCLES];
+	const double instructions = counters[BENCH_COUNTER_INSTRUCTIONS];
+	int icounter;
+
+	if ((cycles > 0) && (instructions >= 0))
+		*line = string_append_format(buffer, line->length, capacity, STRING_CONST(" %7.2f"), instructions / cycles);
+	else
+		*line = string_append(buffer, line->length, capacity, STRING_CONST("       -"));
+	for (icounter = BENCH_COUNTER_INSTRUCTIONS; icounter < BENCH_COUNTER_COUNT; ++icounter) {
+		if (counters[icounter] >= 0)
+			*line = string_append_format(buffer, line->length, capacity, STRING_CONST(" %8.3f"), counters[icounter]);
+		else
+			*line = string_append(buffer, line->length, capacity, STRING_CONST("        -"));
+	}
+}
+
+void
+bench_function(const char* name, size_t length, bench_kernel_fn latency, bench_kernel_fn throughput,
+               const void* initial, size_t value_size, const void* constants) {
+	bench_result_t result;
+	char buffer[256];
+	string_t line;
+
+	if (!bench_enabled(name, length))
+		return;
+
+	bench_measure_function(latency, throughput, initial, value_size, constants, &result);
+
+#if BENCH_HAVE_TSC
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-32.*s %12.3f %10.2f %12.3f %10.2f"), (int)length,
+	                     name, result.latency_ns, result.latency_cycles, result.throughput_ns, result.throughput_cycles);
+#else
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-32.*s %12.3f %12.3f"), (int)length, name,
+	                     result.latency_ns, result.throughput_ns);
+#endif
+	if (_bench_counters)
+		bench_format_counters(buffer, sizeof(buffer), &line, result.counters);
+	log_info(HASH_TOOL, STRING_ARGS(line));
+
+	bench_output_result(_bench_group, string_const(name, length), bench_backend(), &result);
+}
+
+void
+bench_functions(const bench_entry_t* entries, size_t count, const void* initial, size_t value_size,
+                const void* constants) {
+	size_t ientry;
+	for (ientry = 0; ientry < count; ++ientry)
+		bench_function(entries[ientry].name, entries[ientry].length, entries[ientry].latency,
+		               entries[ientry].throughput, initial, value_size, constants);
+}
@@ -0,0 +1,240 @@
+/* bench.h  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file bench.h
+    Microbenchmark harness. Each function is timed in two modes:
+
+    - latency, a single dependent chain where every result is the input of the next call
+    - throughput, BENCH_STREAMS independent chains interleaved in the same loop
+
+    Kernels are generated with BENCH_KERNELS from an expression of the chain value v and the
+    constant operands c0, c1 and c2, and run with BENCH_FUNCTION or collected in tables of
+    BENCH_ENTRY for bench_functions. Iteration counts are calibrated per function to a minimum
+    sample time, the chain is reset to its initial values before each sample and the best sample
+    is reported in nanoseconds and cycles per operation.
+    Cycles are timestamp counter cycles, which run at the nominal frequency and not the actual
+    core clock when frequency scaling is active. Denormals are flushed to zero while running.
+
+    Command line options
+      --filter <text>    Only run functions with names containing the text
+      --samples <n>      Number of timed samples per function and mode (default 9)
+      --time <ms>        Minimum time per sample in milliseconds (default 2)
+      --counters         Capture hardware counters through perf_event_open (Linux only),
+                         reported per operation in throughput mode as instructions per
+                         cycle, instructions, L1 data read misses, last level cache misses
+                         and branch mispredictions. Requires perf_event_paranoid <= 2
+      --output <file>    Write results to a file, as CSV if the name ends in .csv and JSON
+                         otherwise. Compare two result files with bench/compare.py
+      --format <format>  Output file format, json or csv, overrides the file name extension
+
+    Output records hold group, function, backend, mode, size, nanoseconds and timestamp counter
+    cycles per operation, the relative sample noise and the counters. The noise is the relative
+    difference between the median and the best sample, compare.py uses it to tell regressions
+    from measurement noise. */
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+//! Number of independent chains in throughput mode
+#define BENCH_STREAMS 8
+
+//! Maximum number of timed samples, larger --samples values are clamped
+#define BENCH_SAMPLES_MAX 64
+
+/*! Benchmark kernel, run count iterations over the chain values in state (one value in
+    latency mode, BENCH_STREAMS values in throughput mode) with the given constants */
+typedef void (*bench_kernel_fn)(void* state, const void* constants, size_t count);
+
+//! Hardware performance counters captured with --counters
+typedef enum bench_counter_t {
+	BENCH_COUNTER_CYCLES = 0,
+	BENCH_COUNTER_INSTRUCTIONS,
+	BENCH_COUNTER_L1D_MISSES,
+	BENCH_COUNTER_LLC_MISSES,
+	BENCH_COUNTER_BRANCH_MISSES,
+	BENCH_COUNTER_COUNT
+} bench_counter_t;
+
+typedef struct bench_entry_t bench_entry_t;
+typedef struct bench_result_t bench_result_t;
+typedef struct bench_record_t bench_record_t;
+
+//! Function in a kernel table, see BENCH_ENTRY
+struct bench_entry_t {
+	const char* name;
+	size_t length;
+	bench_kernel_fn latency;
+	bench_kernel_fn throughput;
+};
+
+//! Timing of a function in nanoseconds and cycles per operation
+struct bench_result_t {
+	double latency_ns;
+	double latency_cycles;
+	double throughput_ns;
+	double throughput_cycles;
+	//! Sample noise in latency and throughput mode, see bench_sample_noise
+	double latency_noise;
+	double throughput_noise;
+	//! Counters per operation in throughput mode, negative if not captured
+	double counters[BENCH_COUNTER_COUNT];
+};
+
+//! Result written to the output file, see bench_output
+struct bench_record_t {
+	string_const_t group;
+	string_const_t function;
+	//! Backend the function was compiled with, lower case (fallback, sse2, sse3, sse4, neon)
+	string_const_t backend;
+	//! What an operation is, for example latency, throughput or frame
+	string_const_t mode;
+	//! Working set in bytes or number of elements, zero for single operations
+	size_t size;
+	//! Best sample time per operation
+	double ns;
+	//! Timestamp counter cycles per operation, negative if not available
+	double cycles;
+	//! Sample noise, see bench_sample_noise
+	double noise;
+	//! Counters per operation, null or negative values if not captured
+	const double* counters;
+};
+
+//! Parse command line and prepare timing. Returns <0 on failure
+int
+bench_initialize(void);
+
+void
+bench_finalize(void);
+
+//! Print a group name and the column header for bench_function
+void
+bench_group(const char* name, size_t length);
+
+/*! Time a function in latency and throughput mode. The initial state holds BENCH_STREAMS
+    chain values of value_size bytes each, at most BENCH_VALUE_MAX_SIZE */
+void
+bench_function(const char* name, size_t length, bench_kernel_fn latency, bench_kernel_fn throughput,
+               const void* initial, size_t value_size, const void* constants);
+
+//! Time all functions in a table sharing the same chain type, see bench_function
+void
+bench_functions(const bench_entry_t* entries, size_t count, const void* initial, size_t value_size,
+                const void* constants);
+
+//! Check if a function passes the --filter option
+bool
+bench_enabled(const char* name, size_t length);
+
+//! Time a function without printing the result, see bench_function
+void
+bench_measure_function(bench_kernel_fn latency, bench_kernel_fn throughput, const void* initial,
+                       size_t value_size, const void* constants, bench_result_t* result);
+
+//! Check if results include timestamp counter cycles
+bool
+bench_has_cycles(void);
+
+//! Number of timed samples given with --samples, for benchmarks with their own timing loops
+unsigned int
+bench_sample_count(void);
+
+//! Minimum time per sample given with --time, for benchmarks with their own timing loops
+tick_t
+bench_sample_time(void);
+
+/*! Get the relative difference between the median and the best of the sample times. The
+    samples are sorted in place */
+double
+bench_sample_noise(tick_t* samples, unsigned int count);
+
+//! Get the backend the harness was compiled with, in the form used for bench_record_t
+string_const_t
+bench_backend(void);
+
+//! Write a record to the output file given with --output, does nothing without an output file
+void
+bench_output(const bench_record_t* record);
+
+//! Write the latency and throughput records of a function result, see bench_output
+void
+bench_output_result(string_const_t group, string_const_t function, string_const_t backend,
+                    const bench_result_t* result);
+
+//! Check if hardware counters are captured
+bool
+bench_has_counters(void);
+
+//! Reset and start the hardware counters, does nothing if counters are not captured
+void
+bench_counters_start(void);
+
+/*! Stop the hardware counters and store the counts divided by the number of operations,
+    counters which are not available are stored as negative values */
+void
+bench_counters_stop(double* counters, size_t ops);
+
+#define BENCH_VALUE_MAX_SIZE 64
+
+/*! Define latency and throughput kernels for a function named name, computing expr from the
+    chain value v of the given type and constants c0, c1, c2 of type ctype */
+#define BENCH_KERNELS(type, ctype, name, expr) \
+	static void bench_latency_##name(void* state, const void* constants, size_t count) { \
+		type* chain = state; \
+		const ctype* c = constants; \
+		const ctype c0 = c[0]; \
+		const ctype c1 = c[1]; \
+		const ctype c2 = c[2]; \
+		type v = chain[0]; \
+		size_t i; \
+		(void)c0; (void)c1; (void)c2; \
+		for (i = 0; i < count; ++i) \
+			v = (expr); \
+		chain[0] = v; \
+	} \
+	static void bench_throughput_##name(void* state, const void* constants, size_t count) { \
+		type* chain = state; \
+		const ctype* c = constants; \
+		const ctype c0 = c[0]; \
+		const ctype c1 = c[1]; \
+		const ctype c2 = c[2]; \
+		type s0 = chain[0], s1 = chain[1], s2 = chain[2], s3 = chain[3]; \
+		type s4 = chain[4], s5 = chain[5], s6 = chain[6], s7 = chain[7]; \
+		size_t i; \
+		(void)c0; (void)c1; (void)c2; \
+		for (i = 0; i < count; ++i) { \
+			{ const type v = s0; s0 = (expr); } \
+			{ const type v = s1; s1 = (expr); } \
+			{ const type v = s2; s2 = (expr); } \
+			{ const type v = s3; s3 = (expr); } \
+			{ const type v = s4; s4 = (expr); } \
+			{ const type v = s5; s5 = (expr); } \
+			{ const type v = s6; s6 = (expr); } \
+			{ const type v = s7; s7 = (expr); } \
+		} \
+		chain[0] = s0; chain[1] = s1; chain[2] = s2; chain[3] = s3; \
+		chain[4] = s4; chain[5] = s5; chain[6] = s6; chain[7] = s7; \
+	}
+
+//! Run kernels defined with BENCH_KERNELS, initial is an array of BENCH_STREAMS chain values
+#define BENCH_FUNCTION(name, initial, constants) \
+	bench_function(STRING_CONST(#name), bench_latency_##name, bench_throughput_##name, \
+	               initial, sizeof((initial)[0]), constants)
+
+//! Kernel table entry for kernels defined with BENCH_KERNELS
+#define BENCH_ENTRY(name) { #name, sizeof(#name) - 1, bench_latency_##name, bench_throughput_##name }
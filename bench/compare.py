@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+
+"""Compare two benchmark result files
+
+Reads the JSON or CSV files written by the benchmarks with --output and compares the time per
+operation of every record present in both, matched on group, function, backend, mode and size.
+A record regresses if it is slower than the baseline by more than the threshold and by more
+than the combined sample noise of the two runs, so noisy measurements are reported but do not
+fail the comparison. Exits with a non-zero code if any record regressed."""
+
+import sys
+import os
+import csv
+import json
+import argparse
+
+def read_results(path):
+  if path.endswith('.csv'):
+    with open(path) as infile:
+      rows = list(csv.DictReader(infile))
+    for row in rows:
+      row['size'] = int(row['size'])
+      for field in ['ns', 'cycles', 'noise']:
+        row[field] = float(row[field]) if row[field] else None
+  else:
+    with open(path) as infile:
+      rows = json.load(infile)['results']
+  results = {}
+  for row in rows:
+    key = (row['group'], row['function'], row['backend'], row['mode'], row['size'])
+    results[key] = row
+  return results
+
+def format_key(key):
+  name = '%s %s %s %s' % (key[0], key[1], key[2], key[3])
+  if key[4]:
+    name += ' ' + str(key[4])
+  return name
+
+def main():
+  parser = argparse.ArgumentParser(description = 'Compare benchmark result files')
+  parser.add_argument('baseline', help = 'Baseline result file')
+  parser.add_argument('current', help = 'Current result file')
+  parser.add_argument('--threshold', type = float, default = 3.0,
+                      help = 'Allowed slowdown in percent (default 3)')
+  parser.add_argument('--metric', choices = ['ns', 'cycles'], default = 'ns',
+                      help = 'Value to compare (default ns)')
+  parser.add_argument('--strict', action = 'store_true',
+                      help = 'Fail on slowdowns above the threshold even if within the noise')
+  parser.add_argument('--verbose', action = 'store_true', help = 'Print all compared records')
+  options = parser.parse_args()
+
+  baseline = read_results(options.baseline)
+  current = read_results(options.current)
+  threshold = options.threshold / 100.0
+
+  regressed = []
+  noisy = []
+  improved = []
+  compared = 0
+  for key in sorted(baseline.keys()):
+    if key not in current:
+      print('%s: missing in %s' % (format_key(key), os.path.basename(options.current)))
+      continue
+    base = baseline[key][options.metric]
+    value = current[key][options.metric]
+    if not base or value is None:
+      continue
+    compared += 1
+    change = (value - base) / base
+    noise = (baseline[key]['noise'] or 0.0) + (current[key]['noise'] or 0.0)
+    line = '%-64s %12.3f %12.3f %+8.1f%% (noise %.1f%%)' % (format_key(key), base, value, change * 100.0, noise * 100.0)
+    if change > threshold:
+      if change > noise or options.strict:
+        regressed += [line]
+      else:
+        noisy += [line]
+    elif change < -max(threshold, noise):
+      improved += [line]
+    elif options.verbose:
+      print(line)
+
+  for key in sorted(current.keys()):
+    if key not in baseline:
+      print('%s: not in %s' % (format_key(key), os.path.basename(options.baseline)))
+
+  for line in improved:
+    print('IMPROVED  ' + line)
+  for line in noisy:
+    print('NOISY     ' + line)
+  for line in regressed:
+    print('REGRESSED ' + line)
+
+  print('%d records compared, %d regressed, %d within noise, %d improved (threshold %.1f%%)' %
+        (compared, len(regressed), len(noisy), len(improved), options.threshold))
+  return 1 if regressed else 0
+
+if __name__ == '__main__':
+  sys.exit(main())
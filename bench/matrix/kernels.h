@@ -0,0 +1,60 @@
+/* kernels.h  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/* Kernels shared by bench-matrix and bench-backend. Include after vector.h and bench.h */
+
+BENCH_KERNELS(matrix_t, matrix_t, matrix_transpose, matrix_transpose(v))
+BENCH_KERNELS(matrix_t, matrix_t, matrix_mul, matrix_mul(v, c0))
+BENCH_KERNELS(matrix_t, matrix_t, matrix_add, matrix_add(v, c1))
+BENCH_KERNELS(matrix_t, matrix_t, matrix_sub, matrix_sub(v, c1))
+BENCH_KERNELS(vector_t, matrix_t, matrix_rotate, matrix_rotate(c0, v))
+BENCH_KERNELS(vector_t, matrix_t, matrix_transform, matrix_transform(c0, v))
+
+static const bench_entry_t bench_matrix_kernels[] = {
+	BENCH_ENTRY(matrix_transpose),
+	BENCH_ENTRY(matrix_mul),
+	BENCH_ENTRY(matrix_add),
+	BENCH_ENTRY(matrix_sub),
+};
+
+//Kernels chaining a vector through a constant matrix
+static const bench_entry_t bench_matrix_vector_kernels[] = {
+	BENCH_ENTRY(matrix_rotate),
+	BENCH_ENTRY(matrix_transform),
+};
+
+static void
+bench_matrix_setup(matrix_t* initial, vector_t* initial_vector, matrix_t* constants) {
+	int istream;
+	//Rotation of 0.1 radians around z with translation, and a small offset matrix
+	constants[0] = matrix_identity();
+	constants[0].row[0] = vector(REAL_C(0.995004), REAL_C(0.0998334), 0, 0);
+	constants[0].row[1] = vector(REAL_C(-0.0998334), REAL_C(0.995004), 0, 0);
+	constants[0].row[3] = vector(REAL_C(0.125), REAL_C(-0.25), REAL_C(0.5), 1);
+	constants[1] = matrix_zero();
+	constants[1].row[0] = vector(REAL_C(0.25), REAL_C(-0.5), REAL_C(0.75), REAL_C(0.125));
+	constants[1].row[3] = vector(REAL_C(0.125), REAL_C(0.25), REAL_C(-0.125), 0);
+	constants[2] = matrix_identity();
+
+	for (istream = 0; istream < BENCH_STREAMS; ++istream) {
+		initial[istream] = constants[0];
+		initial[istream].row[3] = vector((real)istream * REAL_C(0.25), REAL_C(1.0), REAL_C(-2.0), REAL_C(1.0));
+		initial_vector[istream] = vector(REAL_C(0.5) + (real)istream * REAL_C(0.125), REAL_C(-0.75), REAL_C(0.25),
+		                                 REAL_C(1.0));
+	}
+}
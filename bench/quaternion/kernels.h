@@ -0,0 +1,60 @@
+/* kernels.h  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/* Kernels shared by bench-quaternion and bench-backend. Include after vector.h and bench.h */
+
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_conjugate, quaternion_conjugate(v))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_inverse, quaternion_inverse(v))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_neg, quaternion_neg(v))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_normalize, quaternion_normalize(v))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_mul, quaternion_mul(v, c0))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_add, quaternion_add(v, c1))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_sub, quaternion_sub(v, c1))
+BENCH_KERNELS(quaternion_t, quaternion_t, quaternion_slerp, quaternion_slerp(v, c0, REAL_C(0.25)))
+BENCH_KERNELS(vector_t, quaternion_t, quaternion_rotate, quaternion_rotate(c0, v))
+
+static const bench_entry_t bench_quaternion_kernels[] = {
+	BENCH_ENTRY(quaternion_conjugate),
+	BENCH_ENTRY(quaternion_inverse),
+	BENCH_ENTRY(quaternion_neg),
+	BENCH_ENTRY(quaternion_normalize),
+	BENCH_ENTRY(quaternion_mul),
+	BENCH_ENTRY(quaternion_add),
+	BENCH_ENTRY(quaternion_sub),
+	BENCH_ENTRY(quaternion_slerp),
+};
+
+//Kernels chaining a vector through a constant quaternion
+static const bench_entry_t bench_quaternion_vector_kernels[] = {
+	BENCH_ENTRY(quaternion_rotate),
+};
+
+static void
+bench_quaternion_setup(quaternion_t* initial, vector_t* initial_vector, quaternion_t* constants) {
+	int istream;
+	//Unit rotations, so multiplication and slerp chains stay unit length
+	constants[0] = quaternion_normalize(vector(REAL_C(0.1), REAL_C(0.2), REAL_C(-0.3), REAL_C(0.9)));
+	constants[1] = vector(REAL_C(0.25), REAL_C(-0.5), REAL_C(0.75), REAL_C(0.125));
+	constants[2] = quaternion_identity();
+
+	for (istream = 0; istream < BENCH_STREAMS; ++istream) {
+		initial[istream] = quaternion_normalize(vector(REAL_C(-0.2), (real)istream * REAL_C(0.1), REAL_C(0.4),
+		                                               REAL_C(0.8)));
+		initial_vector[istream] = vector(REAL_C(0.5) + (real)istream * REAL_C(0.125), REAL_C(-0.75), REAL_C(0.25), 0);
+	}
+}
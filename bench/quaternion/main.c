@@ -0,0 +1,85 @@
+/* main.c  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <vector/vector.h>
+#include <bench/bench.h>
+
+#include "kernels.h"
+
+int
+main_initialize(void) {
+	int ret = 0;
+	application_t application;
+	foundation_config_t config;
+	vector_config_t vector_config;
+
+	memset(&application, 0, sizeof(application));
+	application.name = string_const(STRING_CONST("Quaternion benchmarks"));
+	application.short_name = string_const(STRING_CONST("bench_quaternion"));
+	application.company = string_const(STRING_CONST("Rampant Pixels"));
+	application.version = vector_module_version();
+	application.flags = APPLICATION_UTILITY;
+
+	log_enable_prefix(false);
+
+	memset(&config, 0, sizeof(config));
+	if ((ret = foundation_initialize(memory_system_malloc(), application, config)) < 0)
+		return ret;
+
+	memset(&vector_config, 0, sizeof(vector_config));
+	if ((ret = vector_module_initialize(vector_config)) < 0)
+		return ret;
+
+	return bench_initialize();
+}
+
+int
+main_run(void* main_arg) {
+	VECTOR_ALIGN quaternion_t initial[BENCH_STREAMS];
+	VECTOR_ALIGN vector_t initial_vector[BENCH_STREAMS];
+	VECTOR_ALIGN quaternion_t constants[3];
+	FOUNDATION_UNUSED(main_arg);
+
+	bench_quaternion_setup(initial, initial_vector, constants);
+
+#if VECTOR_IMPLEMENTATION_SSE4
+	bench_group(STRING_CONST("quaternion (SSE4)"));
+#elif VECTOR_IMPLEMENTATION_SSE3
+	bench_group(STRING_CONST("quaternion (SSE3)"));
+#elif VECTOR_IMPLEMENTATION_SSE2
+	bench_group(STRING_CONST("quaternion (SSE2)"));
+#elif VECTOR_IMPLEMENTATION_NEON
+	bench_group(STRING_CONST("quaternion (NEON)"));
+#else
+	bench_group(STRING_CONST("quaternion (fallback)"));
+#endif
+
+	bench_functions(bench_quaternion_kernels, sizeof(bench_quaternion_kernels) / sizeof(bench_quaternion_kernels[0]),
+	                initial, sizeof(initial[0]), constants);
+	bench_functions(bench_quaternion_vector_kernels,
+	                sizeof(bench_quaternion_vector_kernels) / sizeof(bench_quaternion_vector_kernels[0]),
+	                initial_vector, sizeof(initial_vector[0]), constants);
+
+	return 0;
+}
+
+void
+main_finalize(void) {
+	bench_finalize();
+	vector_module_finalize();
+	foundation_finalize();
+}
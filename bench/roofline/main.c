@@ -0,0 +1,427 @@
+/* main.c  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <vector/vector.h>
+#include <bench/bench.h>
+
+#if FOUNDATION_PLATFORM_LINUX
+#  include <foundation/posix.h>
+#endif
+
+/* Bandwidth sweep of batch kernels over working sets from L1 resident to four times the last
+   level cache. Each kernel is reported in GB/s and GFLOP/s per working set size, together with
+   the fraction of the bandwidth ceiling, the best of the read, write and copy kernels at the
+   same size. A kernel close to the ceiling is memory bound and benefits from smaller storage
+   formats, streaming stores or prefetching, a kernel well below it is compute bound.
+
+   Additional command line options
+     --llc <KiB>    Last level cache size, detected on Linux and 8 MiB otherwise */
+
+typedef void (*roofline_kernel_fn)(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src,
+                                   size_t count, const matrix_t* FOUNDATION_RESTRICT constants);
+
+typedef struct roofline_kernel_t roofline_kernel_t;
+
+struct roofline_kernel_t {
+	const char* name;
+	size_t length;
+	roofline_kernel_fn kernel;
+	//Bytes read and written per element
+	size_t read;
+	size_t write;
+	//Floating point operations per element, zero for conversions where a count is not meaningful
+	size_t flops;
+	//Bandwidth ceiling kernel, always run
+	bool ceiling;
+};
+
+//Smallest working set in bytes
+#define ROOFLINE_MIN_SIZE (16 * 1024)
+
+static void
+roofline_read(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+              const matrix_t* FOUNDATION_RESTRICT constants) {
+	const vector_t* in = src;
+	vector_t sum0 = vector_zero(), sum1 = vector_zero(), sum2 = vector_zero(), sum3 = vector_zero();
+	size_t i;
+	FOUNDATION_UNUSED(constants);
+	//Independent accumulators so the loop is not bound by add latency
+	for (i = 0; i + 4 <= count; i += 4) {
+		sum0 = vector_add(sum0, in[i]);
+		sum1 = vector_add(sum1, in[i + 1]);
+		sum2 = vector_add(sum2, in[i + 2]);
+		sum3 = vector_add(sum3, in[i + 3]);
+	}
+	for (; i < count; ++i)
+		sum0 = vector_add(sum0, in[i]);
+	*(vector_t*)dst = vector_add(vector_add(sum0, sum1), vector_add(sum2, sum3));
+}
+
+static void
+roofline_write(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+               const matrix_t* FOUNDATION_RESTRICT constants) {
+	vector_t* out = dst;
+	const vector_t value = constants->row[0];
+	size_t i;
+	FOUNDATION_UNUSED(src);
+	for (i = 0; i < count; ++i)
+		out[i] = value;
+}
+
+static void
+roofline_copy(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+              const matrix_t* FOUNDATION_RESTRICT constants) {
+	vector_t* out = dst;
+	const vector_t* in = src;
+	size_t i;
+	FOUNDATION_UNUSED(constants);
+	for (i = 0; i < count; ++i)
+		out[i] = in[i];
+}
+
+static void
+roofline_transform(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                   const matrix_t* FOUNDATION_RESTRICT constants) {
+	vector_t* out = dst;
+	const vector_t* in = src;
+	const matrix_t m = *constants;
+	size_t i;
+	for (i = 0; i < count; ++i)
+		out[i] = matrix_transform(m, in[i]);
+}
+
+static void
+roofline_normalize(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                   const matrix_t* FOUNDATION_RESTRICT constants) {
+	vector_t* out = dst;
+	const vector_t* in = src;
+	size_t i;
+	FOUNDATION_UNUSED(constants);
+	for (i = 0; i < count; ++i)
+		out[i] = vector_normalize3(in[i]);
+}
+
+static void
+roofline_dot_sum(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                 const matrix_t* FOUNDATION_RESTRICT constants) {
+	const vector_t* in = src;
+	const vector_t axis = constants->row[0];
+	vector_t sum0 = vector_zero(), sum1 = vector_zero();
+	size_t i;
+	for (i = 0; i + 2 <= count; i += 2) {
+		sum0 = vector_add(sum0, vector_dot(in[i], axis));
+		sum1 = vector_add(sum1, vector_dot(in[i + 1], axis));
+	}
+	for (; i < count; ++i)
+		sum0 = vector_add(sum0, vector_dot(in[i], axis));
+	*(vector_t*)dst = vector_add(sum0, sum1);
+}
+
+static void
+roofline_encode16(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                  const matrix_t* FOUNDATION_RESTRICT constants) {
+	FOUNDATION_UNUSED(constants);
+	vector_octahedral_encode16(dst, src, count);
+}
+
+static void
+roofline_encode24(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                  const matrix_t* FOUNDATION_RESTRICT constants) {
+	FOUNDATION_UNUSED(constants);
+	vector_octahedral_encode24(dst, src, count);
+}
+
+static void
+roofline_encode32(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                  const matrix_t* FOUNDATION_RESTRICT constants) {
+	FOUNDATION_UNUSED(constants);
+	vector_octahedral_encode32(dst, src, count);
+}
+
+static void
+roofline_decode32(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                  const matrix_t* FOUNDATION_RESTRICT constants) {
+	FOUNDATION_UNUSED(constants);
+	vector_octahedral_decode32(dst, src, count);
+}
+
+static void
+roofline_decode24(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                  const matrix_t* FOUNDATION_RESTRICT constants) {
+	FOUNDATION_UNUSED(constants);
+	vector_octahedral_decode24(dst, src, count);
+}
+
+static void
+roofline_decode16(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                  const matrix_t* FOUNDATION_RESTRICT constants) {
+	FOUNDATION_UNUSED(constants);
+	vector_octahedral_decode16(dst, src, count);
+}
+
+//Compares source against destination, both are read and nothing is written
+static void
+roofline_count_differing(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                         const matrix_t* FOUNDATION_RESTRICT constants) {
+	*(size_t*)dst = vector_array_count_differing(src, dst, count, 1, vector_x(constants->row[3]));
+}
+
+static void
+roofline_find_differing(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                        const matrix_t* FOUNDATION_RESTRICT constants) {
+	size_t indices[16];
+	*(size_t*)dst = vector_array_find_differing(indices, 16, src, dst, count, 1, vector_x(constants->row[3]));
+}
+
+#if VECTOR_IMPLEMENTATION_SSE4 || VECTOR_IMPLEMENTATION_SSE3 || VECTOR_IMPLEMENTATION_SSE2
+
+//Non-temporal stores bypass the cache, which pays off once the destination does not fit in it
+static void
+roofline_copy_stream(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                     const matrix_t* FOUNDATION_RESTRICT constants) {
+	vector_t* out = dst;
+	const vector_t* in = src;
+	size_t i;
+	FOUNDATION_UNUSED(constants);
+	for (i = 0; i < count; ++i)
+		_mm_stream_ps((float*)(out + i), in[i]);
+	_mm_sfence();
+}
+
+static void
+roofline_transform_stream(void* FOUNDATION_RESTRICT dst, const void* FOUNDATION_RESTRICT src, size_t count,
+                          const matrix_t* FOUNDATION_RESTRICT constants) {
+	vector_t* out = dst;
+	const vector_t* in = src;
+	const matrix_t m = *constants;
+	size_t i;
+	for (i = 0; i < count; ++i)
+		_mm_stream_ps((float*)(out + i), matrix_transform(m, in[i]));
+	_mm_sfence();
+}
+
+#endif
+
+static const roofline_kernel_t _roofline_kernels[] = {
+	//Bandwidth ceilings
+	{ STRING_CONST("read"), roofline_read, 16, 0, 4, true },
+	{ STRING_CONST("write"), roofline_write, 0, 16, 0, true },
+	{ STRING_CONST("copy"), roofline_copy, 16, 16, 0, true },
+#if VECTOR_IMPLEMENTATION_SSE4 || VECTOR_IMPLEMENTATION_SSE3 || VECTOR_IMPLEMENTATION_SSE2
+	{ STRING_CONST("copy_stream"), roofline_copy_stream, 16, 16, 0, true },
+#endif
+	//Transforms
+	{ STRING_CONST("matrix_transform"), roofline_transform, 16, 16, 28, false },
+#if VECTOR_IMPLEMENTATION_SSE4 || VECTOR_IMPLEMENTATION_SSE3 || VECTOR_IMPLEMENTATION_SSE2
+	{ STRING_CONST("matrix_transform_stream"), roofline_transform_stream, 16, 16, 28, false },
+#endif
+	{ STRING_CONST("vector_normalize3"), roofline_normalize, 16, 16, 12, false },
+	//Reductions
+	{ STRING_CONST("vector_dot_sum"), roofline_dot_sum, 16, 0, 11, false },
+	{ STRING_CONST("vector_array_count_differing"), roofline_count_differing, 32, 0, 0, false },
+	{ STRING_CONST("vector_array_find_differing"), roofline_find_differing, 32, 0, 0, false },
+	//Conversions
+	{ STRING_CONST("vector_octahedral_encode16"), roofline_encode16, 16, 2, 0, false },
+	{ STRING_CONST("vector_octahedral_encode24"), roofline_encode24, 16, 3, 0, false },
+	{ STRING_CONST("vector_octahedral_encode32"), roofline_encode32, 16, 4, 0, false },
+	{ STRING_CONST("vector_octahedral_decode16"), roofline_decode16, 2, 16, 0, false },
+	{ STRING_CONST("vector_octahedral_decode24"), roofline_decode24, 3, 16, 0, false },
+	{ STRING_CONST("vector_octahedral_decode32"), roofline_decode32, 4, 16, 0, false }
+};
+
+static size_t
+roofline_llc_size(void) {
+	const string_const_t* cmdline = environment_command_line();
+	size_t iarg, asize;
+	for (iarg = 1, asize = array_size(cmdline); iarg < asize - 1; ++iarg) {
+		if (string_equal(STRING_ARGS(cmdline[iarg]), STRING_CONST("--llc")))
+			return (size_t)string_to_uint(STRING_ARGS(cmdline[iarg + 1]), false) * 1024;
+	}
+#if FOUNDATION_PLATFORM_LINUX && defined(_SC_LEVEL3_CACHE_SIZE)
+	{
+		const long size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if (size > 0)
+			return (size_t)size;
+	}
+#endif
+	return 8 * 1024 * 1024;
+}
+
+//Returns the best time per element in seconds and stores the sample noise
+static double
+roofline_measure(const roofline_kernel_t* kernel, void* dst, const void* src, size_t count,
+                 const matrix_t* constants, double* noise) {
+	const unsigned int samples = bench_sample_count();
+	tick_t elapsed, best = 0;
+	tick_t ticks[BENCH_SAMPLES_MAX];
+	size_t passes = 1, ipass;
+	unsigned int isample;
+
+	//Calibrate number of passes over the array per sample, also serves as warmup
+	do {
+		elapsed = time_current();
+		for (ipass = 0; ipass < passes; ++ipass)
+			kernel->kernel(dst, src, count, constants);
+		elapsed = time_elapsed_ticks(elapsed);
+		if (elapsed < bench_sample_time())
+			passes *= 2;
+	} while ((elapsed < bench_sample_time()) && (passes < ((size_t)1 << 24)));
+
+	for (isample = 0; isample < samples; ++isample) {
+		elapsed = time_current();
+		for (ipass = 0; ipass < passes; ++ipass)
+			kernel->kernel(dst, src, count, constants);
+		elapsed = time_elapsed_ticks(elapsed);
+		ticks[isample] = elapsed;
+		if (!isample || (elapsed < best))
+			best = elapsed;
+	}
+
+	*noise = bench_sample_noise(ticks, samples);
+	return time_ticks_to_seconds(best) / (double)(passes * count);
+}
+
+int
+main_initialize(void) {
+	int ret = 0;
+	application_t application;
+	foundation_config_t config;
+	vector_config_t vector_config;
+
+	memset(&application, 0, sizeof(application));
+	application.name = string_const(STRING_CONST("Roofline benchmarks"));
+	application.short_name = string_const(STRING_CONST("bench_roofline"));
+	application.company = string_const(STRING_CONST("Rampant Pixels"));
+	application.version = vector_module_version();
+	application.flags = APPLICATION_UTILITY;
+
+	log_enable_prefix(false);
+
+	memset(&config, 0, sizeof(config));
+	if ((ret = foundation_initialize(memory_system_malloc(), application, config)) < 0)
+		return ret;
+
+	memset(&vector_config, 0, sizeof(vector_config));
+	if ((ret = vector_module_initialize(vector_config)) < 0)
+		return ret;
+
+	return bench_initialize();
+}
+
+int
+main_run(void* main_arg) {
+	const size_t kernel_count = sizeof(_roofline_kernels) / sizeof(_roofline_kernels[0]);
+	const size_t llc_size = roofline_llc_size();
+	const size_t max_size = llc_size * 4;
+	double ceiling[64];
+	matrix_t constants;
+	vector_t* src;
+	vector_t* dst;
+	size_t ikernel, isize, size, i;
+	FOUNDATION_UNUSED(main_arg);
+
+	//Source and destination each hold the largest working set
+	src = memory_allocate(HASH_TOOL, max_size, 64, MEMORY_PERSISTENT);
+	dst = memory_allocate(HASH_TOOL, max_size, 64, MEMORY_PERSISTENT);
+	for (i = 0; i < max_size / sizeof(vector_t); ++i) {
+		src[i] = vector_normalize3(vector((real)(i % 7) - REAL_C(3.0), (real)(i % 5) - REAL_C(1.5),
+		                                  (real)(i % 3) + REAL_C(0.5), 0));
+		dst[i] = vector_zero();
+	}
+	constants = matrix_identity();
+	constants.row[0] = vector(REAL_C(0.995004), REAL_C(0.0998334), 0, 0);
+	constants.row[1] = vector(REAL_C(-0.0998334), REAL_C(0.995004), 0, 0);
+	constants.row[3] = vector(REAL_C(0.125), REAL_C(-0.25), REAL_C(0.5), 1);
+
+	log_infof(HASH_TOOL, STRING_CONST("Last level cache %" PRIsize " KiB, sweeping %" PRIsize " KiB to %" PRIsize " KiB"),
+	          llc_size / 1024, (size_t)ROOFLINE_MIN_SIZE / 1024, max_size / 1024);
+
+	for (ikernel = 0; ikernel < kernel_count; ++ikernel) {
+		const roofline_kernel_t* kernel = &_roofline_kernels[ikernel];
+		const size_t element_size = kernel->read + kernel->write;
+		if (!kernel->ceiling && !bench_enabled(kernel->name, kernel->length))
+			continue;
+
+		if (kernel->flops)
+			log_infof(HASH_TOOL, STRING_CONST("\n%.*s (%.3f flop/byte)"), (int)kernel->length, kernel->name,
+			          (double)kernel->flops / (double)element_size);
+		else
+			log_infof(HASH_TOOL, STRING_CONST("\n%.*s"), (int)kernel->length, kernel->name);
+		if (bench_has_counters())
+			log_infof(HASH_TOOL, STRING_CONST("%12s %12s %10s %10s %10s %10s"), "size KiB", "ns/element", "GB/s",
+			          "GFLOP/s", "% of peak", "llc miss");
+		else
+			log_infof(HASH_TOOL, STRING_CONST("%12s %12s %10s %10s %10s"), "size KiB", "ns/element", "GB/s",
+			          "GFLOP/s", "% of peak");
+
+		for (size = ROOFLINE_MIN_SIZE, isize = 0; (size <= max_size) && (isize < 64); size *= 2, ++isize) {
+			const size_t count = size / element_size;
+			double noise;
+			const double seconds = roofline_measure(kernel, dst, src, count, &constants, &noise);
+			const double bandwidth = (double)element_size / seconds / 1000000000.0;
+			double counters[BENCH_COUNTER_COUNT];
+			bench_record_t record;
+			char buffer[128];
+			string_t line;
+			//Ceiling kernels are first in the table and define the ceiling for each size
+			if (kernel->ceiling && (!ikernel || (bandwidth > ceiling[isize])))
+				ceiling[isize] = bandwidth;
+			line = string_format(buffer, sizeof(buffer), STRING_CONST("%12" PRIsize " %12.3f %10.2f"), size / 1024,
+			                     seconds * 1000000000.0, bandwidth);
+			if (kernel->flops)
+				line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %10.2f"),
+				                            (double)kernel->flops / seconds / 1000000000.0);
+			else
+				line = string_append(buffer, line.length, sizeof(buffer), STRING_CONST("          -"));
+			line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %9.1f%%"),
+			                            100.0 * bandwidth / ceiling[isize]);
+			if (bench_has_counters()) {
+				//Cache misses per element over a single pass
+				bench_counters_start();
+				kernel->kernel(dst, src, count, &constants);
+				bench_counters_stop(counters, count);
+				line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %10.3f"),
+				                            counters[BENCH_COUNTER_LLC_MISSES]);
+			}
+			log_info(HASH_TOOL, STRING_ARGS(line));
+
+			memset(&record, 0, sizeof(record));
+			record.group = string_const(STRING_CONST("roofline"));
+			record.function = string_const(kernel->name, kernel->length);
+			record.backend = bench_backend();
+			record.mode = string_const(STRING_CONST("element"));
+			record.size = size;
+			record.ns = seconds * 1000000000.0;
+			record.cycles = -1.0;
+			record.noise = noise;
+			record.counters = bench_has_counters() ? counters : 0;
+			bench_output(&record);
+		}
+	}
+
+	memory_deallocate(src);
+	memory_deallocate(dst);
+
+	return 0;
+}
+
+void
+main_finalize(void) {
+	bench_finalize();
+	vector_module_finalize();
+	foundation_finalize();
+}
@@ -0,0 +1,364 @@
+/* main.c  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <vector/vector.h>
+#include <bench/bench.h>
+
+/* Scenario benchmarks mirroring typical frame workloads, built only on the library functions:
+
+   - skeleton, pose evaluation of a bone hierarchy with keyframe slerp, local to world
+     concatenation and skinning palette
+   - particles, integration of a particle system with gravity, damping and floor bounce
+   - culling, bounding sphere against frustum plane test of a set of objects
+
+   Inputs are generated from a seeded random sequence so runs are reproducible. Each scenario
+   reports the best frame time of the samples and the time per element.
+
+   Additional command line options
+     --bones <n>        Number of bones in the skeleton (default 256)
+     --particles <n>    Number of particles (default 1000000)
+     --objects <n>      Number of objects to cull (default 100000)
+     --seed <n>         Random seed (default 1) */
+
+typedef void (*scene_frame_fn)(void* scene, unsigned int frame);
+
+typedef struct scene_skeleton_t scene_skeleton_t;
+typedef struct scene_particles_t scene_particles_t;
+typedef struct scene_culling_t scene_culling_t;
+
+struct scene_skeleton_t {
+	size_t count;
+	int* parent;
+	quaternion_t* rotation[2];
+	vector_t* translation[2];
+	matrix_t* inverse_bind;
+	matrix_t* world;
+	matrix_t* palette;
+};
+
+struct scene_particles_t {
+	size_t count;
+	vector_t* position;
+	vector_t* velocity;
+};
+
+struct scene_culling_t {
+	size_t count;
+	//Sphere center in xyz with w set to one, radius in separate array
+	vector_t* center;
+	real* radius;
+	uint32_t* visible;
+	size_t visible_count;
+	vector_t plane[6];
+};
+
+static uint32_t _scene_seed = 1;
+
+static uint32_t
+scene_random(void) {
+	_scene_seed = (_scene_seed * 1664525U) + 1013904223U;
+	return _scene_seed;
+}
+
+//Random value in [low, high)
+static real
+scene_random_range(real low, real high) {
+	return low + (high - low) * ((real)(scene_random() >> 8) / REAL_C(16777216.0));
+}
+
+static quaternion_t
+scene_random_rotation(void) {
+	const real x = scene_random_range(-1, 1);
+	const real y = scene_random_range(-1, 1);
+	const real z = scene_random_range(-1, 1);
+	const real w = scene_random_range(REAL_C(0.5), 1);
+	return quaternion_normalize(vector(x, y, z, w));
+}
+
+static size_t
+scene_option(const char* name, size_t length, size_t default_value) {
+	const string_const_t* cmdline = environment_command_line();
+	size_t iarg, asize;
+	for (iarg = 1, asize = array_size(cmdline); iarg < asize - 1; ++iarg) {
+		if (string_equal(STRING_ARGS(cmdline[iarg]), name, length))
+			return string_to_uint(STRING_ARGS(cmdline[iarg + 1]), false);
+	}
+	return default_value;
+}
+
+//Rotation, translation and uniform scale to matrix, rows are the transformed basis vectors
+static matrix_t
+scene_matrix(const quaternion_t rotation, const vector_t translation, real scale) {
+	matrix_t m;
+	m.row[0] = vector_scale(quaternion_rotate(rotation, vector(1, 0, 0, 0)), scale);
+	m.row[1] = vector_scale(quaternion_rotate(rotation, vector(0, 1, 0, 0)), scale);
+	m.row[2] = vector_scale(quaternion_rotate(rotation, vector(0, 0, 1, 0)), scale);
+	m.row[3] = translation;
+	return m;
+}
+
+static void
+scene_skeleton_frame(void* scene, unsigned int frame) {
+	scene_skeleton_t* skeleton = scene;
+	const real factor = (real)(frame % 64) / REAL_C(64.0);
+	size_t ibone;
+	for (ibone = 0; ibone < skeleton->count; ++ibone) {
+		const quaternion_t rotation = quaternion_slerp(skeleton->rotation[0][ibone], skeleton->rotation[1][ibone],
+		                                               factor);
+		const vector_t translation = vector_lerp(skeleton->translation[0][ibone], skeleton->translation[1][ibone],
+		                                         factor);
+		const matrix_t local = scene_matrix(rotation, translation, REAL_C(1.0));
+		const int parent = skeleton->parent[ibone];
+		//Parents precede children, so the parent world transform is already evaluated
+		skeleton->world[ibone] = (parent < 0) ? local : matrix_mul(local, skeleton->world[parent]);
+		skeleton->palette[ibone] = matrix_mul(skeleton->inverse_bind[ibone], skeleton->world[ibone]);
+	}
+}
+
+static void
+scene_particles_frame(void* scene, unsigned int frame) {
+	scene_particles_t* particles = scene;
+	const vector_t dt = vector_uniform(REAL_C(1.0) / REAL_C(60.0));
+	const vector_t gravity = vector(0, REAL_C(-9.81) / REAL_C(60.0), 0, 0);
+	const vector_t damping = vector_uniform(REAL_C(0.999));
+	const vector_t floor = vector_zero();
+	//Flip the sign of y velocity on floor contact
+	const vector_t bounce = vector(1, REAL_C(-0.8), 1, 1);
+	size_t iparticle;
+	FOUNDATION_UNUSED(frame);
+	for (iparticle = 0; iparticle < particles->count; ++iparticle) {
+		vector_t position = particles->position[iparticle];
+		vector_t velocity = particles->velocity[iparticle];
+		vector_t below;
+		velocity = vector_mul(vector_add(velocity, gravity), damping);
+		position = vector_muladd(velocity, dt, position);
+		below = vector_cmplt(vector_shuffle(position, VECTOR_MASK_YYYY), floor);
+		velocity = vector_select(below, vector_mul(velocity, bounce), velocity);
+		position = vector_select(below, vector_mul(position, bounce), position);
+		particles->position[iparticle] = position;
+		particles->velocity[iparticle] = velocity;
+	}
+}
+
+static void
+scene_culling_frame(void* scene, unsigned int frame) {
+	scene_culling_t* culling = scene;
+	size_t iobject, visible = 0;
+	FOUNDATION_UNUSED(frame);
+	for (iobject = 0; iobject < culling->count; ++iobject) {
+		const vector_t center = culling->center[iobject];
+		const vector_t radius = vector_uniform(-culling->radius[iobject]);
+		//Signed distances to the six planes in the x component of each dot product
+		vector_t outside = vector_cmplt(vector_dot(culling->plane[0], center), radius);
+		outside = vector_or(outside, vector_cmplt(vector_dot(culling->plane[1], center), radius));
+		outside = vector_or(outside, vector_cmplt(vector_dot(culling->plane[2], center), radius));
+		outside = vector_or(outside, vector_cmplt(vector_dot(culling->plane[3], center), radius));
+		outside = vector_or(outside, vector_cmplt(vector_dot(culling->plane[4], center), radius));
+		outside = vector_or(outside, vector_cmplt(vector_dot(culling->plane[5], center), radius));
+		culling->visible[visible] = (uint32_t)iobject;
+		visible += vector_any(outside) ? 0 : 1;
+	}
+	culling->visible_count = visible;
+}
+
+static void
+scene_skeleton_initialize(scene_skeleton_t* skeleton, size_t count) {
+	size_t ibone;
+	skeleton->count = count;
+	skeleton->parent = memory_allocate(HASH_TOOL, sizeof(int) * count, 0, MEMORY_PERSISTENT);
+	skeleton->rotation[0] = memory_allocate(HASH_TOOL, sizeof(quaternion_t) * count, 16, MEMORY_PERSISTENT);
+	skeleton->rotation[1] = memory_allocate(HASH_TOOL, sizeof(quaternion_t) * count, 16, MEMORY_PERSISTENT);
+	skeleton->translation[0] = memory_allocate(HASH_TOOL, sizeof(vector_t) * count, 16, MEMORY_PERSISTENT);
+	skeleton->translation[1] = memory_allocate(HASH_TOOL, sizeof(vector_t) * count, 16, MEMORY_PERSISTENT);
+	skeleton->inverse_bind = memory_allocate(HASH_TOOL, sizeof(matrix_t) * count, 16, MEMORY_PERSISTENT);
+	skeleton->world = memory_allocate(HASH_TOOL, sizeof(matrix_t) * count, 16, MEMORY_PERSISTENT);
+	skeleton->palette = memory_allocate(HASH_TOOL, sizeof(matrix_t) * count, 16, MEMORY_PERSISTENT);
+	for (ibone = 0; ibone < count; ++ibone) {
+		//Branching hierarchy, each bone attached to one of the recent bones
+		skeleton->parent[ibone] = ibone ? (int)(ibone - 1 - (scene_random() % (ibone < 4 ? ibone : 4))) : -1;
+		skeleton->rotation[0][ibone] = scene_random_rotation();
+		skeleton->rotation[1][ibone] = scene_random_rotation();
+		skeleton->translation[0][ibone] = vector(scene_random_range(-1, 1), scene_random_range(0, 1),
+		                                         scene_random_range(-1, 1), 1);
+		skeleton->translation[1][ibone] = vector(scene_random_range(-1, 1), scene_random_range(0, 1),
+		                                         scene_random_range(-1, 1), 1);
+		skeleton->inverse_bind[ibone] = scene_matrix(quaternion_conjugate(scene_random_rotation()),
+		                                             vector(scene_random_range(-1, 1), scene_random_range(-1, 1),
+		                                                    scene_random_range(-1, 1), 1), REAL_C(1.0));
+	}
+}
+
+static void
+scene_skeleton_finalize(scene_skeleton_t* skeleton) {
+	memory_deallocate(skeleton->parent);
+	memory_deallocate(skeleton->rotation[0]);
+	memory_deallocate(skeleton->rotation[1]);
+	memory_deallocate(skeleton->translation[0]);
+	memory_deallocate(skeleton->translation[1]);
+	memory_deallocate(skeleton->inverse_bind);
+	memory_deallocate(skeleton->world);
+	memory_deallocate(skeleton->palette);
+}
+
+static void
+scene_particles_initialize(scene_particles_t* particles, size_t count) {
+	size_t iparticle;
+	particles->count = count;
+	particles->position = memory_allocate(HASH_TOOL, sizeof(vector_t) * count, 16, MEMORY_PERSISTENT);
+	particles->velocity = memory_allocate(HASH_TOOL, sizeof(vector_t) * count, 16, MEMORY_PERSISTENT);
+	for (iparticle = 0; iparticle < count; ++iparticle) {
+		particles->position[iparticle] = vector(scene_random_range(-10, 10), scene_random_range(0, 20),
+		                                        scene_random_range(-10, 10), 1);
+		particles->velocity[iparticle] = vector(scene_random_range(-1, 1), scene_random_range(-1, 5),
+		                                        scene_random_range(-1, 1), 0);
+	}
+}
+
+static void
+scene_particles_finalize(scene_particles_t* particles) {
+	memory_deallocate(particles->position);
+	memory_deallocate(particles->velocity);
+}
+
+static void
+scene_culling_initialize(scene_culling_t* culling, size_t count) {
+	//Symmetric frustum looking down positive z with 90 degree field of view, near 1 and far 100
+	const real diagonal = REAL_C(0.70710678);
+	size_t iobject;
+	culling->count = count;
+	culling->visible_count = 0;
+	culling->center = memory_allocate(HASH_TOOL, sizeof(vector_t) * count, 16, MEMORY_PERSISTENT);
+	culling->radius = memory_allocate(HASH_TOOL, sizeof(real) * count, 0, MEMORY_PERSISTENT);
+	culling->visible = memory_allocate(HASH_TOOL, sizeof(uint32_t) * count, 0, MEMORY_PERSISTENT);
+	culling->plane[0] = vector(diagonal, 0, diagonal, 0);
+	culling->plane[1] = vector(-diagonal, 0, diagonal, 0);
+	culling->plane[2] = vector(0, diagonal, diagonal, 0);
+	culling->plane[3] = vector(0, -diagonal, diagonal, 0);
+	culling->plane[4] = vector(0, 0, 1, -1);
+	culling->plane[5] = vector(0, 0, -1, 100);
+	for (iobject = 0; iobject < count; ++iobject) {
+		culling->center[iobject] = vector(scene_random_range(-100, 100), scene_random_range(-100, 100),
+		                                  scene_random_range(-100, 100), 1);
+		culling->radius[iobject] = scene_random_range(REAL_C(0.1), 5);
+	}
+}
+
+static void
+scene_culling_finalize(scene_culling_t* culling) {
+	memory_deallocate(culling->center);
+	memory_deallocate(culling->radius);
+	memory_deallocate(culling->visible);
+}
+
+static void
+scene_run(const char* name, size_t length, scene_frame_fn frame, void* scene, size_t count) {
+	const unsigned int samples = bench_sample_count();
+	unsigned int iframe = 0, isample;
+	tick_t elapsed, best = 0;
+	tick_t ticks[BENCH_SAMPLES_MAX];
+	bench_record_t record;
+	double seconds;
+
+	if (!bench_enabled(name, length))
+		return;
+
+	//Warmup frame, then best frame time over the samples
+	frame(scene, iframe++);
+	for (isample = 0; isample < samples; ++isample) {
+		elapsed = time_current();
+		frame(scene, iframe++);
+		elapsed = time_elapsed_ticks(elapsed);
+		ticks[isample] = elapsed;
+		if (!isample || (elapsed < best))
+			best = elapsed;
+	}
+
+	seconds = time_ticks_to_seconds(best);
+	log_infof(HASH_TOOL, STRING_CONST("%-32.*s %10" PRIsize " %14.3f %12.3f"), (int)length, name, count,
+	          seconds * 1000000.0, seconds * 1000000000.0 / (double)count);
+
+	memset(&record, 0, sizeof(record));
+	record.group = string_const(STRING_CONST("scene"));
+	record.function = string_const(name, length);
+	record.backend = bench_backend();
+	record.mode = string_const(STRING_CONST("frame"));
+	record.size = count;
+	record.ns = seconds * 1000000000.0;
+	record.cycles = -1.0;
+	record.noise = bench_sample_noise(ticks, samples);
+	bench_output(&record);
+}
+
+int
+main_initialize(void) {
+	int ret = 0;
+	application_t application;
+	foundation_config_t config;
+	vector_config_t vector_config;
+
+	memset(&application, 0, sizeof(application));
+	application.name = string_const(STRING_CONST("Scene benchmarks"));
+	application.short_name = string_const(STRING_CONST("bench_scene"));
+	application.company = string_const(STRING_CONST("Rampant Pixels"));
+	application.version = vector_module_version();
+	application.flags = APPLICATION_UTILITY;
+
+	log_enable_prefix(false);
+
+	memset(&config, 0, sizeof(config));
+	if ((ret = foundation_initialize(memory_system_malloc(), application, config)) < 0)
+		return ret;
+
+	memset(&vector_config, 0, sizeof(vector_config));
+	if ((ret = vector_module_initialize(vector_config)) < 0)
+		return ret;
+
+	return bench_initialize();
+}
+
+int
+main_run(void* main_arg) {
+	scene_skeleton_t skeleton;
+	scene_particles_t particles;
+	scene_culling_t culling;
+	FOUNDATION_UNUSED(main_arg);
+
+	_scene_seed = (uint32_t)scene_option(STRING_CONST("--seed"), 1);
+	scene_skeleton_initialize(&skeleton, scene_option(STRING_CONST("--bones"), 256));
+	scene_particles_initialize(&particles, scene_option(STRING_CONST("--particles"), 1000000));
+	scene_culling_initialize(&culling, scene_option(STRING_CONST("--objects"), 100000));
+
+	log_infof(HASH_TOOL, STRING_CONST("%-32s %10s %14s %12s"), "scene", "elements", "frame us", "element ns");
+	scene_run(STRING_CONST("skeleton"), scene_skeleton_frame, &skeleton, skeleton.count);
+	scene_run(STRING_CONST("particles"), scene_particles_frame, &particles, particles.count);
+	scene_run(STRING_CONST("culling"), scene_culling_frame, &culling, culling.count);
+	log_infof(HASH_TOOL, STRING_CONST("%" PRIsize " of %" PRIsize " objects visible"), culling.visible_count,
+	          culling.count);
+
+	scene_skeleton_finalize(&skeleton);
+	scene_particles_finalize(&particles);
+	scene_culling_finalize(&culling);
+
+	return 0;
+}
+
+void
+main_finalize(void) {
+	bench_finalize();
+	vector_module_finalize();
+	foundation_finalize();
+}
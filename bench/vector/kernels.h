@@ -0,0 +1,148 @@
+/* kernels.h  -  Vector benchmarks  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/* Kernels shared by bench-vector and bench-backend. Include after vector.h and bench.h */
+
+/* Functions returning scalars, booleans or lane masks are chained back through vector_uniform,
+   which adds a broadcast to their timing. Load and constant functions are not timed */
+
+BENCH_KERNELS(vector_t, vector_t, vector_normalize, vector_normalize(v))
+BENCH_KERNELS(vector_t, vector_t, vector_normalize3, vector_normalize3(v))
+BENCH_KERNELS(vector_t, vector_t, vector_dot, vector_dot(v, c2))
+BENCH_KERNELS(vector_t, vector_t, vector_dot3, vector_dot3(v, c2))
+BENCH_KERNELS(vector_t, vector_t, vector_cross3, vector_cross3(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_mul, vector_mul(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_div, vector_div(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_add, vector_add(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_sub, vector_sub(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_neg, vector_neg(v))
+BENCH_KERNELS(vector_t, vector_t, vector_muladd, vector_muladd(v, c2, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_shuffle, vector_shuffle(v, VECTOR_MASK_YZXW))
+BENCH_KERNELS(vector_t, vector_t, vector_scale, vector_scale(v, REAL_C(0.999)))
+BENCH_KERNELS(vector_t, vector_t, vector_lerp, vector_lerp(v, c1, REAL_C(0.25)))
+BENCH_KERNELS(vector_t, vector_t, vector_project, vector_project(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_reflect, vector_reflect(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_project3, vector_project3(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_reflect3, vector_reflect3(v, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_length, vector_length(v))
+BENCH_KERNELS(vector_t, vector_t, vector_length_fast, vector_length_fast(v))
+BENCH_KERNELS(vector_t, vector_t, vector_length_sqr, vector_length_sqr(v))
+BENCH_KERNELS(vector_t, vector_t, vector_length3, vector_length3(v))
+BENCH_KERNELS(vector_t, vector_t, vector_length3_fast, vector_length3_fast(v))
+BENCH_KERNELS(vector_t, vector_t, vector_length3_sqr, vector_length3_sqr(v))
+BENCH_KERNELS(vector_t, vector_t, vector_min, vector_min(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_max, vector_max(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_abs, vector_abs(v))
+BENCH_KERNELS(vector_t, vector_t, vector_x, vector_uniform(vector_x(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_y, vector_uniform(vector_y(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_z, vector_uniform(vector_z(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_w, vector_uniform(vector_w(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_component, vector_uniform(vector_component(v, 2)))
+BENCH_KERNELS(vector_t, vector_t, vector_equal, vector_uniform((real)vector_equal(v, c0)))
+BENCH_KERNELS(vector_t, vector_t, vector_equal_exact_lanes, vector_uniform((real)vector_equal_exact_lanes(v, c0)))
+BENCH_KERNELS(vector_t, vector_t, vector_equal_abs_lanes,
+              vector_uniform((real)vector_equal_abs_lanes(v, c0, REAL_C(0.001))))
+BENCH_KERNELS(vector_t, vector_t, vector_equal_rel_lanes,
+              vector_uniform((real)vector_equal_rel_lanes(v, c0, REAL_C(0.001))))
+BENCH_KERNELS(vector_t, vector_t, vector_equal_ulps_lanes, vector_uniform((real)vector_equal_ulps_lanes(v, c0, 4)))
+BENCH_KERNELS(vector_t, vector_t, vector_cmplt, vector_cmplt(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_cmple, vector_cmple(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_cmpgt, vector_cmpgt(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_cmpge, vector_cmpge(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_cmpeq, vector_cmpeq(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_cmpneq, vector_cmpneq(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_and, vector_and(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_andnot, vector_andnot(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_or, vector_or(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_xor, vector_xor(v, c0))
+BENCH_KERNELS(vector_t, vector_t, vector_select, vector_select(v, c0, c1))
+BENCH_KERNELS(vector_t, vector_t, vector_blend, vector_blend(v, c0, VECTOR_BLEND_0101))
+BENCH_KERNELS(vector_t, vector_t, vector_movemask, vector_uniform((real)vector_movemask(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_any, vector_uniform((real)vector_any(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_all, vector_uniform((real)vector_all(v)))
+BENCH_KERNELS(vector_t, vector_t, vector_octahedral_encode, vector_octahedral_encode(v))
+BENCH_KERNELS(vector_t, vector_t, vector_octahedral_decode, vector_octahedral_decode(v))
+
+static const bench_entry_t bench_vector_kernels[] = {
+	BENCH_ENTRY(vector_normalize),
+	BENCH_ENTRY(vector_normalize3),
+	BENCH_ENTRY(vector_dot),
+	BENCH_ENTRY(vector_dot3),
+	BENCH_ENTRY(vector_cross3),
+	BENCH_ENTRY(vector_mul),
+	BENCH_ENTRY(vector_div),
+	BENCH_ENTRY(vector_add),
+	BENCH_ENTRY(vector_sub),
+	BENCH_ENTRY(vector_neg),
+	BENCH_ENTRY(vector_muladd),
+	BENCH_ENTRY(vector_shuffle),
+	BENCH_ENTRY(vector_scale),
+	BENCH_ENTRY(vector_lerp),
+	BENCH_ENTRY(vector_project),
+	BENCH_ENTRY(vector_reflect),
+	BENCH_ENTRY(vector_project3),
+	BENCH_ENTRY(vector_reflect3),
+	BENCH_ENTRY(vector_length),
+	BENCH_ENTRY(vector_length_fast),
+	BENCH_ENTRY(vector_length_sqr),
+	BENCH_ENTRY(vector_length3),
+	BENCH_ENTRY(vector_length3_fast),
+	BENCH_ENTRY(vector_length3_sqr),
+	BENCH_ENTRY(vector_min),
+	BENCH_ENTRY(vector_max),
+	BENCH_ENTRY(vector_abs),
+	BENCH_ENTRY(vector_x),
+	BENCH_ENTRY(vector_y),
+	BENCH_ENTRY(vector_z),
+	BENCH_ENTRY(vector_w),
+	BENCH_ENTRY(vector_component),
+	BENCH_ENTRY(vector_equal),
+	BENCH_ENTRY(vector_equal_exact_lanes),
+	BENCH_ENTRY(vector_equal_abs_lanes),
+	BENCH_ENTRY(vector_equal_rel_lanes),
+	BENCH_ENTRY(vector_equal_ulps_lanes),
+	BENCH_ENTRY(vector_cmplt),
+	BENCH_ENTRY(vector_cmple),
+	BENCH_ENTRY(vector_cmpgt),
+	BENCH_ENTRY(vector_cmpge),
+	BENCH_ENTRY(vector_cmpeq),
+	BENCH_ENTRY(vector_cmpneq),
+	BENCH_ENTRY(vector_and),
+	BENCH_ENTRY(vector_andnot),
+	BENCH_ENTRY(vector_or),
+	BENCH_ENTRY(vector_xor),
+	BENCH_ENTRY(vector_select),
+	BENCH_ENTRY(vector_blend),
+	BENCH_ENTRY(vector_movemask),
+	BENCH_ENTRY(vector_any),
+	BENCH_ENTRY(vector_all),
+	BENCH_ENTRY(vector_octahedral_encode),
+	BENCH_ENTRY(vector_octahedral_decode),
+};
+
+static void
+bench_vector_setup(vector_t* initial, vector_t* constants) {
+	int istream;
+	//Values of magnitude around one, which the chains keep or decay from
+	for (istream = 0; istream < BENCH_STREAMS; ++istream)
+		initial[istream] = vector(REAL_C(0.5) + (real)istream * REAL_C(0.125), REAL_C(-0.75), REAL_C(0.25),
+		                          REAL_C(1.0) - (real)istream * REAL_C(0.0625));
+	constants[0] = vector(REAL_C(1.0001), REAL_C(0.9999), REAL_C(1.0002), REAL_C(0.9998));
+	constants[1] = vector(REAL_C(0.25), REAL_C(-0.5), REAL_C(0.75), REAL_C(0.125));
+	constants[2] = vector(REAL_C(0.25), REAL_C(0.25), REAL_C(0.25), REAL_C(0.25));
+}
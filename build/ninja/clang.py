@@ -74,6 +74,12 @@ class ClangToolchain(toolchain.Toolchain):
     if self.use_coverage():
       self.cflags += ['--coverage']
       self.linkflags += ['--coverage']
+    if self.is_deterministic():
+      fastmath = ['-ffinite-math-only', '-funsafe-math-optimizations', '-fno-trapping-math', '-ffast-math']
+      self.cflags = [flag for flag in self.cflags if not flag in fastmath]
+      self.cflags += ['-ffp-contract=off', '-DBUILD_DETERMINISTIC=1']
+    if self.is_validate():
+      self.cflags += ['-DBUILD_VALIDATE=1']
 
     #Overrides
     self.objext = '.o'
@@ -40,6 +40,12 @@ class Generator(object):
     parser.add_argument('--coverage', action='store_true',
                         help = 'Build with code coverage',
                         default = False)
+    parser.add_argument('--deterministic', action='store_true',
+                        help = 'Build with strict floating point for bit identical results across backends',
+                        default = False)
+    parser.add_argument('--validate', action='store_true',
+                        help = 'Build with NaN, infinity, unit length and alignment checks in the vector functions',
+                        default = False)
     parser.add_argument('--subninja', action='store',
                         help = 'Build as subproject (exclude rules and pools) with the given subpath',
                         default = '')
@@ -90,6 +96,20 @@ class Generator(object):
         variables['coverage'] = True
       else:
         variables += [('coverage', True)]
+    if options.deterministic:
+      if variables is None:
+        variables = {}
+      if isinstance(variables, dict):
+        variables['deterministic'] = True
+      else:
+        variables += [('deterministic', True)]
+    if options.validate:
+      if variables is None:
+        variables = {}
+      if isinstance(variables, dict):
+        variables['validate'] = True
+      else:
+        variables += [('validate', True)]
 
     self.toolchain = toolchain.make_toolchain(self.host, self.target, options.toolchain)
     self.toolchain.initialize(project, archs, configs, includepaths, dependlibs, libpaths, variables, self.subninja)
@@ -48,6 +48,11 @@ class MSVCToolchain(toolchain.Toolchain):
 
     if self.is_monolithic():
       self.cflags += ['/D', '"BUILD_MONOLITHIC=1"']
+    if self.is_deterministic():
+      self.cflags = ['/fp:precise' if flag == '/fp:fast' else flag for flag in self.cflags]
+      self.cflags += ['/D', '"BUILD_DETERMINISTIC=1"']
+    if self.is_validate():
+      self.cflags += ['/D', '"BUILD_VALIDATE=1"']
 
     #Overrides
     self.objext = '.obj'
@@ -48,6 +48,8 @@ class Toolchain(object):
     #Set default values
     self.build_monolithic = False
     self.build_coverage = False
+    self.build_deterministic = False
+    self.build_validate = False
     self.support_lua = False
     self.python = 'python'
     self.objext = '.o'
@@ -206,6 +208,10 @@ class Toolchain(object):
         self.build_monolithic = get_boolean_flag(val)
       elif key == 'coverage':
         self.build_coverage = get_boolean_flag(val)
+      elif key == 'deterministic':
+        self.build_deterministic = get_boolean_flag(val)
+      elif key == 'validate':
+        self.build_validate = get_boolean_flag(val)
       elif key == 'support_lua':
         self.support_lua = get_boolean_flag(val)
     if self.xcode != None:
@@ -228,6 +234,10 @@ class Toolchain(object):
       self.build_monolithic = get_boolean_flag(prefs['monolithic'])
     if 'coverage' in prefs:
       self.build_coverage = get_boolean_flag( prefs['coverage'] )
+    if 'deterministic' in prefs:
+      self.build_deterministic = get_boolean_flag(prefs['deterministic'])
+    if 'validate' in prefs:
+      self.build_validate = get_boolean_flag(prefs['validate'])
     if 'support_lua' in prefs:
       self.support_lua = get_boolean_flag(prefs['support_lua'])
     if 'python' in prefs:
@@ -252,6 +262,12 @@ class Toolchain(object):
   def use_coverage(self):
     return self.build_coverage
 
+  def is_deterministic(self):
+    return self.build_deterministic
+
+  def is_validate(self):
+    return self.build_validate
+
   def write_variables(self, writer):
     writer.variable('buildpath', self.buildpath)
     writer.variable('target', self.target.platform)
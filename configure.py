@@ -16,23 +16,61 @@ target = generator.target
 writer = generator.writer
 toolchain = generator.toolchain
 
+#Outputs built by a plain 'ninja', opt-in targets like test-codegen are left out
+defaults = []
+def add_defaults(built):
+  if isinstance(built, dict):
+    for config in sorted(built.keys()):
+      defaults.extend(built[config])
+  elif built:
+    defaults.extend(built)
+
 vector_lib = generator.lib(module = 'vector', sources = [
-  'vector.c', 'version.c'])
+  'vector.c', 'octahedral.c', 'compare.c', 'aabb.c', 'plane.c', 'obb.c', 'frustum.c', 'ray.c', 'bvh.c', 'broadphase.c', 'hashgrid.c', 'morton.c', 'version.c'])
+add_defaults(vector_lib)
 
 if not target.is_ios() and not target.is_android() and not target.is_tizen():
   configs = [config for config in toolchain.configs if config not in ['profile', 'deploy']]
   if not configs == []:
-    generator.bin('maskgen', ['main.c'], 'maskgen', basepath = 'tools', implicit_deps = [vector_lib], libs = ['vector', 'foundation'], configs = configs)
+    add_defaults(generator.bin('maskgen', ['main.c'], 'maskgen', basepath = 'tools', implicit_deps = [vector_lib], libs = ['vector', 'foundation'], configs = configs))
 
 #No test cases if we're a submodule
 if generator.is_subninja():
   sys.exit()
 
+#Microbenchmarks, see bench/bench/bench.h for options
+if not target.is_ios() and not target.is_android() and not target.is_tizen() and not target.is_pnacl():
+  bench_lib = generator.lib(module = 'bench', sources = ['bench.c'], basepath = 'bench', includepaths = ['bench'])
+  #Backend comparison compiles the kernels once per backend into the same binary
+  bench_sources = {
+    'backend': ['main.c', 'kernel_fallback.c', 'kernel_sse2.c', 'kernel_sse3.c', 'kernel_sse4.c']
+  }
+  for bench in ['backend', 'matrix', 'quaternion', 'roofline', 'scene', 'vector']:
+    add_defaults(generator.bin(module = bench, sources = bench_sources.get(bench, ['main.c']), binname = 'bench-' + bench, basepath = 'bench', implicit_deps = [vector_lib, bench_lib], libs = ['bench', 'vector'] + dependlibs, includepaths = ['bench']))
+
+#Codegen regression check of the inline kernels against the checked in baseline, run with 'ninja test-codegen'.
+#Not a default target, the stamp file is only written when the check passes
+if toolchain.name() in ['gcc', 'clang'] and (target.is_linux() or target.is_macos() or target.is_bsd()):
+  codegen_stamp = os.path.join('$buildpath', 'codegen.stamp')
+  codegen_deps = [os.path.join('test', 'codegen', name) for name in ['codegen.c', 'codegen.py']]
+  codegen_deps += [os.path.join('test', 'codegen', 'baseline', name) for name in sorted(os.listdir(os.path.join('test', 'codegen', 'baseline')))]
+  codegen_deps += [os.path.join('vector', name) for name in sorted(os.listdir('vector')) if name.endswith('.h')]
+  writer.rule('codegen', command = 'python ' + os.path.join('test', 'codegen', 'codegen.py') + ' --cc $toolchain$cc && touch $out', description = 'CODEGEN')
+  writer.build(codegen_stamp, 'codegen', implicit = codegen_deps)
+  writer.build('test-codegen', 'phony', codegen_stamp)
+  writer.newline()
+
 includepaths = generator.test_includepaths()
 
 test_cases = [
-  'matrix', 'quaternion', 'vector'
+  'accuracy', 'deterministic', 'fuzz', 'geometry', 'matrix', 'quaternion', 'validate', 'vector'
 ]
+#Test cases built from more than main.c
+test_sources = {
+  'accuracy': ['main.c', 'accuracy_fallback.c', 'accuracy_sse2.c', 'accuracy_sse3.c', 'accuracy_sse4.c'],
+  'deterministic': ['main.c', 'hash_fallback.c', 'hash_sse2.c', 'hash_sse3.c', 'hash_sse4.c'],
+  'fuzz': ['main.c', 'fuzz.c', 'fuzz_fallback.c', 'fuzz_sse2.c', 'fuzz_sse3.c', 'fuzz_sse4.c']
+}
 if toolchain.is_monolithic() or target.is_ios() or target.is_android() or target.is_tizen() or target.is_pnacl():
   #Build one fat binary with all test cases
   test_resources = []
@@ -55,11 +93,13 @@ if toolchain.is_monolithic() or target.is_ios() or target.is_android() or target
       'tizen-manifest.xml', os.path.join('res', 'tizenapp.png')
     ]]
   if target.is_ios() or target.is_android() or target.is_tizen():
-    generator.app(module = '', sources = [os.path.join(module, 'main.c') for module in test_cases] + test_extrasources, binname = 'test-all', basepath = 'test', implicit_deps = [vector_lib], libs = ['test', 'vector'] + dependlibs, resources = test_resources, includepaths = includepaths)
+    add_defaults(generator.app(module = '', sources = [os.path.join(module, source) for module in test_cases for source in test_sources.get(module, ['main.c'])] + test_extrasources, binname = 'test-all', basepath = 'test', implicit_deps = [vector_lib], libs = ['test', 'vector'] + dependlibs, resources = test_resources, includepaths = includepaths))
   else:
-    generator.bin(module = '', sources = [os.path.join(module, 'main.c') for module in test_cases] + test_extrasources, binname = 'test-all', basepath = 'test', implicit_deps = [vector_lib], libs = ['test', 'vector'] + dependlibs, resources = test_resources, includepaths = includepaths)
+    add_defaults(generator.bin(module = '', sources = [os.path.join(module, source) for module in test_cases for source in test_sources.get(module, ['main.c'])] + test_extrasources, binname = 'test-all', basepath = 'test', implicit_deps = [vector_lib], libs = ['test', 'vector'] + dependlibs, resources = test_resources, includepaths = includepaths))
 else:
   #Build one binary per test case
-  generator.bin(module = 'all', sources = ['main.c'], binname = 'test-all', basepath = 'test', implicit_deps = [vector_lib], libs = ['vector'] + dependlibs, includepaths = includepaths)
+  add_defaults(generator.bin(module = 'all', sources = ['main.c'], binname = 'test-all', basepath = 'test', implicit_deps = [vector_lib], libs = ['vector'] + dependlibs, includepaths = includepaths))
   for test in test_cases:
-    generator.bin(module = test, sources = ['main.c'], binname = 'test-' + test, basepath = 'test', implicit_deps = [vector_lib], libs = ['test', 'vector'] + dependlibs, includepaths = includepaths)
+    add_defaults(generator.bin(module = test, sources = test_sources.get(test, ['main.c']), binname = 'test-' + test, basepath = 'test', implicit_deps = [vector_lib], libs = ['test', 'vector'] + dependlibs, includepaths = includepaths))
+
+writer.default(defaults)
@@ -0,0 +1,82 @@
+/* accuracy.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+typedef enum {
+	ACCURACY_VECTOR_ADD = 0,
+	ACCURACY_VECTOR_MUL,
+	ACCURACY_VECTOR_DIV,
+	ACCURACY_VECTOR_MULADD,
+	ACCURACY_VECTOR_LERP,
+	ACCURACY_VECTOR_DOT,
+	ACCURACY_VECTOR_DOT3,
+	ACCURACY_VECTOR_CROSS3,
+	ACCURACY_VECTOR_NORMALIZE,
+	ACCURACY_VECTOR_NORMALIZE3,
+	ACCURACY_VECTOR_LENGTH,
+	ACCURACY_VECTOR_LENGTH_FAST,
+	ACCURACY_VECTOR_LENGTH3,
+	ACCURACY_VECTOR_LENGTH3_FAST,
+	ACCURACY_VECTOR_PROJECT,
+	ACCURACY_VECTOR_REFLECT,
+	ACCURACY_VECTOR_OCTAHEDRAL,
+	ACCURACY_MATRIX_MUL,
+	ACCURACY_MATRIX_ROTATE,
+	ACCURACY_MATRIX_TRANSFORM,
+	ACCURACY_QUATERNION_INVERSE,
+	ACCURACY_QUATERNION_NORMALIZE,
+	ACCURACY_QUATERNION_MUL,
+	ACCURACY_QUATERNION_SLERP,
+	ACCURACY_QUATERNION_ROTATE,
+	ACCURACY_FUNCTION_COUNT
+} accuracy_function_t;
+
+//! Number of result components stored per function and input, enough for a matrix
+#define ACCURACY_RESULT_SIZE 16
+
+typedef struct accuracy_input_t accuracy_input_t;
+
+//! Function arguments, quaternions are unit length and the factor is in [0, 1]
+struct accuracy_input_t {
+	float32_t a[4];
+	float32_t b[4];
+	float32_t c[4];
+	float32_t q0[4];
+	float32_t q1[4];
+	float32_t m0[16];
+	float32_t m1[16];
+	float32_t factor;
+};
+
+/* Evaluate every function over the inputs with the given backend. The result of function f for
+   input i is stored at result[((f * count) + i) * ACCURACY_RESULT_SIZE]. Returns false if the
+   backend is not available in this build, in which case the results are left untouched. */
+
+bool
+accuracy_evaluate_fallback(const accuracy_input_t* input, size_t count, float32_t* result);
+
+bool
+accuracy_evaluate_sse2(const accuracy_input_t* input, size_t count, float32_t* result);
+
+bool
+accuracy_evaluate_sse3(const accuracy_input_t* input, size_t count, float32_t* result);
+
+bool
+accuracy_evaluate_sse4(const accuracy_input_t* input, size_t count, float32_t* result);
@@ -0,0 +1,24 @@
+/* accuracy_fallback.c  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+
+#define VECTOR_TEST_BACKEND VECTOR_TEST_BACKEND_FALLBACK
+#include "../test/backend.h"
+
+#include <vector/vector.h>
+
+#include "kernel.h"
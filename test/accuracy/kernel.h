@@ -0,0 +1,105 @@
+/* kernel.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/* Shared evaluation kernel, included once by each backend translation unit after selecting the
+   backend with test/backend.h and including vector.h */
+
+#include "accuracy.h"
+
+#if VECTOR_TEST_BACKEND_AVAILABLE
+
+static void
+accuracy_store(float32_t* dst, const vector_t v) {
+	dst[0] = vector_x(v);
+	dst[1] = vector_y(v);
+	dst[2] = vector_z(v);
+	dst[3] = vector_w(v);
+}
+
+static void
+accuracy_store_matrix(float32_t* dst, const matrix_t m) {
+	accuracy_store(dst, m.row[0]);
+	accuracy_store(dst + 4, m.row[1]);
+	accuracy_store(dst + 8, m.row[2]);
+	accuracy_store(dst + 12, m.row[3]);
+}
+
+//Evaluate expr of the arguments a, b, c, q0, q1, m0, m1 and factor for all inputs
+#define ACCURACY_EVALUATE(function, store, expr) \
+	for (i = 0; i < count; ++i) { \
+		const vector_t a = vector_unaligned(input[i].a); \
+		const vector_t b = vector_unaligned(input[i].b); \
+		const vector_t c = vector_unaligned(input[i].c); \
+		const quaternion_t q0 = quaternion_unaligned(input[i].q0); \
+		const quaternion_t q1 = quaternion_unaligned(input[i].q1); \
+		const matrix_t m0 = matrix_unaligned(input[i].m0); \
+		const matrix_t m1 = matrix_unaligned(input[i].m1); \
+		const real factor = input[i].factor; \
+		FOUNDATION_UNUSED(a); FOUNDATION_UNUSED(b); FOUNDATION_UNUSED(c); \
+		FOUNDATION_UNUSED(q0); FOUNDATION_UNUSED(q1); FOUNDATION_UNUSED(m0); FOUNDATION_UNUSED(m1); \
+		FOUNDATION_UNUSED(factor); \
+		store(result + (((function * count) + i) * ACCURACY_RESULT_SIZE), expr); \
+	}
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(accuracy_evaluate)(const accuracy_input_t* input, size_t count, float32_t* result) {
+	size_t i;
+
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_ADD, accuracy_store, vector_add(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_MUL, accuracy_store, vector_mul(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_DIV, accuracy_store, vector_div(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_MULADD, accuracy_store, vector_muladd(a, b, c));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_LERP, accuracy_store, vector_lerp(a, b, factor));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_DOT, accuracy_store, vector_dot(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_DOT3, accuracy_store, vector_dot3(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_CROSS3, accuracy_store, vector_cross3(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_NORMALIZE, accuracy_store, vector_normalize(a));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_NORMALIZE3, accuracy_store, vector_normalize3(a));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_LENGTH, accuracy_store, vector_length(a));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_LENGTH_FAST, accuracy_store, vector_length_fast(a));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_LENGTH3, accuracy_store, vector_length3(a));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_LENGTH3_FAST, accuracy_store, vector_length3_fast(a));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_PROJECT, accuracy_store, vector_project(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_REFLECT, accuracy_store, vector_reflect(a, b));
+	ACCURACY_EVALUATE(ACCURACY_VECTOR_OCTAHEDRAL, accuracy_store,
+	                  vector_octahedral_decode(vector_octahedral_encode(a)));
+
+	ACCURACY_EVALUATE(ACCURACY_MATRIX_MUL, accuracy_store_matrix, matrix_mul(m0, m1));
+	ACCURACY_EVALUATE(ACCURACY_MATRIX_ROTATE, accuracy_store, matrix_rotate(m0, a));
+	ACCURACY_EVALUATE(ACCURACY_MATRIX_TRANSFORM, accuracy_store, matrix_transform(m0, a));
+
+	ACCURACY_EVALUATE(ACCURACY_QUATERNION_INVERSE, accuracy_store, quaternion_inverse(a));
+	ACCURACY_EVALUATE(ACCURACY_QUATERNION_NORMALIZE, accuracy_store, quaternion_normalize(a));
+	ACCURACY_EVALUATE(ACCURACY_QUATERNION_MUL, accuracy_store, quaternion_mul(a, b));
+	ACCURACY_EVALUATE(ACCURACY_QUATERNION_SLERP, accuracy_store, quaternion_slerp(q0, q1, factor));
+	ACCURACY_EVALUATE(ACCURACY_QUATERNION_ROTATE, accuracy_store, quaternion_rotate(q0, a));
+
+	return true;
+}
+
+#undef ACCURACY_EVALUATE
+
+#else
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(accuracy_evaluate)(const accuracy_input_t* input, size_t count, float32_t* result) {
+	FOUNDATION_UNUSED(input);
+	FOUNDATION_UNUSED(count);
+	FOUNDATION_UNUSED(result);
+	return false;
+}
+
+#endif
@@ -0,0 +1,789 @@
+/* main.c  -  Accuracy tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+#include <vector/vector.h>
+
+#include "../test/backend.h"
+#include "accuracy.h"
+
+#include <float.h>
+
+/* Accuracy of every backend against a long double reference, reported as the maximum and mean
+   error in units in the last place (ULP) of the single precision reference result.
+
+   Functions summing products lose precision to cancellation for some inputs, which is a
+   property of the inputs in single precision and not of the implementation. The error of such
+   a component is measured in ULP of the sum of the absolute terms instead when that is larger
+   than the result, so cancellation does not inflate the numbers.
+
+   Inputs are random vectors spanning many magnitudes plus edge cases like axis vectors, signed
+   zeros, parallel and opposite arguments and nearly identical quaternions. Magnitudes stay in
+   the range where squared lengths do not overflow or underflow in single precision, which the
+   library does not guard against. Inputs where the function is undefined, for example
+   normalizing a zero vector, are skipped. */
+
+//Number of random inputs, edge cases are added on top
+#define ACCURACY_RANDOM_COUNT 4096
+
+typedef long double accuracy_real_t;
+
+/* Reference result of a function, returns false if the function is undefined for the input.
+   Stores the reference value and the cancellation magnitude of each component */
+typedef bool (*accuracy_reference_fn)(const accuracy_input_t* input, accuracy_real_t* value,
+                                      accuracy_real_t* scale);
+
+typedef struct accuracy_function_spec_t accuracy_function_spec_t;
+typedef struct accuracy_error_t accuracy_error_t;
+
+struct accuracy_function_spec_t {
+	const char* name;
+	//Number of leading result components compared, unspecified components are ignored
+	unsigned int components;
+	//Maximum allowed error in ULP
+	double max_ulp;
+	//Maximum allowed error in ULP for SIMD backends using the reciprocal square root estimate
+	double max_ulp_estimate;
+	accuracy_reference_fn reference;
+};
+
+struct accuracy_error_t {
+	double max_ulp;
+	double sum_ulp;
+	size_t count;
+	size_t nonfinite;
+	size_t worst;
+};
+
+static const char* const _backend_name[VECTOR_TEST_BACKEND_COUNT] = {
+	"fallback", "SSE2", "SSE3", "SSE4"
+};
+
+static accuracy_real_t
+accuracy_dot(const float32_t* v0, const float32_t* v1, unsigned int count) {
+	accuracy_real_t sum = 0;
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		sum += (accuracy_real_t)v0[i] * (accuracy_real_t)v1[i];
+	return sum;
+}
+
+static accuracy_real_t
+accuracy_dot_abs(const float32_t* v0, const float32_t* v1, unsigned int count) {
+	accuracy_real_t sum = 0;
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		sum += fabsl((accuracy_real_t)v0[i] * (accuracy_real_t)v1[i]);
+	return sum;
+}
+
+static void
+accuracy_uniform(accuracy_real_t* value, accuracy_real_t* scale, accuracy_real_t v, accuracy_real_t s) {
+	unsigned int i;
+	for (i = 0; i < 4; ++i) {
+		value[i] = v;
+		scale[i] = s;
+	}
+}
+
+static bool
+accuracy_ref_add(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int i;
+	for (i = 0; i < 4; ++i) {
+		value[i] = (accuracy_real_t)in->a[i] + (accuracy_real_t)in->b[i];
+		scale[i] = 0;
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_mul(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int i;
+	for (i = 0; i < 4; ++i) {
+		value[i] = (accuracy_real_t)in->a[i] * (accuracy_real_t)in->b[i];
+		scale[i] = 0;
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_div(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int i;
+	for (i = 0; i < 4; ++i) {
+		if (in->b[i] == 0)
+			return false;
+		value[i] = (accuracy_real_t)in->a[i] / (accuracy_real_t)in->b[i];
+		scale[i] = 0;
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_muladd(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int i;
+	for (i = 0; i < 4; ++i) {
+		const accuracy_real_t product = (accuracy_real_t)in->a[i] * (accuracy_real_t)in->b[i];
+		value[i] = product + (accuracy_real_t)in->c[i];
+		scale[i] = fabsl(product) + fabsl((accuracy_real_t)in->c[i]);
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_lerp(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	const accuracy_real_t factor = in->factor;
+	unsigned int i;
+	for (i = 0; i < 4; ++i) {
+		const accuracy_real_t delta = ((accuracy_real_t)in->b[i] - (accuracy_real_t)in->a[i]) * factor;
+		value[i] = (accuracy_real_t)in->a[i] + delta;
+		scale[i] = fabsl((accuracy_real_t)in->a[i]) + fabsl(delta);
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_dot(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	accuracy_uniform(value, scale, accuracy_dot(in->a, in->b, 4), accuracy_dot_abs(in->a, in->b, 4));
+	return true;
+}
+
+static bool
+accuracy_ref_dot3(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	accuracy_uniform(value, scale, accuracy_dot(in->a, in->b, 3), accuracy_dot_abs(in->a, in->b, 3));
+	return true;
+}
+
+static bool
+accuracy_ref_cross3(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int i;
+	for (i = 0; i < 3; ++i) {
+		const unsigned int j = (i + 1) % 3;
+		const unsigned int k = (i + 2) % 3;
+		const accuracy_real_t first = (accuracy_real_t)in->a[j] * (accuracy_real_t)in->b[k];
+		const accuracy_real_t second = (accuracy_real_t)in->a[k] * (accuracy_real_t)in->b[j];
+		value[i] = first - second;
+		scale[i] = fabsl(first) + fabsl(second);
+	}
+	return true;
+}
+
+static bool
+accuracy_normalize(const float32_t* v, unsigned int count, accuracy_real_t* value, accuracy_real_t* scale) {
+	const accuracy_real_t length = sqrtl(accuracy_dot(v, v, count));
+	unsigned int i;
+	if (length == 0)
+		return false;
+	for (i = 0; i < count; ++i) {
+		value[i] = (accuracy_real_t)v[i] / length;
+		scale[i] = 0;
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_normalize(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	return accuracy_normalize(in->a, 4, value, scale);
+}
+
+static bool
+accuracy_ref_normalize3(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	return accuracy_normalize(in->a, 3, value, scale);
+}
+
+//Decoded octahedral directions have an absolute error bounded relative to unit length
+static bool
+accuracy_ref_octahedral(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int i;
+	if (!accuracy_normalize(in->a, 3, value, scale))
+		return false;
+	for (i = 0; i < 3; ++i)
+		scale[i] = 1;
+	return true;
+}
+
+static bool
+accuracy_ref_length(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	accuracy_uniform(value, scale, sqrtl(accuracy_dot(in->a, in->a, 4)), 0);
+	return true;
+}
+
+static bool
+accuracy_ref_length3(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	accuracy_uniform(value, scale, sqrtl(accuracy_dot(in->a, in->a, 3)), 0);
+	return true;
+}
+
+//Projection and reflection of a on the normalized b, reflection is 2 * projection - a
+static bool
+accuracy_project(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale, bool reflect) {
+	const accuracy_real_t length = sqrtl(accuracy_dot(in->b, in->b, 4));
+	accuracy_real_t dot = 0, dot_abs = 0;
+	unsigned int i;
+	if (length == 0)
+		return false;
+	for (i = 0; i < 4; ++i) {
+		const accuracy_real_t term = ((accuracy_real_t)in->b[i] / length) * (accuracy_real_t)in->a[i];
+		dot += term;
+		dot_abs += fabsl(term);
+	}
+	for (i = 0; i < 4; ++i) {
+		const accuracy_real_t normal = (accuracy_real_t)in->b[i] / length;
+		value[i] = normal * dot;
+		scale[i] = fabsl(normal) * dot_abs;
+		if (reflect) {
+			value[i] = (2 * value[i]) - (accuracy_real_t)in->a[i];
+			scale[i] = (2 * scale[i]) + fabsl((accuracy_real_t)in->a[i]);
+		}
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_project(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	return accuracy_project(in, value, scale, false);
+}
+
+static bool
+accuracy_ref_reflect(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	return accuracy_project(in, value, scale, true);
+}
+
+static bool
+accuracy_ref_matrix_mul(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int row, col, k;
+	for (row = 0; row < 4; ++row) {
+		for (col = 0; col < 4; ++col) {
+			accuracy_real_t sum = 0, sum_abs = 0;
+			for (k = 0; k < 4; ++k) {
+				const accuracy_real_t term = (accuracy_real_t)in->m0[(row * 4) + k] * (accuracy_real_t)in->m1[(k * 4) + col];
+				sum += term;
+				sum_abs += fabsl(term);
+			}
+			value[(row * 4) + col] = sum;
+			scale[(row * 4) + col] = sum_abs;
+		}
+	}
+	return true;
+}
+
+//Row vector times the first rows of the matrix
+static void
+accuracy_transform(const accuracy_input_t* in, unsigned int rows, accuracy_real_t* value, accuracy_real_t* scale) {
+	unsigned int col, k;
+	for (col = 0; col < 4; ++col) {
+		accuracy_real_t sum = 0, sum_abs = 0;
+		for (k = 0; k < rows; ++k) {
+			const accuracy_real_t term = (accuracy_real_t)in->a[k] * (accuracy_real_t)in->m0[(k * 4) + col];
+			sum += term;
+			sum_abs += fabsl(term);
+		}
+		value[col] = sum;
+		scale[col] = sum_abs;
+	}
+}
+
+static bool
+accuracy_ref_matrix_rotate(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	accuracy_transform(in, 3, value, scale);
+	return true;
+}
+
+static bool
+accuracy_ref_matrix_transform(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	accuracy_transform(in, 4, value, scale);
+	return true;
+}
+
+static bool
+accuracy_ref_quaternion_inverse(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	const accuracy_real_t norm = accuracy_dot(in->a, in->a, 4);
+	unsigned int i;
+	if (norm == 0)
+		return false;
+	for (i = 0; i < 4; ++i) {
+		value[i] = ((i < 3) ? -(accuracy_real_t)in->a[i] : (accuracy_real_t)in->a[i]) / norm;
+		scale[i] = 0;
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_quaternion_mul(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	//Same component order and signs as quaternion_mul, q0 is a and q1 is b
+	static const int index[4][4] = { { 0, 3, 2, 1 }, { 1, 2, 3, 0 }, { 2, 1, 0, 3 }, { 3, 0, 1, 2 } };
+	static const int sign[4][4] = { { 1, 1, 1, -1 }, { 1, -1, 1, 1 }, { 1, 1, -1, 1 }, { 1, -1, -1, -1 } };
+	static const int order[4] = { 3, 0, 1, 2 };
+	unsigned int i, k;
+	for (i = 0; i < 4; ++i) {
+		accuracy_real_t sum = 0, sum_abs = 0;
+		for (k = 0; k < 4; ++k) {
+			//Term k is q1[order[k]] * q0[index[i][k]], q1 components in order w, x, y, z
+			const accuracy_real_t term = (accuracy_real_t)in->b[order[k]] * (accuracy_real_t)in->a[index[i][k]];
+			sum += sign[i][k] * term;
+			sum_abs += fabsl(term);
+		}
+		value[i] = sum;
+		scale[i] = sum_abs;
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_quaternion_slerp(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	const accuracy_real_t factor = in->factor;
+	accuracy_real_t cosval = accuracy_dot(in->q0, in->q1, 4);
+	const accuracy_real_t direction = (cosval < 0) ? -1 : 1;
+	accuracy_real_t angle, sinval, c0, c1;
+	unsigned int i;
+
+	//Interpolate to the negated target if needed to take the shortest path
+	cosval *= direction;
+	angle = (cosval < 1) ? acosl(cosval) : 0;
+	sinval = sinl(angle);
+	if (sinval > 0) {
+		c0 = sinl((1 - factor) * angle) / sinval;
+		c1 = sinl(factor * angle) / sinval;
+	}
+	else {
+		c0 = 1 - factor;
+		c1 = factor;
+	}
+	c1 *= direction;
+	for (i = 0; i < 4; ++i) {
+		value[i] = (c0 * (accuracy_real_t)in->q0[i]) + (c1 * (accuracy_real_t)in->q1[i]);
+		scale[i] = fabsl(c0 * (accuracy_real_t)in->q0[i]) + fabsl(c1 * (accuracy_real_t)in->q1[i]);
+	}
+	return true;
+}
+
+static bool
+accuracy_ref_quaternion_rotate(const accuracy_input_t* in, accuracy_real_t* value, accuracy_real_t* scale) {
+	//Same formulation as quaternion_rotate, v' = qv * (qv . v) + v1 * qs - v1 x qv with
+	//v1 = qs * v + qv x v, exact for unit length quaternions
+	const accuracy_real_t qs = in->q0[3];
+	accuracy_real_t qv[3], v[3], v1[3];
+	accuracy_real_t dot = 0, length = 0;
+	unsigned int i;
+	for (i = 0; i < 3; ++i) {
+		qv[i] = in->q0[i];
+		v[i] = in->a[i];
+		dot += qv[i] * v[i];
+		length += v[i] * v[i];
+	}
+	for (i = 0; i < 3; ++i)
+		v1[i] = (qs * v[i]) + ((qv[(i + 1) % 3] * v[(i + 2) % 3]) - (qv[(i + 2) % 3] * v[(i + 1) % 3]));
+	length = sqrtl(length);
+	for (i = 0; i < 3; ++i) {
+		value[i] = (qv[i] * dot) + (v1[i] * qs) - ((v1[(i + 1) % 3] * qv[(i + 2) % 3]) - (v1[(i + 2) % 3] * qv[(i + 1) % 3]));
+		//Rotation preserves length, components cancel down from the length of the vector
+		scale[i] = length;
+	}
+	return true;
+}
+
+/* Limits are the measured errors with some margin, so they catch regressions. Fast math builds
+   compute division with a refined reciprocal estimate, so it is not correctly rounded. Slerp
+   loses precision for small angles where the arc cosine is ill conditioned. The reciprocal
+   square root estimate has a relative error up to 1.5 * 2^-12, about 6000 ULP, and appears
+   twice in projections */
+static const accuracy_function_spec_t _accuracy_function[ACCURACY_FUNCTION_COUNT] = {
+	{ "vector_add", 4, 0.5, 0.5, accuracy_ref_add },
+	{ "vector_mul", 4, 0.5, 0.5, accuracy_ref_mul },
+	{ "vector_div", 4, 3, 3, accuracy_ref_div },
+	{ "vector_muladd", 4, 1, 1, accuracy_ref_muladd },
+	{ "vector_lerp", 4, 2, 2, accuracy_ref_lerp },
+	{ "vector_dot", 4, 2, 2, accuracy_ref_dot },
+	{ "vector_dot3", 4, 2, 2, accuracy_ref_dot3 },
+	{ "vector_cross3", 3, 2, 2, accuracy_ref_cross3 },
+	{ "vector_normalize", 4, 6, 8192, accuracy_ref_normalize },
+	{ "vector_normalize3", 3, 6, 8192, accuracy_ref_normalize3 },
+	{ "vector_length", 4, 2, 2, accuracy_ref_length },
+	{ "vector_length_fast", 4, 2, 2, accuracy_ref_length },
+	{ "vector_length3", 4, 2, 2, accuracy_ref_length3 },
+	{ "vector_length3_fast", 4, 2, 2, accuracy_ref_length3 },
+	{ "vector_project", 4, 8, 16384, accuracy_ref_project },
+	{ "vector_reflect", 4, 8, 16384, accuracy_ref_reflect },
+	{ "vector_octahedral", 3, 4, 8192, accuracy_ref_octahedral },
+	{ "matrix_mul", 16, 3, 3, accuracy_ref_matrix_mul },
+	{ "matrix_rotate", 3, 2, 2, accuracy_ref_matrix_rotate },
+	{ "matrix_transform", 4, 2, 2, accuracy_ref_matrix_transform },
+	{ "quaternion_inverse", 4, 4, 4, accuracy_ref_quaternion_inverse },
+	{ "quaternion_normalize", 4, 6, 8192, accuracy_ref_normalize },
+	{ "quaternion_mul", 4, 3, 3, accuracy_ref_quaternion_mul },
+	{ "quaternion_slerp", 4, 256, 256, accuracy_ref_quaternion_slerp },
+	{ "quaternion_rotate", 3, 3, 3, accuracy_ref_quaternion_rotate }
+};
+
+static double
+accuracy_limit(int backend, int function) {
+#if !VECTOR_DETERMINISTIC
+	if (backend != VECTOR_TEST_BACKEND_FALLBACK)
+		return _accuracy_function[function].max_ulp_estimate;
+#else
+	FOUNDATION_UNUSED(backend);
+#endif
+	return _accuracy_function[function].max_ulp;
+}
+
+//Spacing of single precision values at the magnitude of the given value
+static accuracy_real_t
+accuracy_ulp(accuracy_real_t value) {
+	int exponent;
+	value = fabsl(value);
+	if (value < FLT_MIN)
+		return ldexpl(1, FLT_MIN_EXP - FLT_MANT_DIG);
+	frexpl(value, &exponent);
+	return ldexpl(1, exponent - FLT_MANT_DIG);
+}
+
+//Bit test, fast math builds may fold isfinite to true
+static bool
+accuracy_is_finite(float32_t value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits & 0x7F800000U) != 0x7F800000U;
+}
+
+static uint32_t
+accuracy_random(uint32_t* state) {
+	*state = (*state * 1664525U) + 1013904223U;
+	return *state;
+}
+
+//Random value in [-1, 1)
+static float32_t
+accuracy_random_real(uint32_t* state) {
+	return (float32_t)((int32_t)(accuracy_random(state) >> 8) - (1 << 23)) / 8388608.0f;
+}
+
+//Random vector with components in [-1, 1) scaled by a random power of two in [2^-16, 2^16]
+static void
+accuracy_random_vector(uint32_t* state, float32_t* v) {
+	const float32_t scale = ldexpf(1.0f, (int)(accuracy_random(state) % 33) - 16);
+	unsigned int i;
+	for (i = 0; i < 4; ++i)
+		v[i] = accuracy_random_real(state) * scale;
+}
+
+static void
+accuracy_unit_quaternion(float32_t* q, const accuracy_real_t* v) {
+	const accuracy_real_t length = sqrtl((v[0] * v[0]) + (v[1] * v[1]) + (v[2] * v[2]) + (v[3] * v[3]));
+	unsigned int i;
+	for (i = 0; i < 4; ++i)
+		q[i] = (float32_t)(v[i] / length);
+}
+
+static void
+accuracy_random_quaternion(uint32_t* state, float32_t* q) {
+	accuracy_real_t v[4];
+	unsigned int i;
+	do {
+		for (i = 0; i < 4; ++i)
+			v[i] = accuracy_random_real(state);
+	} while (((v[0] * v[0]) + (v[1] * v[1]) + (v[2] * v[2]) + (v[3] * v[3])) < 0.01L);
+	accuracy_unit_quaternion(q, v);
+}
+
+static void
+accuracy_random_input(uint32_t* state, accuracy_input_t* input) {
+	unsigned int i;
+	accuracy_random_vector(state, input->a);
+	accuracy_random_vector(state, input->b);
+	accuracy_random_vector(state, input->c);
+	accuracy_random_quaternion(state, input->q0);
+	accuracy_random_quaternion(state, input->q1);
+	for (i = 0; i < 16; i += 4) {
+		accuracy_random_vector(state, input->m0 + i);
+		accuracy_random_vector(state, input->m1 + i);
+	}
+	input->factor = (accuracy_random_real(state) + 1.0f) * 0.5f;
+}
+
+#define ACCURACY_SPECIAL_COUNT 10
+#define ACCURACY_RELATION_COUNT 5
+
+static const float32_t _accuracy_special[ACCURACY_SPECIAL_COUNT][4] = {
+	{ 0, 0, 0, 0 },
+	{ -0.0f, -0.0f, -0.0f, -0.0f },
+	{ 1, 0, 0, 0 },
+	{ 0, -1, 0, 0 },
+	{ 0, 0, 0, 1 },
+	{ 1, 1, 1, 1 },
+	{ 1e-18f, -2e-18f, 3e-18f, 1e-18f },
+	{ 1e18f, -2e18f, 5e17f, 1e18f },
+	{ 1e6f, -1e-6f, 1, -1e3f },
+	{ 1, 1e-7f, -1e-7f, 0 }
+};
+
+/* Edge case inputs, every special vector as first argument combined with a random, equal,
+   opposite, nearly equal and special second argument. Quaternion pairs are equal, opposite,
+   nearly equal, orthogonal or random, with factors at the ends and middle of the range */
+static void
+accuracy_edge_input(uint32_t* state, size_t index, accuracy_input_t* input) {
+	const float32_t* special = _accuracy_special[index % ACCURACY_SPECIAL_COUNT];
+	const size_t relation = index / ACCURACY_SPECIAL_COUNT;
+	accuracy_real_t nearby[4];
+	unsigned int i;
+
+	accuracy_random_input(state, input);
+	memcpy(input->a, special, sizeof(input->a));
+	for (i = 0; i < 4; ++i) {
+		switch (relation) {
+		case 0: break;
+		case 1: input->b[i] = special[i]; break;
+		case 2: input->b[i] = -special[i]; break;
+		case 3: input->b[i] = special[i] * (1.0f + FLT_EPSILON * 4); break;
+		default: input->b[i] = _accuracy_special[(index + 3) % ACCURACY_SPECIAL_COUNT][i]; break;
+		}
+		nearby[i] = (accuracy_real_t)input->q0[i] + ((i == 0) ? 1e-6L : 0);
+	}
+
+	switch (relation) {
+	case 0: memcpy(input->q1, input->q0, sizeof(input->q1)); break;
+	case 1: for (i = 0; i < 4; ++i) input->q1[i] = -input->q0[i]; break;
+	case 2: accuracy_unit_quaternion(input->q1, nearby); break;
+	case 3:
+		input->q1[0] = -input->q0[1];
+		input->q1[1] = input->q0[0];
+		input->q1[2] = -input->q0[3];
+		input->q1[3] = input->q0[2];
+		break;
+	default: break;
+	}
+
+	if ((index % 4) < 3)
+		input->factor = (float32_t)(index % 4) * 0.5f;
+}
+
+static void
+accuracy_measure(const accuracy_input_t* input, size_t count, const float32_t* result,
+                 accuracy_error_t* error) {
+	accuracy_real_t value[ACCURACY_RESULT_SIZE];
+	accuracy_real_t scale[ACCURACY_RESULT_SIZE];
+	int ifunc;
+	size_t i;
+	unsigned int icomp;
+
+	for (ifunc = 0; ifunc < ACCURACY_FUNCTION_COUNT; ++ifunc) {
+		const accuracy_function_spec_t* spec = &_accuracy_function[ifunc];
+		accuracy_error_t* func_error = &error[ifunc];
+		memset(func_error, 0, sizeof(*func_error));
+		for (i = 0; i < count; ++i) {
+			const float32_t* actual = result + (((ifunc * count) + i) * ACCURACY_RESULT_SIZE);
+			if (!spec->reference(input + i, value, scale))
+				continue;
+			for (icomp = 0; icomp < spec->components; ++icomp) {
+				const accuracy_real_t magnitude = (fabsl(value[icomp]) > scale[icomp]) ? fabsl(value[icomp]) : scale[icomp];
+				double ulp;
+				if (!accuracy_is_finite(actual[icomp])) {
+					++func_error->nonfinite;
+					continue;
+				}
+				ulp = (double)(fabsl((accuracy_real_t)actual[icomp] - value[icomp]) / accuracy_ulp(magnitude));
+				if (ulp > func_error->max_ulp) {
+					func_error->max_ulp = ulp;
+					func_error->worst = i;
+				}
+				func_error->sum_ulp += ulp;
+				++func_error->count;
+			}
+		}
+	}
+}
+
+DECLARE_TEST(accuracy, reference) {
+	//Correctly rounded operations are within half an ULP of the reference by definition
+	accuracy_input_t input;
+	accuracy_real_t value[ACCURACY_RESULT_SIZE];
+	accuracy_real_t scale[ACCURACY_RESULT_SIZE];
+
+	memset(&input, 0, sizeof(input));
+	input.a[0] = 1.0f;
+	input.b[0] = 3.0f;
+	EXPECT_TRUE(accuracy_ref_div(&input, value, scale) == false);
+	input.b[1] = input.b[2] = input.b[3] = 3.0f;
+	EXPECT_TRUE(accuracy_ref_div(&input, value, scale));
+	EXPECT_REALLE((real)(fabsl((accuracy_real_t)(1.0f / 3.0f) - value[0]) / accuracy_ulp(value[0])), REAL_C(0.5));
+	EXPECT_REALEQ((real)accuracy_ulp(1.0L), FLT_EPSILON);
+	EXPECT_REALEQ((real)accuracy_ulp(0.75L), FLT_EPSILON * 0.5f);
+	EXPECT_TRUE(accuracy_is_finite(1.0f));
+	EXPECT_FALSE(accuracy_is_finite(FLT_MAX * 2.0f));
+
+	return 0;
+}
+
+DECLARE_TEST(accuracy, backends) {
+	const size_t count = ACCURACY_RANDOM_COUNT + (ACCURACY_SPECIAL_COUNT * ACCURACY_RELATION_COUNT);
+	accuracy_error_t error[VECTOR_TEST_BACKEND_COUNT][ACCURACY_FUNCTION_COUNT];
+	bool available[VECTOR_TEST_BACKEND_COUNT];
+	accuracy_input_t* input;
+	float32_t* result;
+	uint32_t state = 0x5EED4ACCU;
+	char buffer[256];
+	string_t line;
+	size_t i, failed = 0;
+	int ibackend, ifunc;
+
+	input = memory_allocate(HASH_TEST, sizeof(accuracy_input_t) * count, 0, MEMORY_PERSISTENT);
+	result = memory_allocate(HASH_TEST, sizeof(float32_t) * ACCURACY_RESULT_SIZE * ACCURACY_FUNCTION_COUNT * count,
+	                         0, MEMORY_PERSISTENT);
+
+	for (i = 0; i < ACCURACY_RANDOM_COUNT; ++i)
+		accuracy_random_input(&state, input + i);
+	for (; i < count; ++i)
+		accuracy_edge_input(&state, i - ACCURACY_RANDOM_COUNT, input + i);
+
+	available[VECTOR_TEST_BACKEND_FALLBACK] = accuracy_evaluate_fallback(input, count, result);
+	if (available[VECTOR_TEST_BACKEND_FALLBACK])
+		accuracy_measure(input, count, result, error[VECTOR_TEST_BACKEND_FALLBACK]);
+	available[VECTOR_TEST_BACKEND_SSE2] = accuracy_evaluate_sse2(input, count, result);
+	if (available[VECTOR_TEST_BACKEND_SSE2])
+		accuracy_measure(input, count, result, error[VECTOR_TEST_BACKEND_SSE2]);
+	available[VECTOR_TEST_BACKEND_SSE3] = accuracy_evaluate_sse3(input, count, result);
+	if (available[VECTOR_TEST_BACKEND_SSE3])
+		accuracy_measure(input, count, result, error[VECTOR_TEST_BACKEND_SSE3]);
+	available[VECTOR_TEST_BACKEND_SSE4] = accuracy_evaluate_sse4(input, count, result);
+	if (available[VECTOR_TEST_BACKEND_SSE4])
+		accuracy_measure(input, count, result, error[VECTOR_TEST_BACKEND_SSE4]);
+
+	EXPECT_TRUE(available[VECTOR_TEST_BACKEND_FALLBACK]);
+
+	//Report table of max/mean ULP error per function and backend
+	line = string_format(buffer, sizeof(buffer), STRING_CONST("%-24s"), "max/mean ulp");
+	for (ibackend = 0; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+		if (available[ibackend])
+			line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %17s"),
+			                            _backend_name[ibackend]);
+	}
+	log_info(HASH_TEST, STRING_ARGS(line));
+	for (ifunc = 0; ifunc < ACCURACY_FUNCTION_COUNT; ++ifunc) {
+		line = string_format(buffer, sizeof(buffer), STRING_CONST("%-24s"), _accuracy_function[ifunc].name);
+		for (ibackend = 0; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+			const accuracy_error_t* func_error = &error[ibackend][ifunc];
+			if (!available[ibackend])
+				continue;
+			line = string_append_format(buffer, line.length, sizeof(buffer), STRING_CONST(" %8.2f/%-8.3f"),
+			                            func_error->max_ulp,
+			                            func_error->count ? func_error->sum_ulp / (double)func_error->count : 0.0);
+		}
+		log_info(HASH_TEST, STRING_ARGS(line));
+	}
+
+	for (ibackend = 0; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+		if (!available[ibackend]) {
+			log_infof(HASH_TEST, STRING_CONST("Backend %s not available in this build"), _backend_name[ibackend]);
+			continue;
+		}
+		for (ifunc = 0; ifunc < ACCURACY_FUNCTION_COUNT; ++ifunc) {
+			const accuracy_error_t* func_error = &error[ibackend][ifunc];
+			const double limit = accuracy_limit(ibackend, ifunc);
+			if ((func_error->max_ulp > limit) || func_error->nonfinite) {
+				++failed;
+				log_warnf(HASH_TEST, WARNING_SUSPICIOUS,
+				          STRING_CONST("%s: %s error %.2f ulp (limit %.2f) at input %" PRIsize ", %" PRIsize
+				                       " non-finite results"), _backend_name[ibackend], _accuracy_function[ifunc].name,
+				          func_error->max_ulp, limit, func_error->worst,
+				          func_error->nonfinite);
+			}
+		}
+	}
+
+	memory_deallocate(input);
+	memory_deallocate(result);
+
+	EXPECT_SIZEEQ(failed, 0);
+
+	return 0;
+}
+
+static application_t
+test_accuracy_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Accuracy tests"));
+	app.short_name = string_const(STRING_CONST("test_accuracy"));
+	app.company = string_const(STRING_CONST("Rampant Pixels"));
+	app.version = vector_module_version();
+	app.exception_handler = test_exception_handler;
+	app.flags = APPLICATION_UTILITY;
+	return app;
+}
+
+static memory_system_t
+test_accuracy_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_accuracy_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_accuracy_initialize(void) {
+	vector_config_t config;
+	memset(&config, 0, sizeof(config));
+	return vector_module_initialize(config);
+}
+
+static void
+test_accuracy_finalize(void) {
+	vector_module_finalize();
+}
+
+static void
+test_accuracy_declare(void) {
+	ADD_TEST(accuracy, reference);
+	ADD_TEST(accuracy, backends);
+}
+
+static test_suite_t test_accuracy_suite = {
+	test_accuracy_application,
+	test_accuracy_memory_system,
+	test_accuracy_config,
+	test_accuracy_declare,
+	test_accuracy_initialize,
+	test_accuracy_finalize,
+	0
+};
+
+
+#if BUILD_MONOLITHIC
+
+int
+test_accuracy_run(void);
+
+int
+test_accuracy_run(void) {
+	test_suite = test_accuracy_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_accuracy_suite;
+}
+
+#endif
@@ -184,8 +184,13 @@ main_initialize(void) {
 #endif
 
 #if BUILD_MONOLITHIC
+extern int test_accuracy_run(void);
+extern int test_deterministic_run(void);
+extern int test_fuzz_run(void);
+extern int test_geometry_run(void);
 extern int test_matrix_run(void);
 extern int test_quaternion_run(void);
+extern int test_validate_run(void);
 extern int test_vector_run(void);
 typedef int (*test_run_fn)(void);
 
@@ -269,8 +274,13 @@ main_run(void* main_arg) {
 #if BUILD_MONOLITHIC
 
 	test_run_fn tests[] = {
+		test_accuracy_run,
+		test_deterministic_run,
+		test_fuzz_run,
+		test_geometry_run,
 		test_matrix_run,
 		test_quaternion_run,
+		test_validate_run,
 		test_vector_run,
 		0
 	};
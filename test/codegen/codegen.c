@@ -0,0 +1,141 @@
+/* codegen.c  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/* Reference wrappers around the inline kernels for the codegen regression check in codegen.py.
+   Compiled once per backend with VECTOR_TEST_BACKEND set on the command line, operands are
+   passed by pointer so any stack access in the disassembly is a spill and not argument passing */
+
+#include <foundation/foundation.h>
+
+#include "../test/backend.h"
+
+#include <vector/vector.h>
+
+#define CODEGEN_V1(name) \
+	void codegen_##name(vector_t* out, const vector_t* v); \
+	void codegen_##name(vector_t* out, const vector_t* v) { *out = name(*v); }
+
+#define CODEGEN_V2(name) \
+	void codegen_##name(vector_t* out, const vector_t* v0, const vector_t* v1); \
+	void codegen_##name(vector_t* out, const vector_t* v0, const vector_t* v1) { *out = name(*v0, *v1); }
+
+#define CODEGEN_V3(name) \
+	void codegen_##name(vector_t* out, const vector_t* v0, const vector_t* v1, const vector_t* v2); \
+	void codegen_##name(vector_t* out, const vector_t* v0, const vector_t* v1, const vector_t* v2) { \
+		*out = name(*v0, *v1, *v2); \
+	}
+
+#define CODEGEN_VS(name) \
+	void codegen_##name(vector_t* out, const vector_t* v, real s); \
+	void codegen_##name(vector_t* out, const vector_t* v, real s) { *out = name(*v, s); }
+
+#define CODEGEN_V2S(name) \
+	void codegen_##name(vector_t* out, const vector_t* v0, const vector_t* v1, real s); \
+	void codegen_##name(vector_t* out, const vector_t* v0, const vector_t* v1, real s) { *out = name(*v0, *v1, s); }
+
+#define CODEGEN_S1(name) \
+	real codegen_##name(const vector_t* v); \
+	real codegen_##name(const vector_t* v) { return name(*v); }
+
+#define CODEGEN_U1(name) \
+	unsigned int codegen_##name(const vector_t* v); \
+	unsigned int codegen_##name(const vector_t* v) { return (unsigned int)name(*v); }
+
+#define CODEGEN_U2(name) \
+	unsigned int codegen_##name(const vector_t* v0, const vector_t* v1); \
+	unsigned int codegen_##name(const vector_t* v0, const vector_t* v1) { return (unsigned int)name(*v0, *v1); }
+
+#define CODEGEN_M1(name) \
+	void codegen_##name(matrix_t* out, const matrix_t* m); \
+	void codegen_##name(matrix_t* out, const matrix_t* m) { *out = name(*m); }
+
+#define CODEGEN_M2(name) \
+	void codegen_##name(matrix_t* out, const matrix_t* m0, const matrix_t* m1); \
+	void codegen_##name(matrix_t* out, const matrix_t* m0, const matrix_t* m1) { *out = name(*m0, *m1); }
+
+#define CODEGEN_MV(name) \
+	void codegen_##name(vector_t* out, const matrix_t* m, const vector_t* v); \
+	void codegen_##name(vector_t* out, const matrix_t* m, const vector_t* v) { *out = name(*m, *v); }
+
+CODEGEN_V1(vector_normalize)
+CODEGEN_V1(vector_normalize3)
+CODEGEN_V2(vector_dot)
+CODEGEN_V2(vector_dot3)
+CODEGEN_V2(vector_cross3)
+CODEGEN_V2(vector_mul)
+CODEGEN_V2(vector_div)
+CODEGEN_V2(vector_add)
+CODEGEN_V2(vector_sub)
+CODEGEN_V1(vector_neg)
+CODEGEN_V3(vector_muladd)
+CODEGEN_VS(vector_scale)
+CODEGEN_V2S(vector_lerp)
+CODEGEN_V2(vector_project)
+CODEGEN_V2(vector_reflect)
+CODEGEN_V2(vector_project3)
+CODEGEN_V2(vector_reflect3)
+CODEGEN_V1(vector_length)
+CODEGEN_V1(vector_length_fast)
+CODEGEN_V1(vector_length_sqr)
+CODEGEN_V1(vector_length3)
+CODEGEN_V1(vector_length3_fast)
+CODEGEN_V1(vector_length3_sqr)
+CODEGEN_V2(vector_min)
+CODEGEN_V2(vector_max)
+CODEGEN_V1(vector_abs)
+CODEGEN_S1(vector_x)
+CODEGEN_S1(vector_w)
+CODEGEN_U2(vector_equal)
+CODEGEN_U2(vector_equal_exact_lanes)
+CODEGEN_V2(vector_cmplt)
+CODEGEN_V2(vector_cmpeq)
+CODEGEN_V2(vector_and)
+CODEGEN_V2(vector_andnot)
+CODEGEN_V3(vector_select)
+CODEGEN_U1(vector_movemask)
+CODEGEN_U1(vector_any)
+CODEGEN_V1(vector_octahedral_encode)
+CODEGEN_V1(vector_octahedral_decode)
+
+CODEGEN_M1(matrix_transpose)
+CODEGEN_M2(matrix_mul)
+CODEGEN_M2(matrix_add)
+CODEGEN_MV(matrix_rotate)
+CODEGEN_MV(matrix_transform)
+
+CODEGEN_V1(quaternion_conjugate)
+CODEGEN_V1(quaternion_inverse)
+CODEGEN_V1(quaternion_normalize)
+CODEGEN_V2(quaternion_mul)
+CODEGEN_V2S(quaternion_slerp)
+CODEGEN_V2(quaternion_rotate)
+
+//Functions taking an immediate, the instruction selection depends on the constant
+void codegen_vector_shuffle(vector_t* out, const vector_t* v);
+void codegen_vector_shuffle(vector_t* out, const vector_t* v) { *out = vector_shuffle(*v, VECTOR_MASK_YZXW); }
+
+void codegen_vector_blend(vector_t* out, const vector_t* v0, const vector_t* v1);
+void codegen_vector_blend(vector_t* out, const vector_t* v0, const vector_t* v1) {
+	*out = vector_blend(*v0, *v1, VECTOR_BLEND_0101);
+}
+
+real codegen_vector_component(const vector_t* v);
+real codegen_vector_component(const vector_t* v) { return vector_component(*v, 2); }
+
+unsigned int codegen_vector_equal_ulps_lanes(const vector_t* v0, const vector_t* v1);
+unsigned int codegen_vector_equal_ulps_lanes(const vector_t* v0, const vector_t* v1) {
+	return vector_equal_ulps_lanes(*v0, *v1, 4);
+}
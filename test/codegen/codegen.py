@@ -0,0 +1,161 @@
+#!/usr/bin/env python
+
+"""Codegen regression check for the inline vector kernels
+
+Compiles the reference wrappers in codegen.c once per backend, disassembles them with objdump
+and compares instruction count, stack accesses (spills) and calls per function against the
+checked in baseline for the compiler. Baselines are specific to compiler and major version,
+create or refresh one with --update after verifying a codegen change is intended."""
+
+import sys
+import os
+import re
+import argparse
+import platform
+import subprocess
+import tempfile
+
+backends = ['fallback', 'sse2', 'sse3', 'sse4']
+
+rootpath = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..'))
+basepath = os.path.join(rootpath, 'test', 'codegen')
+
+def compiler_id(cc):
+  output = subprocess.check_output([cc, '--version'], universal_newlines = True)
+  name = 'clang' if 'clang' in output else 'gcc'
+  version = subprocess.check_output([cc, '-dumpversion'], universal_newlines = True).strip()
+  return name + '-' + version.split('.')[0]
+
+def compile_backend(cc, foundation, backend, objfile):
+  command = [cc, '-std=c11', '-O3', '-ffast-math', '-msse4.1', '-DBUILD_DEPLOY=1',
+             '-DVECTOR_TEST_BACKEND=' + str(backends.index(backend)),
+             '-I' + rootpath, '-I' + foundation, '-fno-asynchronous-unwind-tables',
+             '-c', os.path.join(basepath, 'codegen.c'), '-o', objfile]
+  subprocess.check_call(command)
+
+def is_padding(instruction):
+  return instruction.startswith('nop') or instruction.startswith('cs nop') or instruction.startswith('data16') or \
+         instruction.startswith('xchg   %ax,%ax') or instruction == 'int3'
+
+def parse_disassembly(objdump, objfile):
+  output = subprocess.check_output([objdump, '-dr', '--no-show-raw-insn', '-M', 'att', objfile], universal_newlines = True)
+  functions = {}
+  current = None
+  for line in output.splitlines():
+    match = re.match(r'^[0-9a-f]+ <codegen_(\w+)>:$', line)
+    if match:
+      current = {'instructions': [], 'calls': 0}
+      functions[match.group(1)] = current
+      continue
+    if current is None:
+      continue
+    if re.match(r'^\s+[0-9a-f]+: R_\w*PLT', line):
+      current['calls'] += 1
+      continue
+    match = re.match(r'^\s+[0-9a-f]+:\s+(.+)$', line)
+    if match and not re.match(r'^R_', match.group(1)):
+      current['instructions'] += [match.group(1).strip()]
+  result = {}
+  for name, function in functions.items():
+    instructions = function['instructions']
+    while instructions and is_padding(instructions[-1]):
+      instructions.pop()
+    stack = len([instruction for instruction in instructions if '%rsp' in instruction or '%rbp' in instruction or
+                 '%esp' in instruction or '%ebp' in instruction])
+    calls = function['calls'] + len([instruction for instruction in instructions if instruction.startswith('call')])
+    result[name] = (len(instructions), stack, calls)
+  return result
+
+def read_baseline(path):
+  baseline = {}
+  if not os.path.isfile(path):
+    return None
+  with open(path) as infile:
+    for line in infile:
+      line = line.strip()
+      if not line or line.startswith('#'):
+        continue
+      fields = line.split()
+      baseline[(fields[0], fields[1])] = (int(fields[2]), int(fields[3]), int(fields[4]))
+  return baseline
+
+def write_baseline(path, compiler, results):
+  if not os.path.isdir(os.path.dirname(path)):
+    os.makedirs(os.path.dirname(path))
+  with open(path, 'w') as outfile:
+    outfile.write('# Codegen baseline for ' + compiler + ', generated by codegen.py --update\n')
+    outfile.write('# backend function instructions stack calls\n')
+    for key in sorted(results.keys()):
+      outfile.write('%s %s %d %d %d\n' % (key[0], key[1], results[key][0], results[key][1], results[key][2]))
+
+def main():
+  parser = argparse.ArgumentParser(description = 'Codegen regression check for inline vector kernels')
+  parser.add_argument('--cc', default = os.environ.get('CC', 'cc'), help = 'C compiler')
+  parser.add_argument('--objdump', default = 'objdump', help = 'objdump binary')
+  parser.add_argument('--foundation', default = os.path.join(rootpath, '..', 'foundation_lib'),
+                      help = 'Path to foundation library')
+  parser.add_argument('--tolerance', type = int, default = 0,
+                      help = 'Number of additional instructions allowed per function')
+  parser.add_argument('--update', action = 'store_true', help = 'Write the baseline from the current codegen')
+  options = parser.parse_args()
+
+  if platform.machine().lower() not in ['x86_64', 'amd64', 'i386', 'i686', 'x86']:
+    print('Codegen check only supported on x86 hosts, skipped')
+    return 0
+
+  compiler = compiler_id(options.cc)
+  baselinepath = os.path.join(basepath, 'baseline', compiler + '.txt')
+
+  results = {}
+  tempdir = tempfile.mkdtemp()
+  try:
+    for backend in backends:
+      objfile = os.path.join(tempdir, 'codegen_' + backend + '.o')
+      compile_backend(options.cc, options.foundation, backend, objfile)
+      for name, values in parse_disassembly(options.objdump, objfile).items():
+        results[(backend, name)] = values
+      os.remove(objfile)
+  finally:
+    os.rmdir(tempdir)
+
+  if options.update:
+    write_baseline(baselinepath, compiler, results)
+    print('Wrote baseline ' + os.path.relpath(baselinepath, rootpath) + ' with ' + str(len(results)) + ' functions')
+    return 0
+
+  baseline = read_baseline(baselinepath)
+  if baseline is None:
+    print('No codegen baseline for ' + compiler + ', run with --update to create one')
+    return 0
+
+  failures = []
+  improved = []
+  for key in sorted(baseline.keys()):
+    if key not in results:
+      failures += ['%s %s: missing' % key]
+      continue
+    instructions, stack, calls = results[key]
+    base_instructions, base_stack, base_calls = baseline[key]
+    if instructions > base_instructions + options.tolerance:
+      failures += ['%s %s: %d instructions, baseline %d' % (key[0], key[1], instructions, base_instructions)]
+    if stack > base_stack:
+      failures += ['%s %s: %d stack accesses, baseline %d' % (key[0], key[1], stack, base_stack)]
+    if calls > base_calls:
+      failures += ['%s %s: %d calls, baseline %d' % (key[0], key[1], calls, base_calls)]
+    if (instructions < base_instructions) or (stack < base_stack) or (calls < base_calls):
+      improved += ['%s %s' % key]
+
+  for key in sorted(results.keys()):
+    if key not in baseline:
+      print('%s %s: not in baseline' % key)
+  if improved:
+    print('Improved, consider updating the baseline: ' + ', '.join(improved))
+  for failure in failures:
+    print('FAILED ' + failure)
+  if failures:
+    return 1
+  print('Codegen matches baseline ' + os.path.relpath(baselinepath, rootpath) + ' (' + str(len(baseline)) + ' functions)')
+  return 0
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,80 @@
+/* deterministic.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+typedef enum {
+	DETERMINISTIC_VECTOR_NORMALIZE = 0,
+	DETERMINISTIC_VECTOR_NORMALIZE3,
+	DETERMINISTIC_VECTOR_DOT,
+	DETERMINISTIC_VECTOR_DOT3,
+	DETERMINISTIC_VECTOR_CROSS3,
+	DETERMINISTIC_VECTOR_MUL,
+	DETERMINISTIC_VECTOR_DIV,
+	DETERMINISTIC_VECTOR_ADD,
+	DETERMINISTIC_VECTOR_SUB,
+	DETERMINISTIC_VECTOR_NEG,
+	DETERMINISTIC_VECTOR_MULADD,
+	DETERMINISTIC_VECTOR_SCALE,
+	DETERMINISTIC_VECTOR_LERP,
+	DETERMINISTIC_VECTOR_PROJECT,
+	DETERMINISTIC_VECTOR_REFLECT,
+	DETERMINISTIC_VECTOR_PROJECT3,
+	DETERMINISTIC_VECTOR_REFLECT3,
+	DETERMINISTIC_VECTOR_LENGTH,
+	DETERMINISTIC_VECTOR_LENGTH_FAST,
+	DETERMINISTIC_VECTOR_LENGTH_SQR,
+	DETERMINISTIC_VECTOR_LENGTH3,
+	DETERMINISTIC_VECTOR_LENGTH3_FAST,
+	DETERMINISTIC_VECTOR_LENGTH3_SQR,
+	DETERMINISTIC_VECTOR_MIN,
+	DETERMINISTIC_VECTOR_MAX,
+	DETERMINISTIC_VECTOR_ABS,
+	DETERMINISTIC_VECTOR_OCTAHEDRAL,
+	DETERMINISTIC_MATRIX_MUL,
+	DETERMINISTIC_MATRIX_TRANSPOSE,
+	DETERMINISTIC_MATRIX_ROTATE,
+	DETERMINISTIC_MATRIX_TRANSFORM,
+	DETERMINISTIC_QUATERNION_CONJUGATE,
+	DETERMINISTIC_QUATERNION_INVERSE,
+	DETERMINISTIC_QUATERNION_NORMALIZE,
+	DETERMINISTIC_QUATERNION_MUL,
+	DETERMINISTIC_QUATERNION_SLERP,
+	DETERMINISTIC_QUATERNION_ROTATE,
+	DETERMINISTIC_FUNCTION_COUNT
+} deterministic_function_t;
+
+//! Number of generated inputs each function is evaluated over
+#define DETERMINISTIC_INPUT_COUNT 256
+
+/* Evaluate every function over the same generated inputs with the given backend and store a
+   hash of the raw result bits per function. Returns false if the backend is not available in
+   this build, in which case the hashes are left untouched. */
+
+bool
+deterministic_hash_fallback(hash_t* hashes);
+
+bool
+deterministic_hash_sse2(hash_t* hashes);
+
+bool
+deterministic_hash_sse3(hash_t* hashes);
+
+bool
+deterministic_hash_sse4(hash_t* hashes);
@@ -0,0 +1,170 @@
+/* kernel.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/* Shared evaluation kernel, included once by each backend translation unit after selecting the
+   backend with test/backend.h and including vector.h */
+
+#include "deterministic.h"
+
+#if VECTOR_TEST_BACKEND_AVAILABLE
+
+static uint32_t
+deterministic_random(uint32_t* state) {
+	*state = (*state * 1664525U) + 1013904223U;
+	return *state;
+}
+
+//Random value in [-8, 8) with 24 significant bits, exactly representable and identical everywhere
+static real
+deterministic_real(uint32_t* state) {
+	const int32_t bits = (int32_t)(deterministic_random(state) >> 8) - (1 << 23);
+	return (real)bits / REAL_C(1048576.0);
+}
+
+static vector_t
+deterministic_vector(uint32_t* state) {
+	const real x = deterministic_real(state);
+	const real y = deterministic_real(state);
+	const real z = deterministic_real(state);
+	const real w = deterministic_real(state);
+	return vector(x, y, z, w);
+}
+
+static void
+deterministic_store(float32_t* dst, const vector_t v) {
+	dst[0] = vector_x(v);
+	dst[1] = vector_y(v);
+	dst[2] = vector_z(v);
+	dst[3] = vector_w(v);
+}
+
+//The w component of a cross product is not specified
+static void
+deterministic_store3(float32_t* dst, const vector_t v) {
+	dst[0] = vector_x(v);
+	dst[1] = vector_y(v);
+	dst[2] = vector_z(v);
+	dst[3] = 0;
+}
+
+static void
+deterministic_store_matrix(float32_t* dst, const matrix_t m) {
+	deterministic_store(dst, m.row[0]);
+	deterministic_store(dst + 4, m.row[1]);
+	deterministic_store(dst + 8, m.row[2]);
+	deterministic_store(dst + 12, m.row[3]);
+}
+
+#define DETERMINISTIC_HASH(function, store, expr) \
+	for (i = 0; i < DETERMINISTIC_INPUT_COUNT; ++i) \
+		store(result + (i * 4), expr); \
+	hashes[function] = hash(result, sizeof(float32_t) * 4 * DETERMINISTIC_INPUT_COUNT)
+
+#define DETERMINISTIC_HASH_MATRIX(function, expr) \
+	for (i = 0; i < DETERMINISTIC_INPUT_COUNT; ++i) \
+		deterministic_store_matrix(result + (i * 16), expr); \
+	hashes[function] = hash(result, sizeof(result))
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(deterministic_hash)(hash_t* hashes) {
+	//Static to keep the test thread stack usage down
+	static vector_t a[DETERMINISTIC_INPUT_COUNT];
+	static vector_t b[DETERMINISTIC_INPUT_COUNT];
+	static vector_t c[DETERMINISTIC_INPUT_COUNT];
+	static quaternion_t q0[DETERMINISTIC_INPUT_COUNT];
+	static quaternion_t q1[DETERMINISTIC_INPUT_COUNT];
+	static matrix_t m0[DETERMINISTIC_INPUT_COUNT];
+	static matrix_t m1[DETERMINISTIC_INPUT_COUNT];
+	static real factor[DETERMINISTIC_INPUT_COUNT];
+	static float32_t result[DETERMINISTIC_INPUT_COUNT * 16];
+	uint32_t state = 0x5EED1234U;
+	size_t i;
+
+	for (i = 0; i < DETERMINISTIC_INPUT_COUNT; ++i) {
+		a[i] = deterministic_vector(&state);
+		b[i] = deterministic_vector(&state);
+		c[i] = deterministic_vector(&state);
+		q0[i] = deterministic_vector(&state);
+		q1[i] = deterministic_vector(&state);
+		m0[i].row[0] = deterministic_vector(&state);
+		m0[i].row[1] = deterministic_vector(&state);
+		m0[i].row[2] = deterministic_vector(&state);
+		m0[i].row[3] = deterministic_vector(&state);
+		m1[i].row[0] = deterministic_vector(&state);
+		m1[i].row[1] = deterministic_vector(&state);
+		m1[i].row[2] = deterministic_vector(&state);
+		m1[i].row[3] = deterministic_vector(&state);
+		factor[i] = (deterministic_real(&state) + REAL_C(8.0)) / REAL_C(16.0);
+	}
+
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_NORMALIZE, deterministic_store, vector_normalize(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_NORMALIZE3, deterministic_store, vector_normalize3(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_DOT, deterministic_store, vector_dot(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_DOT3, deterministic_store, vector_dot3(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_CROSS3, deterministic_store3, vector_cross3(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_MUL, deterministic_store, vector_mul(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_DIV, deterministic_store, vector_div(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_ADD, deterministic_store, vector_add(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_SUB, deterministic_store, vector_sub(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_NEG, deterministic_store, vector_neg(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_MULADD, deterministic_store, vector_muladd(a[i], b[i], c[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_SCALE, deterministic_store, vector_scale(a[i], factor[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LERP, deterministic_store, vector_lerp(a[i], b[i], factor[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_PROJECT, deterministic_store, vector_project(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_REFLECT, deterministic_store, vector_reflect(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_PROJECT3, deterministic_store, vector_project3(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_REFLECT3, deterministic_store, vector_reflect3(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LENGTH, deterministic_store, vector_length(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LENGTH_FAST, deterministic_store, vector_length_fast(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LENGTH_SQR, deterministic_store, vector_length_sqr(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LENGTH3, deterministic_store, vector_length3(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LENGTH3_FAST, deterministic_store, vector_length3_fast(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_LENGTH3_SQR, deterministic_store, vector_length3_sqr(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_MIN, deterministic_store, vector_min(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_MAX, deterministic_store, vector_max(a[i], b[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_ABS, deterministic_store, vector_abs(a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_VECTOR_OCTAHEDRAL, deterministic_store,
+	                   vector_octahedral_decode(vector_octahedral_encode(a[i])));
+
+	DETERMINISTIC_HASH_MATRIX(DETERMINISTIC_MATRIX_MUL, matrix_mul(m0[i], m1[i]));
+	DETERMINISTIC_HASH_MATRIX(DETERMINISTIC_MATRIX_TRANSPOSE, matrix_transpose(m0[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_MATRIX_ROTATE, deterministic_store, matrix_rotate(m0[i], a[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_MATRIX_TRANSFORM, deterministic_store, matrix_transform(m0[i], a[i]));
+
+	DETERMINISTIC_HASH(DETERMINISTIC_QUATERNION_CONJUGATE, deterministic_store, quaternion_conjugate(q0[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_QUATERNION_INVERSE, deterministic_store, quaternion_inverse(q0[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_QUATERNION_NORMALIZE, deterministic_store, quaternion_normalize(q0[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_QUATERNION_MUL, deterministic_store, quaternion_mul(q0[i], q1[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_QUATERNION_SLERP, deterministic_store,
+	                   quaternion_slerp(quaternion_normalize(q0[i]), quaternion_normalize(q1[i]), factor[i]));
+	DETERMINISTIC_HASH(DETERMINISTIC_QUATERNION_ROTATE, deterministic_store,
+	                   quaternion_rotate(quaternion_normalize(q0[i]), a[i]));
+
+	return true;
+}
+
+#undef DETERMINISTIC_HASH
+#undef DETERMINISTIC_HASH_MATRIX
+
+#else
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(deterministic_hash)(hash_t* hashes) {
+	FOUNDATION_UNUSED(hashes);
+	return false;
+}
+
+#endif
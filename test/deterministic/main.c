@@ -0,0 +1,178 @@
+/* main.c  -  Deterministic tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+#include <vector/vector.h>
+
+#include "../test/backend.h"
+#include "deterministic.h"
+
+static application_t
+test_deterministic_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Deterministic tests"));
+	app.short_name = string_const(STRING_CONST("test_deterministic"));
+	app.company = string_const(STRING_CONST("Rampant Pixels"));
+	app.version = vector_module_version();
+	app.exception_handler = test_exception_handler;
+	app.flags = APPLICATION_UTILITY;
+	return app;
+}
+
+static memory_system_t 
+test_deterministic_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_deterministic_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int 
+test_deterministic_initialize(void) {
+	vector_config_t config;
+	memset(&config, 0, sizeof(config));
+	return vector_module_initialize(config);
+}
+
+static void 
+test_deterministic_finalize(void) {
+	vector_module_finalize();
+}
+
+static const char* const _backend_name[VECTOR_TEST_BACKEND_COUNT] = {
+	"fallback", "SSE2", "SSE3", "SSE4"
+};
+
+static const char* const _function_name[DETERMINISTIC_FUNCTION_COUNT] = {
+	"vector_normalize", "vector_normalize3", "vector_dot", "vector_dot3", "vector_cross3",
+	"vector_mul", "vector_div", "vector_add", "vector_sub", "vector_neg", "vector_muladd",
+	"vector_scale", "vector_lerp", "vector_project", "vector_reflect", "vector_project3",
+	"vector_reflect3", "vector_length", "vector_length_fast", "vector_length_sqr", "vector_length3",
+	"vector_length3_fast", "vector_length3_sqr", "vector_min", "vector_max", "vector_abs",
+	"vector_octahedral", "matrix_mul", "matrix_transpose", "matrix_rotate", "matrix_transform",
+	"quaternion_conjugate", "quaternion_inverse", "quaternion_normalize", "quaternion_mul",
+	"quaternion_slerp", "quaternion_rotate"
+};
+
+DECLARE_TEST(deterministic, repeat) {
+	hash_t first[DETERMINISTIC_FUNCTION_COUNT];
+	hash_t second[DETERMINISTIC_FUNCTION_COUNT];
+	int ifunc;
+
+	EXPECT_TRUE(deterministic_hash_fallback(first));
+	EXPECT_TRUE(deterministic_hash_fallback(second));
+	for (ifunc = 0; ifunc < DETERMINISTIC_FUNCTION_COUNT; ++ifunc)
+		EXPECT_HASHEQ(first[ifunc], second[ifunc]);
+
+	return 0;
+}
+
+DECLARE_TEST(deterministic, backends) {
+	hash_t hashes[VECTOR_TEST_BACKEND_COUNT][DETERMINISTIC_FUNCTION_COUNT];
+	bool available[VECTOR_TEST_BACKEND_COUNT];
+	size_t mismatch = 0;
+	int ibackend, ifunc;
+
+	available[VECTOR_TEST_BACKEND_FALLBACK] = deterministic_hash_fallback(hashes[VECTOR_TEST_BACKEND_FALLBACK]);
+	available[VECTOR_TEST_BACKEND_SSE2] = deterministic_hash_sse2(hashes[VECTOR_TEST_BACKEND_SSE2]);
+	available[VECTOR_TEST_BACKEND_SSE3] = deterministic_hash_sse3(hashes[VECTOR_TEST_BACKEND_SSE3]);
+	available[VECTOR_TEST_BACKEND_SSE4] = deterministic_hash_sse4(hashes[VECTOR_TEST_BACKEND_SSE4]);
+
+	EXPECT_TRUE(available[VECTOR_TEST_BACKEND_FALLBACK]);
+
+	for (ibackend = VECTOR_TEST_BACKEND_FALLBACK + 1; ibackend < VECTOR_TEST_BACKEND_COUNT; ++ibackend) {
+		if (!available[ibackend]) {
+			log_infof(HASH_TEST, STRING_CONST("Backend %s not available in this build"),
+			          _backend_name[ibackend]);
+			continue;
+		}
+		for (ifunc = 0; ifunc < DETERMINISTIC_FUNCTION_COUNT; ++ifunc) {
+			if (hashes[ibackend][ifunc] == hashes[VECTOR_TEST_BACKEND_FALLBACK][ifunc])
+				continue;
+#if VECTOR_DETERMINISTIC
+			log_warnf(HASH_TEST, WARNING_SUSPICIOUS, STRING_CONST("%s: %s result differs from fallback"),
+			          _backend_name[ibackend], _function_name[ifunc]);
+#else
+			log_infof(HASH_TEST, STRING_CONST("%s: %s result differs from fallback"),
+			          _backend_name[ibackend], _function_name[ifunc]);
+#endif
+			++mismatch;
+		}
+	}
+
+#if VECTOR_DETERMINISTIC
+	EXPECT_SIZEEQ(mismatch, 0);
+#else
+	//Backends are only required to match bit for bit when built with --deterministic
+	if (mismatch)
+		log_infof(HASH_TEST, STRING_CONST("%" PRIsize " results differ, build is not deterministic"), mismatch);
+#endif
+
+	return 0;
+}
+
+static void 
+test_deterministic_declare(void) {
+#if VECTOR_DETERMINISTIC
+	log_info(HASH_TEST, STRING_CONST("Deterministic mode enabled"));
+#else
+	log_info(HASH_TEST, STRING_CONST("Deterministic mode disabled, backend differences are informational"));
+#endif
+
+	ADD_TEST(deterministic, repeat);
+	ADD_TEST(deterministic, backends);
+}
+
+static test_suite_t test_deterministic_suite = {
+	test_deterministic_application,
+	test_deterministic_memory_system,
+	test_deterministic_config,
+	test_deterministic_declare,
+	test_deterministic_initialize,
+	test_deterministic_finalize,
+	0
+};
+
+
+#if BUILD_MONOLITHIC
+
+int
+test_deterministic_run(void);
+
+int
+test_deterministic_run(void) {
+	test_suite = test_deterministic_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_deterministic_suite;
+}
+
+#endif
@@ -0,0 +1,330 @@
+/* fuzz.c  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+
+#include "fuzz.h"
+
+#include <math.h>
+#include <float.h>
+
+/* The fallback implementation is the reference. Pure data movement, bitwise operations,
+   comparisons and single correctly rounded operations must match it exactly, signed zeros
+   aside. Other functions must be within a tolerance in ULP of the larger of the result and a
+   cancellation scale derived from the arguments, since the backends sum products in different
+   order. Results where the fallback is not finite are outside the domain of the function, for
+   example normalizing a zero vector, and are not compared. */
+
+typedef enum {
+	//Bit exact, except positive and negative zero compare equal
+	FUZZ_COMPARE_EXACT = 0,
+	//Within tolerance of the larger of the result magnitude and the cancellation scale
+	FUZZ_COMPARE_ULP
+} fuzz_compare_t;
+
+typedef enum {
+	FUZZ_SCALE_RESULT = 0,
+	FUZZ_SCALE_ONE,
+	//Largest component of a
+	FUZZ_SCALE_A,
+	//Largest component of a and b
+	FUZZ_SCALE_AB,
+	//Sum of four products of the largest components of a and b
+	FUZZ_SCALE_A_TIMES_B,
+	//Sum of four squares of the largest component of a
+	FUZZ_SCALE_A_SQUARED,
+	//Largest of the product of a and b and c
+	FUZZ_SCALE_MULADD,
+	//Sum of four products of the largest components of a and m0
+	FUZZ_SCALE_MATRIX_VECTOR,
+	//Sum of four products of the largest components of m0 and m1
+	FUZZ_SCALE_MATRIX_MATRIX
+} fuzz_scale_t;
+
+typedef struct fuzz_function_spec_t fuzz_function_spec_t;
+
+struct fuzz_function_spec_t {
+	const char* name;
+	//Number of leading result components compared
+	unsigned int components;
+	fuzz_compare_t compare;
+	fuzz_scale_t scale;
+	//Maximum allowed difference in ULP
+	double max_ulp;
+	//Maximum allowed difference in ULP for SIMD backends using the reciprocal square root estimate
+	double max_ulp_estimate;
+};
+
+/* Tolerances cover the error of both the fallback and the compared backend. Division is a
+   refined reciprocal estimate in fast math builds and the reciprocal square root estimate has
+   a relative error up to 1.5 * 2^-12 (see test/accuracy), doubled in reflections. Slerp of
+   nearly identical quaternions is ill conditioned and the backends may disagree on falling
+   back to linear interpolation */
+static const fuzz_function_spec_t _fuzz_function[FUZZ_FUNCTION_COUNT] = {
+	{ "vector_add", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_sub", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_mul", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_div", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 4, 4 },
+	{ "vector_neg", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_abs", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_min", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_max", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_muladd", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_MULADD, 1, 1 },
+	{ "vector_scale", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_lerp", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_AB, 4, 4 },
+	{ "vector_shuffle", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_shuffle_reverse", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_component", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_dot", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A_TIMES_B, 4, 4 },
+	{ "vector_dot3", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A_TIMES_B, 4, 4 },
+	{ "vector_cross3", 3, FUZZ_COMPARE_ULP, FUZZ_SCALE_A_TIMES_B, 2, 2 },
+	{ "vector_normalize", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 8, 8192 },
+	{ "vector_normalize3", 3, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 8, 8192 },
+	{ "vector_length", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 4, 4 },
+	{ "vector_length_fast", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 4, 8192 },
+	{ "vector_length_sqr", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A_SQUARED, 4, 4 },
+	{ "vector_length3", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 4, 4 },
+	{ "vector_length3_fast", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 4, 8192 },
+	{ "vector_length3_sqr", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A_SQUARED, 4, 4 },
+	{ "vector_project", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A, 16, 16384 },
+	{ "vector_project3", 3, FUZZ_COMPARE_ULP, FUZZ_SCALE_A, 16, 16384 },
+	{ "vector_reflect", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A, 32, 32768 },
+	{ "vector_reflect3", 3, FUZZ_COMPARE_ULP, FUZZ_SCALE_A, 32, 32768 },
+	{ "vector_cmplt", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_cmple", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_cmpeq", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_cmpneq", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_cmpgt", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_cmpge", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_and", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_or", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_xor", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_andnot", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_select", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_blend", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_movemask", 1, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_any_all", 1, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_equal_lanes", 1, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "vector_equal", 1, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "matrix_transpose", 16, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "matrix_add", 16, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "matrix_sub", 16, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "matrix_mul", 16, FUZZ_COMPARE_ULP, FUZZ_SCALE_MATRIX_MATRIX, 4, 4 },
+	{ "matrix_rotate", 3, FUZZ_COMPARE_ULP, FUZZ_SCALE_MATRIX_VECTOR, 4, 4 },
+	{ "matrix_transform", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_MATRIX_VECTOR, 4, 4 },
+	{ "quaternion_conjugate", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "quaternion_inverse", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 8, 8 },
+	{ "quaternion_neg", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "quaternion_add", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "quaternion_sub", 4, FUZZ_COMPARE_EXACT, FUZZ_SCALE_RESULT, 0, 0 },
+	{ "quaternion_normalize", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_RESULT, 8, 8192 },
+	{ "quaternion_mul", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_A_TIMES_B, 4, 4 },
+	{ "quaternion_slerp", 4, FUZZ_COMPARE_ULP, FUZZ_SCALE_ONE, 4096, 4096 },
+	{ "quaternion_rotate", 3, FUZZ_COMPARE_ULP, FUZZ_SCALE_A, 8, 8 }
+};
+
+static const char* const _fuzz_backend_name[VECTOR_TEST_BACKEND_COUNT] = {
+	"fallback", "SSE2", "SSE3", "SSE4"
+};
+
+/* Map raw bits to a float which is zero or has a magnitude in [2^-24, 2^25), keeping sign and
+   mantissa. Exponent field zero maps to a signed zero so the fuzzer easily reaches zeros */
+static float32_t
+fuzz_decode_real(uint32_t bits) {
+	const uint32_t exponent = (bits >> 23) & 0xFF;
+	float32_t value;
+	if (exponent)
+		bits = (bits & 0x807FFFFFU) | ((uint32_t)(127 - 24 + ((exponent - 1) % 49)) << 23);
+	else
+		bits &= 0x80000000U;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+//Normalized in double precision, zero length gives the identity quaternion
+static void
+fuzz_decode_quaternion(const float32_t* raw, float32_t* q) {
+	const double length = sqrt(((double)raw[0] * raw[0]) + ((double)raw[1] * raw[1]) +
+	                           ((double)raw[2] * raw[2]) + ((double)raw[3] * raw[3]));
+	unsigned int i;
+	for (i = 0; i < 4; ++i)
+		q[i] = (length > 0) ? (float32_t)(raw[i] / length) : ((i == 3) ? 1.0f : 0.0f);
+}
+
+void
+fuzz_decode(const uint8_t* data, size_t size, fuzz_input_t* input) {
+	uint32_t word[FUZZ_INPUT_SIZE / sizeof(uint32_t)];
+	float32_t raw[4];
+	size_t i;
+
+	memset(word, 0, sizeof(word));
+	memcpy(word, data, (size < sizeof(word)) ? size : sizeof(word));
+
+	for (i = 0; i < 4; ++i) {
+		input->a[i] = fuzz_decode_real(word[i]);
+		input->b[i] = fuzz_decode_real(word[4 + i]);
+		input->c[i] = fuzz_decode_real(word[8 + i]);
+	}
+	for (i = 0; i < 16; ++i) {
+		input->m0[i] = fuzz_decode_real(word[12 + i]);
+		input->m1[i] = fuzz_decode_real(word[28 + i]);
+	}
+	for (i = 0; i < 4; ++i)
+		raw[i] = fuzz_decode_real(word[44 + i]);
+	fuzz_decode_quaternion(raw, input->q0);
+	for (i = 0; i < 4; ++i)
+		raw[i] = fuzz_decode_real(word[48 + i]);
+	fuzz_decode_quaternion(raw, input->q1);
+	input->factor = (float32_t)(word[52] >> 8) / 16777216.0f;
+}
+
+static double
+fuzz_max_abs(const float32_t* v, unsigned int count) {
+	double max = 0;
+	unsigned int i;
+	for (i = 0; i < count; ++i)
+		max = (fabs(v[i]) > max) ? fabs(v[i]) : max;
+	return max;
+}
+
+static double
+fuzz_scale(const fuzz_input_t* input, fuzz_scale_t scale) {
+	const double a = fuzz_max_abs(input->a, 4);
+	const double b = fuzz_max_abs(input->b, 4);
+	switch (scale) {
+	case FUZZ_SCALE_ONE: return 1;
+	case FUZZ_SCALE_A: return a;
+	case FUZZ_SCALE_AB: return (a > b) ? a : b;
+	case FUZZ_SCALE_A_TIMES_B: return 4 * a * b;
+	case FUZZ_SCALE_A_SQUARED: return 4 * a * a;
+	case FUZZ_SCALE_MULADD: {
+		const double c = fuzz_max_abs(input->c, 4);
+		return ((a * b) > c) ? (a * b) : c;
+	}
+	case FUZZ_SCALE_MATRIX_VECTOR: return 4 * a * fuzz_max_abs(input->m0, 16);
+	case FUZZ_SCALE_MATRIX_MATRIX: return 4 * fuzz_max_abs(input->m0, 16) * fuzz_max_abs(input->m1, 16);
+	case FUZZ_SCALE_RESULT:
+	default:
+		break;
+	}
+	return 0;
+}
+
+//Spacing of single precision values at the magnitude of the given value
+static double
+fuzz_ulp(double value) {
+	int exponent;
+	value = fabs(value);
+	if (value < FLT_MIN)
+		return ldexp(1, FLT_MIN_EXP - FLT_MANT_DIG);
+	frexp(value, &exponent);
+	return ldexp(1, exponent - FLT_MANT_DIG);
+}
+
+//Bit test, fast math builds may fold isfinite to true
+static bool
+fuzz_is_finite(float32_t value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits & 0x7F800000U) != 0x7F800000U;
+}
+
+static double
+fuzz_limit(int backend, fuzz_function_t function) {
+#if !VECTOR_DETERMINISTIC
+	if (backend != VECTOR_TEST_BACKEND_FALLBACK)
+		return _fuzz_function[function].max_ulp_estimate;
+#else
+	FOUNDATION_UNUSED(backend);
+#endif
+	return _fuzz_function[function].max_ulp;
+}
+
+static size_t
+fuzz_compare(const fuzz_input_t* input, int backend, const float32_t* expected, const float32_t* actual,
+             fuzz_divergence_t* divergence, size_t capacity, size_t found) {
+	int ifunc;
+	unsigned int icomp;
+	for (ifunc = 0; ifunc < FUZZ_FUNCTION_COUNT; ++ifunc) {
+		const fuzz_function_spec_t* spec = &_fuzz_function[ifunc];
+		const float32_t* want = expected + (ifunc * FUZZ_RESULT_SIZE);
+		const float32_t* got = actual + (ifunc * FUZZ_RESULT_SIZE);
+		const double scale = fuzz_scale(input, spec->scale);
+		const double limit = fuzz_limit(backend, (fuzz_function_t)ifunc);
+		for (icomp = 0; icomp < spec->components; ++icomp) {
+			double ulp = 0;
+			bool diverged;
+			if (spec->compare == FUZZ_COMPARE_EXACT) {
+				diverged = (memcmp(want + icomp, got + icomp, sizeof(float32_t)) != 0) &&
+				           !((want[icomp] == 0) && (got[icomp] == 0));
+			}
+			else {
+				double magnitude = (fabs(want[icomp]) > fabs(got[icomp])) ? fabs(want[icomp]) : fabs(got[icomp]);
+				if (!fuzz_is_finite(want[icomp]))
+					continue;
+				if (scale > magnitude)
+					magnitude = scale;
+				diverged = !fuzz_is_finite(got[icomp]);
+				if (!diverged) {
+					ulp = fabs((double)got[icomp] - (double)want[icomp]) / fuzz_ulp(magnitude);
+					diverged = (ulp > limit);
+				}
+			}
+			if (!diverged)
+				continue;
+			if (found < capacity) {
+				fuzz_divergence_t* current = divergence + found;
+				current->function = (fuzz_function_t)ifunc;
+				current->backend = backend;
+				current->component = icomp;
+				current->expected = want[icomp];
+				current->actual = got[icomp];
+				current->ulp = ulp;
+				current->limit = limit;
+			}
+			++found;
+		}
+	}
+	return found;
+}
+
+size_t
+fuzz_check(const fuzz_input_t* input, fuzz_divergence_t* divergence, size_t capacity) {
+	float32_t expected[FUZZ_FUNCTION_COUNT * FUZZ_RESULT_SIZE];
+	float32_t actual[FUZZ_FUNCTION_COUNT * FUZZ_RESULT_SIZE];
+	size_t found = 0;
+
+	memset(expected, 0, sizeof(expected));
+	memset(actual, 0, sizeof(actual));
+	fuzz_evaluate_fallback(input, expected);
+	if (fuzz_evaluate_sse2(input, actual))
+		found = fuzz_compare(input, VECTOR_TEST_BACKEND_SSE2, expected, actual, divergence, capacity, found);
+	if (fuzz_evaluate_sse3(input, actual))
+		found = fuzz_compare(input, VECTOR_TEST_BACKEND_SSE3, expected, actual, divergence, capacity, found);
+	if (fuzz_evaluate_sse4(input, actual))
+		found = fuzz_compare(input, VECTOR_TEST_BACKEND_SSE4, expected, actual, divergence, capacity, found);
+	return found;
+}
+
+const char*
+fuzz_function_name(fuzz_function_t function) {
+	return ((int)function < FUZZ_FUNCTION_COUNT) ? _fuzz_function[function].name : "unknown";
+}
+
+const char*
+fuzz_backend_name(int backend) {
+	return ((backend >= 0) && (backend < VECTOR_TEST_BACKEND_COUNT)) ? _fuzz_backend_name[backend] : "unknown";
+}
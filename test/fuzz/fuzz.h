@@ -0,0 +1,160 @@
+/* fuzz.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/* Differential fuzzing of the backends. Raw fuzzer input bytes are decoded into function
+   arguments, every function is evaluated with each backend available in the build and the
+   SIMD results are compared against the fallback implementation. Shared by the deterministic
+   random driver in main.c and the libFuzzer/AFL entry point in fuzzer.c, so this code only
+   depends on foundation headers and not on an initialized foundation runtime. */
+
+#include <foundation/platform.h>
+#include <foundation/types.h>
+
+#include "../test/backend.h"
+
+typedef enum {
+	FUZZ_VECTOR_ADD = 0,
+	FUZZ_VECTOR_SUB,
+	FUZZ_VECTOR_MUL,
+	FUZZ_VECTOR_DIV,
+	FUZZ_VECTOR_NEG,
+	FUZZ_VECTOR_ABS,
+	FUZZ_VECTOR_MIN,
+	FUZZ_VECTOR_MAX,
+	FUZZ_VECTOR_MULADD,
+	FUZZ_VECTOR_SCALE,
+	FUZZ_VECTOR_LERP,
+	FUZZ_VECTOR_SHUFFLE,
+	FUZZ_VECTOR_SHUFFLE_REVERSE,
+	FUZZ_VECTOR_COMPONENT,
+	FUZZ_VECTOR_DOT,
+	FUZZ_VECTOR_DOT3,
+	FUZZ_VECTOR_CROSS3,
+	FUZZ_VECTOR_NORMALIZE,
+	FUZZ_VECTOR_NORMALIZE3,
+	FUZZ_VECTOR_LENGTH,
+	FUZZ_VECTOR_LENGTH_FAST,
+	FUZZ_VECTOR_LENGTH_SQR,
+	FUZZ_VECTOR_LENGTH3,
+	FUZZ_VECTOR_LENGTH3_FAST,
+	FUZZ_VECTOR_LENGTH3_SQR,
+	FUZZ_VECTOR_PROJECT,
+	FUZZ_VECTOR_PROJECT3,
+	FUZZ_VECTOR_REFLECT,
+	FUZZ_VECTOR_REFLECT3,
+	FUZZ_VECTOR_CMPLT,
+	FUZZ_VECTOR_CMPLE,
+	FUZZ_VECTOR_CMPEQ,
+	FUZZ_VECTOR_CMPNEQ,
+	FUZZ_VECTOR_CMPGT,
+	FUZZ_VECTOR_CMPGE,
+	FUZZ_VECTOR_AND,
+	FUZZ_VECTOR_OR,
+	FUZZ_VECTOR_XOR,
+	FUZZ_VECTOR_ANDNOT,
+	FUZZ_VECTOR_SELECT,
+	FUZZ_VECTOR_BLEND,
+	FUZZ_VECTOR_MOVEMASK,
+	FUZZ_VECTOR_ANY_ALL,
+	FUZZ_VECTOR_EQUAL_LANES,
+	FUZZ_VECTOR_EQUAL,
+	FUZZ_MATRIX_TRANSPOSE,
+	FUZZ_MATRIX_ADD,
+	FUZZ_MATRIX_SUB,
+	FUZZ_MATRIX_MUL,
+	FUZZ_MATRIX_ROTATE,
+	FUZZ_MATRIX_TRANSFORM,
+	FUZZ_QUATERNION_CONJUGATE,
+	FUZZ_QUATERNION_INVERSE,
+	FUZZ_QUATERNION_NEG,
+	FUZZ_QUATERNION_ADD,
+	FUZZ_QUATERNION_SUB,
+	FUZZ_QUATERNION_NORMALIZE,
+	FUZZ_QUATERNION_MUL,
+	FUZZ_QUATERNION_SLERP,
+	FUZZ_QUATERNION_ROTATE,
+	FUZZ_FUNCTION_COUNT
+} fuzz_function_t;
+
+//! Number of result components stored per function, enough for a matrix
+#define FUZZ_RESULT_SIZE 16
+
+//! Number of input bytes consumed by fuzz_decode, shorter inputs are padded with zero
+#define FUZZ_INPUT_SIZE (sizeof(float32_t) * 53)
+
+typedef struct fuzz_input_t fuzz_input_t;
+typedef struct fuzz_divergence_t fuzz_divergence_t;
+
+/*! Function arguments. Vector and matrix components are zero or have a magnitude in
+    [2^-24, 2^25) so squared lengths and products stay finite and normal, quaternions q0 and
+    q1 are unit length and factor is in [0, 1] */
+struct fuzz_input_t {
+	float32_t a[4];
+	float32_t b[4];
+	float32_t c[4];
+	float32_t m0[16];
+	float32_t m1[16];
+	float32_t q0[4];
+	float32_t q1[4];
+	float32_t factor;
+};
+
+//! Result of a SIMD backend outside the tolerance of the fallback result
+struct fuzz_divergence_t {
+	fuzz_function_t function;
+	int backend;
+	unsigned int component;
+	float32_t expected;
+	float32_t actual;
+	//Error in ULP, or zero for functions required to match exactly
+	double ulp;
+	double limit;
+};
+
+//! Decode raw fuzzer bytes into function arguments
+void
+fuzz_decode(const uint8_t* data, size_t size, fuzz_input_t* input);
+
+/*! Evaluate all functions with every available backend and compare against the fallback.
+    Stores up to capacity divergences and returns the total number found */
+size_t
+fuzz_check(const fuzz_input_t* input, fuzz_divergence_t* divergence, size_t capacity);
+
+//! Name of function
+const char*
+fuzz_function_name(fuzz_function_t function);
+
+//! Name of backend
+const char*
+fuzz_backend_name(int backend);
+
+/* Evaluate every function on the input with the given backend. The result of function f is
+   stored at result[f * FUZZ_RESULT_SIZE]. Returns false if the backend is not available in
+   this build, in which case the results are left untouched. */
+
+bool
+fuzz_evaluate_fallback(const fuzz_input_t* input, float32_t* result);
+
+bool
+fuzz_evaluate_sse2(const fuzz_input_t* input, float32_t* result);
+
+bool
+fuzz_evaluate_sse3(const fuzz_input_t* input, float32_t* result);
+
+bool
+fuzz_evaluate_sse4(const fuzz_input_t* input, float32_t* result);
@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+
+"""Build and run the differential backend fuzzer
+
+Builds fuzzer.c with all backends linked into one binary and runs it. By default the binary is
+built with clang and libFuzzer and run on the corpus directory, remaining arguments are passed
+to libFuzzer (for example -max_total_time=600). With --standalone the binary reads inputs from
+files or standard input, for AFL (use --cc afl-clang-fast) or replaying a crash file."""
+
+import sys
+import os
+import argparse
+import subprocess
+
+rootpath = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..'))
+basepath = os.path.join(rootpath, 'test', 'fuzz')
+
+sources = ['fuzzer.c', 'fuzz.c', 'fuzz_fallback.c', 'fuzz_sse2.c', 'fuzz_sse3.c', 'fuzz_sse4.c']
+
+def main():
+  parser = argparse.ArgumentParser(description = 'Build and run the differential backend fuzzer')
+  parser.add_argument('--cc', default = os.environ.get('CC', 'clang'), help = 'C compiler')
+  parser.add_argument('--foundation', default = os.path.join(rootpath, '..', 'foundation_lib'),
+                      help = 'Path to foundation library')
+  parser.add_argument('--standalone', action = 'store_true',
+                      help = 'Build with a main function reading input files instead of libFuzzer')
+  parser.add_argument('--deterministic', action = 'store_true',
+                      help = 'Build with VECTOR_DETERMINISTIC, tightening the tolerances')
+  parser.add_argument('--output', default = os.path.join(rootpath, 'bin', 'fuzz-vector'), help = 'Output binary')
+  parser.add_argument('--corpus', default = os.path.join(rootpath, 'bin', 'fuzz-corpus'), help = 'Corpus directory')
+  parser.add_argument('--build-only', action = 'store_true', help = 'Build without running')
+  options, arguments = parser.parse_known_args()
+
+  command = [options.cc, '-std=c11', '-O2', '-g', '-ffast-math', '-msse4.1', '-DBUILD_DEPLOY=1',
+             '-I' + rootpath, '-I' + os.path.join(rootpath, 'test'), '-I' + options.foundation]
+  if options.standalone:
+    command += ['-DFUZZ_STANDALONE=1']
+  else:
+    command += ['-fsanitize=fuzzer,address,undefined']
+  if options.deterministic:
+    command += ['-DVECTOR_DETERMINISTIC=1']
+  command += [os.path.join(basepath, source) for source in sources]
+  command += ['-lm', '-o', options.output]
+  if not os.path.isdir(os.path.dirname(options.output)):
+    os.makedirs(os.path.dirname(options.output))
+  subprocess.check_call(command)
+
+  if options.build_only:
+    return 0
+  if options.standalone:
+    return subprocess.call([options.output] + arguments)
+  if not os.path.isdir(options.corpus):
+    os.makedirs(options.corpus)
+  return subprocess.call([options.output, options.corpus] + arguments)
+
+if __name__ == '__main__':
+  sys.exit(main())
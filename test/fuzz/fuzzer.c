@@ -0,0 +1,89 @@
+/* fuzzer.c  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/* Coverage guided fuzzer entry point for the differential backend check in fuzz.c, aborting on
+   the first input where a SIMD backend diverges from the fallback. Build with clang and
+   libFuzzer using fuzz.py, or with FUZZ_STANDALONE defined for AFL style fuzzers and replaying
+   crash files, in which case the program checks each file given on the command line or the
+   standard input if none is given.
+
+   The entry point only uses the inlined vector functions and does not initialize the
+   foundation runtime, so it is built with BUILD_DEPLOY to disable asserts. */
+
+#include <foundation/foundation.h>
+
+#include "fuzz.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int
+LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+int
+LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	fuzz_divergence_t divergence[8];
+	fuzz_input_t input;
+	size_t idiv, count;
+
+	fuzz_decode(data, size, &input);
+	count = fuzz_check(&input, divergence, sizeof(divergence) / sizeof(divergence[0]));
+	if (!count)
+		return 0;
+
+	for (idiv = 0; (idiv < count) && (idiv < sizeof(divergence) / sizeof(divergence[0])); ++idiv) {
+		const fuzz_divergence_t* current = divergence + idiv;
+		fprintf(stderr, "%s: %s component %u is %.9g, fallback %.9g (%.2f ulp, limit %.2f)\n",
+		        fuzz_backend_name(current->backend), fuzz_function_name(current->function),
+		        current->component, (double)current->actual, (double)current->expected,
+		        current->ulp, current->limit);
+	}
+	fprintf(stderr, "a = [%.9g %.9g %.9g %.9g] b = [%.9g %.9g %.9g %.9g] factor %.9g\n",
+	        (double)input.a[0], (double)input.a[1], (double)input.a[2], (double)input.a[3],
+	        (double)input.b[0], (double)input.b[1], (double)input.b[2], (double)input.b[3],
+	        (double)input.factor);
+	abort();
+}
+
+#if FUZZ_STANDALONE
+
+static void
+fuzz_file(FILE* file) {
+	uint8_t data[FUZZ_INPUT_SIZE];
+	const size_t size = fread(data, 1, sizeof(data), file);
+	LLVMFuzzerTestOneInput(data, size);
+}
+
+int
+main(int argc, char** argv) {
+	int iarg;
+	if (argc < 2) {
+		fuzz_file(stdin);
+		return 0;
+	}
+	for (iarg = 1; iarg < argc; ++iarg) {
+		FILE* file = fopen(argv[iarg], "rb");
+		if (!file) {
+			fprintf(stderr, "Unable to open %s\n", argv[iarg]);
+			return 1;
+		}
+		fuzz_file(file);
+		fclose(file);
+	}
+	return 0;
+}
+
+#endif
@@ -0,0 +1,143 @@
+/* kernel.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/* Shared evaluation kernel, included once by each backend translation unit after selecting the
+   backend with test/backend.h and including vector.h */
+
+#include "fuzz.h"
+
+#if VECTOR_TEST_BACKEND_AVAILABLE
+
+//Stores raw bits so comparison masks survive
+static void
+fuzz_store(float32_t* dst, const vector_t v) {
+	memcpy(dst, &v, sizeof(float32_t) * 4);
+}
+
+static void
+fuzz_store_matrix(float32_t* dst, const matrix_t m) {
+	memcpy(dst, m.arr, sizeof(float32_t) * 16);
+}
+
+static void
+fuzz_store_uint(float32_t* dst, const unsigned int value) {
+	dst[0] = (float32_t)value;
+}
+
+#define FUZZ_EVALUATE(function, store, expr) \
+	store(result + (function * FUZZ_RESULT_SIZE), expr)
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(fuzz_evaluate)(const fuzz_input_t* input, float32_t* result) {
+	const vector_t a = vector_unaligned(input->a);
+	const vector_t b = vector_unaligned(input->b);
+	const vector_t c = vector_unaligned(input->c);
+	const matrix_t m0 = matrix_unaligned(input->m0);
+	const matrix_t m1 = matrix_unaligned(input->m1);
+	const quaternion_t q0 = quaternion_unaligned(input->q0);
+	const quaternion_t q1 = quaternion_unaligned(input->q1);
+	const real factor = input->factor;
+	//Comparison tolerances of the equality functions are driven by the factor
+	const int ulps = (int)(factor * 64.0f);
+	const vector_t mask = vector_cmplt(a, b);
+
+	FUZZ_EVALUATE(FUZZ_VECTOR_ADD, fuzz_store, vector_add(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_SUB, fuzz_store, vector_sub(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_MUL, fuzz_store, vector_mul(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_DIV, fuzz_store, vector_div(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_NEG, fuzz_store, vector_neg(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_ABS, fuzz_store, vector_abs(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_MIN, fuzz_store, vector_min(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_MAX, fuzz_store, vector_max(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_MULADD, fuzz_store, vector_muladd(a, b, c));
+	FUZZ_EVALUATE(FUZZ_VECTOR_SCALE, fuzz_store, vector_scale(a, factor));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LERP, fuzz_store, vector_lerp(a, b, factor));
+	FUZZ_EVALUATE(FUZZ_VECTOR_SHUFFLE, fuzz_store, vector_shuffle(a, VECTOR_MASK_YZXW));
+	FUZZ_EVALUATE(FUZZ_VECTOR_SHUFFLE_REVERSE, fuzz_store, vector_shuffle(a, VECTOR_MASK_WZYX));
+	FUZZ_EVALUATE(FUZZ_VECTOR_COMPONENT, fuzz_store,
+	              vector(vector_x(a), vector_y(a), vector_z(a), vector_component(a, (int)(factor * 3.99f))));
+	FUZZ_EVALUATE(FUZZ_VECTOR_DOT, fuzz_store, vector_dot(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_DOT3, fuzz_store, vector_dot3(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_CROSS3, fuzz_store, vector_cross3(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_NORMALIZE, fuzz_store, vector_normalize(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_NORMALIZE3, fuzz_store, vector_normalize3(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LENGTH, fuzz_store, vector_length(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LENGTH_FAST, fuzz_store, vector_length_fast(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LENGTH_SQR, fuzz_store, vector_length_sqr(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LENGTH3, fuzz_store, vector_length3(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LENGTH3_FAST, fuzz_store, vector_length3_fast(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_LENGTH3_SQR, fuzz_store, vector_length3_sqr(a));
+	FUZZ_EVALUATE(FUZZ_VECTOR_PROJECT, fuzz_store, vector_project(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_PROJECT3, fuzz_store, vector_project3(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_REFLECT, fuzz_store, vector_reflect(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_REFLECT3, fuzz_store, vector_reflect3(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_CMPLT, fuzz_store, mask);
+	FUZZ_EVALUATE(FUZZ_VECTOR_CMPLE, fuzz_store, vector_cmple(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_CMPEQ, fuzz_store, vector_cmpeq(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_CMPNEQ, fuzz_store, vector_cmpneq(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_CMPGT, fuzz_store, vector_cmpgt(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_CMPGE, fuzz_store, vector_cmpge(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_AND, fuzz_store, vector_and(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_OR, fuzz_store, vector_or(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_XOR, fuzz_store, vector_xor(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_ANDNOT, fuzz_store, vector_andnot(a, b));
+	FUZZ_EVALUATE(FUZZ_VECTOR_SELECT, fuzz_store, vector_select(mask, a, c));
+	FUZZ_EVALUATE(FUZZ_VECTOR_BLEND, fuzz_store, vector_blend(a, b, VECTOR_BLEND_0110));
+	FUZZ_EVALUATE(FUZZ_VECTOR_MOVEMASK, fuzz_store_uint, vector_movemask(a) | (vector_movemask(mask) << 4));
+	FUZZ_EVALUATE(FUZZ_VECTOR_ANY_ALL, fuzz_store_uint,
+	              (vector_any(mask) ? 1U : 0) | (vector_all(mask) ? 2U : 0) |
+	              (vector_any(vector_cmpeq(a, b)) ? 4U : 0) | (vector_all(vector_cmpge(a, c)) ? 8U : 0));
+	FUZZ_EVALUATE(FUZZ_VECTOR_EQUAL_LANES, fuzz_store_uint,
+	              vector_equal_exact_lanes(a, b) | (vector_equal_abs_lanes(a, b, factor) << 4) |
+	              (vector_equal_rel_lanes(a, b, factor * REAL_C(0.001)) << 8) |
+	              (vector_equal_ulps_lanes(a, b, ulps) << 12));
+	FUZZ_EVALUATE(FUZZ_VECTOR_EQUAL, fuzz_store_uint,
+	              (vector_equal(a, b) ? 1U : 0) | (vector_equal_exact(a, b) ? 2U : 0) |
+	              (vector_equal_abs(a, b, factor) ? 4U : 0) | (vector_equal_rel(a, b, factor * REAL_C(0.001)) ? 8U : 0) |
+	              (vector_equal_ulps(a, b, ulps) ? 16U : 0));
+
+	FUZZ_EVALUATE(FUZZ_MATRIX_TRANSPOSE, fuzz_store_matrix, matrix_transpose(m0));
+	FUZZ_EVALUATE(FUZZ_MATRIX_ADD, fuzz_store_matrix, matrix_add(m0, m1));
+	FUZZ_EVALUATE(FUZZ_MATRIX_SUB, fuzz_store_matrix, matrix_sub(m0, m1));
+	FUZZ_EVALUATE(FUZZ_MATRIX_MUL, fuzz_store_matrix, matrix_mul(m0, m1));
+	FUZZ_EVALUATE(FUZZ_MATRIX_ROTATE, fuzz_store, matrix_rotate(m0, a));
+	FUZZ_EVALUATE(FUZZ_MATRIX_TRANSFORM, fuzz_store, matrix_transform(m0, a));
+
+	FUZZ_EVALUATE(FUZZ_QUATERNION_CONJUGATE, fuzz_store, quaternion_conjugate(a));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_INVERSE, fuzz_store, quaternion_inverse(a));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_NEG, fuzz_store, quaternion_neg(a));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_ADD, fuzz_store, quaternion_add(a, b));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_SUB, fuzz_store, quaternion_sub(a, b));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_NORMALIZE, fuzz_store, quaternion_normalize(a));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_MUL, fuzz_store, quaternion_mul(a, b));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_SLERP, fuzz_store, quaternion_slerp(q0, q1, factor));
+	FUZZ_EVALUATE(FUZZ_QUATERNION_ROTATE, fuzz_store, quaternion_rotate(q0, a));
+
+	return true;
+}
+
+#undef FUZZ_EVALUATE
+
+#else
+
+bool
+VECTOR_TEST_BACKEND_SYMBOL(fuzz_evaluate)(const fuzz_input_t* input, float32_t* result) {
+	FOUNDATION_UNUSED(input);
+	FOUNDATION_UNUSED(result);
+	return false;
+}
+
+#endif
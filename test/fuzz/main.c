@@ -0,0 +1,188 @@
+/* main.c  -  Fuzz tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+#include <vector/vector.h>
+
+#include "fuzz.h"
+
+/* Deterministic random driver for the differential fuzzer, for builds and environments without
+   a coverage guided fuzzer. Random byte buffers are decoded like fuzzer input, with a share of
+   the buffers reusing the first argument for the second so equal, opposite and nearly equal
+   arguments are covered. See fuzzer.c for the libFuzzer and AFL entry point. */
+
+//Number of random inputs checked
+#define FUZZ_RANDOM_COUNT 50000
+
+//Number of divergences logged
+#define FUZZ_REPORT_MAX 16
+
+static uint32_t
+fuzz_random(uint32_t* state) {
+	*state = (*state * 1664525U) + 1013904223U;
+	return *state;
+}
+
+static void
+fuzz_random_data(uint32_t* state, uint32_t* word, size_t count) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		word[i] = fuzz_random(state);
+	//Second argument relative to the first, equal, opposite or differing in the lowest bits
+	switch (fuzz_random(state) % 8) {
+	case 0: memcpy(word + 4, word, sizeof(uint32_t) * 4); break;
+	case 1: for (i = 0; i < 4; ++i) word[4 + i] = word[i] ^ 0x80000000U; break;
+	case 2: for (i = 0; i < 4; ++i) word[4 + i] = word[i] ^ (fuzz_random(state) & 0x7U); break;
+	case 3: for (i = 0; i < 4; ++i) word[48 + i] = word[44 + i] ^ (fuzz_random(state) & 0xFFU); break;
+	default: break;
+	}
+}
+
+DECLARE_TEST(fuzz, decode) {
+	uint32_t word[FUZZ_INPUT_SIZE / sizeof(uint32_t)];
+	uint32_t state = 0xDEC0DEU;
+	fuzz_input_t input;
+	size_t i, iloop;
+
+	fuzz_decode(0, 0, &input);
+	EXPECT_REALEQ(input.a[0], 0);
+	EXPECT_REALEQ(input.m1[15], 0);
+	EXPECT_REALEQ(input.q0[3], 1);
+	EXPECT_REALEQ(input.q1[0], 0);
+	EXPECT_REALEQ(input.factor, 0);
+
+	for (iloop = 0; iloop < 1000; ++iloop) {
+		float32_t length = 0;
+		fuzz_random_data(&state, word, sizeof(word) / sizeof(word[0]));
+		fuzz_decode((const uint8_t*)word, sizeof(word), &input);
+		for (i = 0; i < 4; ++i) {
+			const float32_t magnitude = math_abs(input.a[i]);
+			EXPECT_TRUE((magnitude == 0) || ((magnitude >= 0x1p-24f) && (magnitude < 0x1p25f)));
+			length += input.q0[i] * input.q0[i];
+		}
+		EXPECT_REALLT(math_abs(length - 1), REAL_C(1e-5));
+		EXPECT_TRUE((input.factor >= 0) && (input.factor < 1));
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(fuzz, random) {
+	uint32_t word[FUZZ_INPUT_SIZE / sizeof(uint32_t)];
+	fuzz_divergence_t divergence[FUZZ_REPORT_MAX];
+	uint32_t state = 0xF022U;
+	fuzz_input_t input;
+	size_t i, found = 0;
+
+	for (i = 0; i < FUZZ_RANDOM_COUNT; ++i) {
+		size_t idiv, count;
+		fuzz_random_data(&state, word, sizeof(word) / sizeof(word[0]));
+		fuzz_decode((const uint8_t*)word, sizeof(word), &input);
+		count = fuzz_check(&input, divergence, FUZZ_REPORT_MAX);
+		for (idiv = 0; (idiv < count) && (found + idiv < FUZZ_REPORT_MAX); ++idiv) {
+			const fuzz_divergence_t* current = divergence + idiv;
+			log_warnf(HASH_TEST, WARNING_SUSPICIOUS,
+			          STRING_CONST("%s: %s component %u is %.9g, fallback %.9g (%.2f ulp, limit %.2f) at input %" PRIsize),
+			          fuzz_backend_name(current->backend), fuzz_function_name(current->function),
+			          current->component, (double)current->actual, (double)current->expected,
+			          current->ulp, current->limit, i);
+		}
+		found += count;
+	}
+
+	EXPECT_SIZEEQ(found, 0);
+
+	return 0;
+}
+
+static application_t
+test_fuzz_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Fuzz tests"));
+	app.short_name = string_const(STRING_CONST("test_fuzz"));
+	app.company = string_const(STRING_CONST("Rampant Pixels"));
+	app.version = vector_module_version();
+	app.exception_handler = test_exception_handler;
+	app.flags = APPLICATION_UTILITY;
+	return app;
+}
+
+static memory_system_t
+test_fuzz_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_fuzz_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_fuzz_initialize(void) {
+	vector_config_t config;
+	memset(&config, 0, sizeof(config));
+	return vector_module_initialize(config);
+}
+
+static void
+test_fuzz_finalize(void) {
+	vector_module_finalize();
+}
+
+static void
+test_fuzz_declare(void) {
+	ADD_TEST(fuzz, decode);
+	ADD_TEST(fuzz, random);
+}
+
+static test_suite_t test_fuzz_suite = {
+	test_fuzz_application,
+	test_fuzz_memory_system,
+	test_fuzz_config,
+	test_fuzz_declare,
+	test_fuzz_initialize,
+	test_fuzz_finalize,
+	0
+};
+
+
+#if BUILD_MONOLITHIC
+
+int
+test_fuzz_run(void);
+
+int
+test_fuzz_run(void) {
+	test_suite = test_fuzz_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_fuzz_suite;
+}
+
+#endif
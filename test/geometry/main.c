@@ -0,0 +1,1503 @@
+/* main.c  -  Geometry tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+#include <vector/vector.h>
+
+#include "../test/vector.h"
+
+static application_t
+test_geometry_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Geometry tests"));
+	app.short_name = string_const(STRING_CONST("test_geometry"));
+	app.company = string_const(STRING_CONST("Rampant Pixels"));
+	app.version = vector_module_version();
+	app.exception_handler = test_exception_handler;
+	app.flags = APPLICATION_UTILITY;
+	return app;
+}
+
+static memory_system_t
+test_geometry_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_geometry_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_geometry_initialize(void) {
+	vector_config_t config;
+	memset(&config, 0, sizeof(config));
+	return vector_module_initialize(config);
+}
+
+static void
+test_geometry_finalize(void) {
+	vector_module_finalize();
+}
+
+//Deterministic pseudo-random values in [low, high]
+static uint32_t _geometry_random_state = 1;
+
+static real
+geometry_random(real low, real high) {
+	_geometry_random_state = _geometry_random_state * 1664525U + 1013904223U;
+	return low + (high - low) * ((real)(_geometry_random_state >> 8) / (real)(1U << 24));
+}
+
+static vector_t
+geometry_random_point(real low, real high) {
+	return vector(geometry_random(low, high), geometry_random(low, high), geometry_random(low, high), 1);
+}
+
+static matrix_t
+geometry_random_transform(void) {
+	const quaternion_t q = quaternion_normalize(vector(geometry_random(-1, 1), geometry_random(-1, 1),
+	                                                   geometry_random(-1, 1), geometry_random(-1, 1)));
+	const real x = vector_x(q), y = vector_y(q), z = vector_z(q), w = vector_w(q);
+	const real scale = geometry_random(REAL_C(0.5), 2);
+	matrix_t m;
+	m.row[0] = vector_scale(vector(1 - 2 * (y * y + z * z), 2 * (x * y + w * z), 2 * (x * z - w * y), 0), scale);
+	m.row[1] = vector_scale(vector(2 * (x * y - w * z), 1 - 2 * (x * x + z * z), 2 * (y * z + w * x), 0), scale);
+	m.row[2] = vector_scale(vector(2 * (x * z + w * y), 2 * (y * z - w * x), 1 - 2 * (x * x + y * y), 0), scale);
+	m.row[3] = geometry_random_point(-100, 100);
+	return m;
+}
+
+//Reference bounds of the eight transformed corners
+static aabb_t
+geometry_transform_corners(const aabb_t box, const matrix_t m) {
+	aabb_t bounds = aabb_empty();
+	int corner;
+	for (corner = 0; corner < 8; ++corner) {
+		const vector_t point = vector((corner & 1) ? vector_x(box.max) : vector_x(box.min),
+		                              (corner & 2) ? vector_y(box.max) : vector_y(box.min),
+		                              (corner & 4) ? vector_z(box.max) : vector_z(box.min), 1);
+		bounds = aabb_include(bounds, matrix_transform(m, point));
+	}
+	return bounds;
+}
+
+DECLARE_TEST(geometry, aabb) {
+	aabb_t box = aabb(vector(-1, -2, -3, 1), vector(1, 2, 3, 1));
+	EXPECT_VECTOREQ(aabb_center(box), vector(0, 0, 0, 1));
+	EXPECT_VECTOREQ(aabb_extent(box), vector(1, 2, 3, 0));
+	EXPECT_FALSE(aabb_is_empty(box));
+	EXPECT_TRUE(aabb_is_empty(aabb_empty()));
+
+	box = aabb_from_center(vector(1, 1, 1, 1), vector(1, 2, 3, 0));
+	EXPECT_VECTOREQ(box.min, vector(0, -1, -2, 1));
+	EXPECT_VECTOREQ(box.max, vector(2, 3, 4, 1));
+
+	box = aabb_union(aabb_empty(), aabb(vector(0, 0, 0, 1), vector(1, 1, 1, 1)));
+	box = aabb_union(box, aabb(vector(-1, 2, 0, 1), vector(0, 3, 1, 1)));
+	EXPECT_VECTOREQ(box.min, vector(-1, 0, 0, 1));
+	EXPECT_VECTOREQ(box.max, vector(1, 3, 1, 1));
+
+	box = aabb_include(box, vector(5, -5, 0, 1));
+	EXPECT_VECTOREQ(box.min, vector(-1, -5, 0, 1));
+	EXPECT_VECTOREQ(box.max, vector(5, 3, 1, 1));
+
+	box = aabb_expand(box, vector(1, 2, 3, 0));
+	EXPECT_VECTOREQ(box.min, vector(-2, -7, -3, 1));
+	EXPECT_VECTOREQ(box.max, vector(6, 5, 4, 1));
+
+	box = aabb_intersect(aabb(vector(0, 0, 0, 1), vector(2, 2, 2, 1)), aabb(vector(1, -1, 1, 1), vector(3, 1, 3, 1)));
+	EXPECT_FALSE(aabb_is_empty(box));
+	EXPECT_VECTOREQ(box.min, vector(1, 0, 1, 1));
+	EXPECT_VECTOREQ(box.max, vector(2, 1, 2, 1));
+	EXPECT_TRUE(aabb_is_empty(aabb_intersect(aabb(vector(0, 0, 0, 1), vector(1, 1, 1, 1)),
+	                                         aabb(vector(0, 2, 0, 1), vector(1, 3, 1, 1)))));
+
+	box = aabb(vector(0, 0, 0, 1), vector(2, 2, 2, 1));
+	EXPECT_TRUE(aabb_contains_point(box, vector(1, 1, 1, 1)));
+	EXPECT_TRUE(aabb_contains_point(box, vector(2, 0, 2, 1)));
+	EXPECT_TRUE(aabb_contains_point(box, vector(1, 1, 1, 100)));
+	EXPECT_FALSE(aabb_contains_point(box, vector(1, 1, 2.5f, 1)));
+	EXPECT_FALSE(aabb_contains_point(box, vector(-0.5f, 1, 1, 1)));
+
+	EXPECT_TRUE(aabb_contains(box, aabb(vector(0, 1, 1, 1), vector(2, 2, 1.5f, 1))));
+	EXPECT_FALSE(aabb_contains(box, aabb(vector(0, 1, 1, 1), vector(2, 2.5f, 1.5f, 1))));
+
+	EXPECT_TRUE(aabb_overlap(box, aabb(vector(1, 1, 1, 1), vector(3, 3, 3, 1))));
+	EXPECT_TRUE(aabb_overlap(box, aabb(vector(2, 2, 2, 1), vector(3, 3, 3, 1))));
+	EXPECT_FALSE(aabb_overlap(box, aabb(vector(1, 1, 2.5f, 1), vector(3, 3, 3, 1))));
+	EXPECT_FALSE(aabb_overlap(box, aabb(vector(-3, 1, 1, 1), vector(-1, 3, 3, 1))));
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, aabb_transform) {
+	matrix_t m = matrix_identity();
+	aabb_t box = aabb(vector(1, 2, 3, 1), vector(2, 4, 6, 1));
+	aabb_t transformed;
+	int iloop;
+
+	//Rotation by 90 degrees around z and translation
+	m.row[0] = vector(0, 1, 0, 0);
+	m.row[1] = vector(-1, 0, 0, 0);
+	m.row[3] = vector(10, 20, 30, 1);
+	transformed = aabb_transform(box, m);
+	EXPECT_VECTOREQ(transformed.min, vector(6, 21, 33, 1));
+	EXPECT_VECTOREQ(transformed.max, vector(8, 22, 36, 1));
+
+	for (iloop = 0; iloop < 64; ++iloop) {
+		const vector_t center = geometry_random_point(-10, 10);
+		const vector_t extent = vector(geometry_random(0, 5), geometry_random(0, 5), geometry_random(0, 5), 0);
+		aabb_t reference;
+		box = aabb_from_center(center, extent);
+		m = geometry_random_transform();
+		transformed = aabb_transform(box, m);
+		reference = geometry_transform_corners(box, m);
+		EXPECT_VECTORALMOSTEQ(transformed.min, reference.min);
+		EXPECT_VECTORALMOSTEQ(transformed.max, reference.max);
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, aabb_array) {
+	vector_t points[37];
+	aabb_t boxes[37];
+	aabb_t result[37];
+	matrix_t transforms[37];
+	aabb_t bounds;
+	vector_t min = vector_uniform(REAL_MAX);
+	vector_t max = vector_uniform(-REAL_MAX);
+	size_t i;
+
+	for (i = 0; i < 37; ++i) {
+		points[i] = geometry_random_point(-100, 100);
+		min = vector_min(min, points[i]);
+		max = vector_max(max, points[i]);
+		boxes[i] = aabb_from_center(points[i], vector(geometry_random(0, 5), geometry_random(0, 5),
+		                                              geometry_random(0, 5), 0));
+		transforms[i] = geometry_random_transform();
+	}
+	bounds = aabb_from_points(points, 0);
+	EXPECT_TRUE(aabb_is_empty(bounds));
+	bounds = aabb_array_union(boxes, 0);
+	EXPECT_TRUE(aabb_is_empty(bounds));
+	bounds = aabb_from_points(points, 37);
+	EXPECT_VECTOREQ(bounds.min, min);
+	EXPECT_VECTOREQ(bounds.max, max);
+	bounds = aabb_from_points(points, 36);
+	EXPECT_TRUE(aabb_contains_point(bounds, points[35]));
+
+	bounds = aabb_array_union(boxes, 37);
+	for (i = 0; i < 37; ++i)
+		EXPECT_TRUE(aabb_contains(bounds, boxes[i]));
+
+	aabb_array_transform_each(result, boxes, transforms, 37);
+	for (i = 0; i < 37; ++i) {
+		const aabb_t expect = aabb_transform(boxes[i], transforms[i]);
+		EXPECT_VECTOREQ(result[i].min, expect.min);
+		EXPECT_VECTOREQ(result[i].max, expect.max);
+	}
+
+	aabb_array_transform(result, boxes, 37, transforms);
+	for (i = 0; i < 37; ++i) {
+		const aabb_t expect = aabb_transform(boxes[i], transforms[0]);
+		EXPECT_VECTOREQ(result[i].min, expect.min);
+		EXPECT_VECTOREQ(result[i].max, expect.max);
+	}
+
+	memcpy(result, boxes, sizeof(boxes));
+	aabb_array_expand(result, result, 37, vector(1, 2, 3, 0));
+	for (i = 0; i < 37; ++i) {
+		EXPECT_VECTOREQ(result[i].min, vector_sub(boxes[i].min, vector(1, 2, 3, 0)));
+		EXPECT_VECTOREQ(result[i].max, vector_add(boxes[i].max, vector(1, 2, 3, 0)));
+	}
+
+	return 0;
+}
+
+//Right-handed perspective projection looking down -z, row vector convention
+static matrix_t
+geometry_perspective(real fov, real aspect, real znear, real zfar, bool depth_zero_to_one) {
+	const real f = REAL_C(1.0) / math_tan(fov * REAL_C(0.5));
+	matrix_t m = matrix_zero();
+	m.frow[0][0] = f / aspect;
+	m.frow[1][1] = f;
+	m.frow[2][3] = -1;
+	if (depth_zero_to_one) {
+		m.frow[2][2] = zfar / (znear - zfar);
+		m.frow[3][2] = (znear * zfar) / (znear - zfar);
+	}
+	else {
+		m.frow[2][2] = (znear + zfar) / (znear - zfar);
+		m.frow[3][2] = (2 * znear * zfar) / (znear - zfar);
+	}
+	return m;
+}
+
+//Reference test, box is outside if all corners are outside the same plane
+static bool
+geometry_frustum_test_corners(const frustum_t* frustum, const aabb_t box) {
+	unsigned int ip;
+	int corner;
+	for (ip = 0; ip < 6; ++ip) {
+		const vector_t plane = frustum_plane(frustum, ip);
+		bool outside = true;
+		for (corner = 0; corner < 8; ++corner) {
+			const vector_t point = vector((corner & 1) ? vector_x(box.max) : vector_x(box.min),
+			                              (corner & 2) ? vector_y(box.max) : vector_y(box.min),
+			                              (corner & 4) ? vector_z(box.max) : vector_z(box.min), 1);
+			if (vector_x(vector_dot(plane, point)) >= 0)
+				outside = false;
+		}
+		if (outside)
+			return false;
+	}
+	return true;
+}
+
+DECLARE_TEST(geometry, frustum) {
+	frustum_t frustum = frustum_from_matrix(geometry_perspective(REAL_HALFPI, 1, 1, 100, false), false);
+	const real diagonal = REAL_C(0.70710678);
+
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 0), vector(diagonal, 0, -diagonal, 0));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 1), vector(-diagonal, 0, -diagonal, 0));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 2), vector(0, diagonal, -diagonal, 0));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 3), vector(0, -diagonal, -diagonal, 0));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 4), vector(0, 0, -1, -1));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 5), vector(0, 0, 1, 100));
+
+	EXPECT_TRUE(frustum_test_sphere(&frustum, vector(0, 0, -2, 0)));
+	EXPECT_FALSE(frustum_test_sphere(&frustum, vector(0, 0, REAL_C(-0.5), 0)));
+	EXPECT_FALSE(frustum_test_sphere(&frustum, vector(0, 0, -150, 0)));
+	EXPECT_FALSE(frustum_test_sphere(&frustum, vector(3, 0, -2, REAL_C(0.5))));
+	EXPECT_TRUE(frustum_test_sphere(&frustum, vector(3, 0, -2, 1)));
+	EXPECT_TRUE(frustum_test_sphere(&frustum, vector(0, 0, -150, 51)));
+	EXPECT_FALSE(frustum_test_sphere(&frustum, vector(0, 5, -2, 2)));
+
+	EXPECT_TRUE(frustum_test_aabb(&frustum, aabb(vector(-1, -1, -3, 1), vector(1, 1, -2, 1))));
+	EXPECT_TRUE(frustum_test_aabb(&frustum, aabb(vector(-10, -10, -200, 1), vector(10, 10, 200, 1))));
+	EXPECT_FALSE(frustum_test_aabb(&frustum, aabb(vector(3, -1, -2.5f, 1), vector(4, 1, -1.5f, 1))));
+	EXPECT_FALSE(frustum_test_aabb(&frustum, aabb(vector(-1, -1, 1, 1), vector(1, 1, 2, 1))));
+
+	//Same planes from a [0, w] depth range projection
+	frustum = frustum_from_matrix(geometry_perspective(REAL_HALFPI, 1, 1, 100, true), true);
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 0), vector(diagonal, 0, -diagonal, 0));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 4), vector(0, 0, -1, -1));
+	EXPECT_VECTORALMOSTEQ(frustum_plane(&frustum, 5), vector(0, 0, 1, 100));
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, frustum_cull) {
+	vector_t spheres[203];
+	aabb_t boxes[203];
+	uint32_t visible[203];
+	matrix_t view = matrix_identity();
+	frustum_t frustum;
+	size_t num_visible, expected;
+	size_t i;
+
+	view.row[3] = vector(-5, 2, -20, 1);
+	frustum = frustum_from_matrix(matrix_mul(view, geometry_perspective(REAL_C(1.2), REAL_C(1.5), REAL_C(0.5),
+	                                                                    80, false)), false);
+
+	for (i = 0; i < 203; ++i) {
+		const vector_t center = geometry_random_point(-60, 60);
+		spheres[i] = vector(vector_x(center), vector_y(center), vector_z(center), geometry_random(0, 10));
+		boxes[i] = aabb_from_center(center, vector(geometry_random(0, 10), geometry_random(0, 10),
+		                                           geometry_random(0, 10), 0));
+	}
+
+	num_visible = frustum_cull_spheres(visible, &frustum, spheres, 203);
+	for (i = 0, expected = 0; i < 203; ++i) {
+		if (frustum_test_sphere(&frustum, spheres[i])) {
+			EXPECT_TRUE(expected < num_visible);
+			EXPECT_UINTEQ(visible[expected], (uint32_t)i);
+			++expected;
+		}
+	}
+	EXPECT_SIZEEQ(num_visible, expected);
+	EXPECT_SIZENE(num_visible, 0);
+	EXPECT_SIZENE(num_visible, 203);
+
+	num_visible = frustum_cull_aabbs(visible, &frustum, boxes, 203);
+	for (i = 0, expected = 0; i < 203; ++i) {
+		EXPECT_EQ(frustum_test_aabb(&frustum, boxes[i]), geometry_frustum_test_corners(&frustum, boxes[i]));
+		if (frustum_test_aabb(&frustum, boxes[i])) {
+			EXPECT_TRUE(expected < num_visible);
+			EXPECT_UINTEQ(visible[expected], (uint32_t)i);
+			++expected;
+		}
+	}
+	EXPECT_SIZEEQ(num_visible, expected);
+	EXPECT_SIZENE(num_visible, 0);
+	EXPECT_SIZENE(num_visible, 203);
+
+	EXPECT_SIZEEQ(frustum_cull_spheres(visible, &frustum, spheres, 0), 0);
+	EXPECT_SIZEEQ(frustum_cull_aabbs(visible, &frustum, boxes, 0), 0);
+
+	return 0;
+}
+
+static triangle_t
+geometry_random_triangle(real low, real high, real size) {
+	triangle_t triangle;
+	triangle.v[0] = geometry_random_point(low, high);
+	triangle.v[1] = vector_add(triangle.v[0], vector(geometry_random(-size, size), geometry_random(-size, size),
+	                                                 geometry_random(-size, size), 0));
+	triangle.v[2] = vector_add(triangle.v[0], vector(geometry_random(-size, size), geometry_random(-size, size),
+	                                                 geometry_random(-size, size), 0));
+	return triangle;
+}
+
+static ray_t
+geometry_random_ray(void) {
+	const vector_t origin = geometry_random_point(-20, 20);
+	const vector_t target = geometry_random_point(-5, 5);
+	return ray(origin, vector_sub(target, origin));
+}
+
+DECLARE_TEST(geometry, ray_triangle) {
+	triangle_t triangle;
+	ray_hit_t hit;
+
+	triangle.v[0] = vector(0, 0, 0, 1);
+	triangle.v[1] = vector(1, 0, 0, 1);
+	triangle.v[2] = vector(0, 1, 0, 1);
+
+	hit.t = REAL_MAX;
+	hit.index = 7;
+	EXPECT_TRUE(ray_intersect_triangle(&hit, ray(vector(0.25f, 0.5f, 2, 1), vector(0, 0, -2, 0)), &triangle));
+	EXPECT_REALEQ(hit.t, 1);
+	EXPECT_REALEQ(hit.u, 0.25f);
+	EXPECT_REALEQ(hit.v, 0.5f);
+	EXPECT_UINTEQ(hit.index, 7);
+	EXPECT_VECTOREQ(ray_point(ray(vector(0.25f, 0.5f, 2, 1), vector(0, 0, -2, 0)), hit.t), vector(0.25f, 0.5f, 0, 1));
+
+	//Two-sided, closer hits only
+	hit.t = REAL_MAX;
+	EXPECT_TRUE(ray_intersect_triangle(&hit, ray(vector(0.25f, 0.25f, -1, 1), vector(0, 0, 1, 0)), &triangle));
+	EXPECT_REALEQ(hit.t, 1);
+	hit.t = REAL_C(0.5);
+	EXPECT_FALSE(ray_intersect_triangle(&hit, ray(vector(0.25f, 0.25f, -1, 1), vector(0, 0, 1, 0)), &triangle));
+	EXPECT_REALEQ(hit.t, REAL_C(0.5));
+
+	hit.t = REAL_MAX;
+	EXPECT_FALSE(ray_intersect_triangle(&hit, ray(vector(0.75f, 0.75f, 1, 1), vector(0, 0, -1, 0)), &triangle));
+	EXPECT_FALSE(ray_intersect_triangle(&hit, ray(vector(-0.25f, 0.25f, 1, 1), vector(0, 0, -1, 0)), &triangle));
+	EXPECT_FALSE(ray_intersect_triangle(&hit, ray(vector(0.25f, 0.25f, 1, 1), vector(0, 0, 1, 0)), &triangle));
+	EXPECT_FALSE(ray_intersect_triangle(&hit, ray(vector(-1, 0.25f, 0, 1), vector(1, 0, 0, 0)), &triangle));
+	EXPECT_REALEQ(hit.t, REAL_MAX);
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, ray_triangle_batch) {
+	triangle_t triangles[61];
+	triangle_packet_t packets[16];
+	ray_t rays[4];
+	size_t hits = 0;
+	size_t i;
+	int iloop, lane;
+
+	for (i = 0; i < 61; ++i)
+		triangles[i] = geometry_random_triangle(-5, 5, 4);
+	triangle_packet_build(packets, triangles, 61);
+
+	for (iloop = 0; iloop < 64; ++iloop) {
+		ray_packet_t packet;
+		ray_packet_hit_t packet_hit;
+		unsigned int lanes = 0;
+
+		for (lane = 0; lane < 4; ++lane) {
+			ray_hit_t hit, reference;
+			bool found = false;
+			rays[lane] = geometry_random_ray();
+			memset(&reference, 0, sizeof(reference));
+			memset(&hit, 0, sizeof(hit));
+			reference.t = REAL_MAX;
+			for (i = 0; i < 61; ++i) {
+				if (ray_intersect_triangle(&reference, rays[lane], triangles + i)) {
+					reference.index = (uint32_t)i;
+					found = true;
+				}
+			}
+			hit.t = REAL_MAX;
+			EXPECT_EQ(ray_intersect_triangles(&hit, rays[lane], packets, 61), found);
+			if (found) {
+				EXPECT_UINTEQ(hit.index, reference.index);
+				EXPECT_REALEQ(hit.t, reference.t);
+				//Barycentrics close to zero differ in many ulps between the SoA and scalar paths
+				EXPECT_TRUE(math_abs(hit.u - reference.u) < REAL_C(0.0001));
+				EXPECT_TRUE(math_abs(hit.v - reference.v) < REAL_C(0.0001));
+				lanes |= 1U << lane;
+				++hits;
+			}
+		}
+
+		packet = ray_packet(rays);
+		packet_hit.t = vector_uniform(REAL_MAX);
+		packet_hit.u = vector_zero();
+		packet_hit.v = vector_zero();
+		EXPECT_UINTEQ(ray_packet_intersect_triangles(&packet_hit, &packet, triangles, 61), lanes);
+		for (lane = 0; lane < 4; ++lane) {
+			ray_hit_t hit;
+			if (!(lanes & (1U << lane)))
+				continue;
+			memset(&hit, 0, sizeof(hit));
+			hit.t = REAL_MAX;
+			ray_intersect_triangles(&hit, rays[lane], packets, 61);
+			EXPECT_UINTEQ(packet_hit.index[lane], hit.index);
+			EXPECT_REALEQ(vector_component(packet_hit.t, lane), hit.t);
+			EXPECT_TRUE(math_abs(vector_component(packet_hit.u, lane) - hit.u) < REAL_C(0.0001));
+			EXPECT_TRUE(math_abs(vector_component(packet_hit.v, lane) - hit.v) < REAL_C(0.0001));
+		}
+	}
+	EXPECT_SIZENE(hits, 0);
+	EXPECT_SIZENE(hits, 256);
+
+	return 0;
+}
+
+//Reference slab test in double precision, parallel components handled explicitly
+static bool
+geometry_ray_aabb_reference(const ray_t r, const aabb_t box, real tmax) {
+	double entry = 0, exit = tmax;
+	int axis;
+	for (axis = 0; axis < 3; ++axis) {
+		const double origin = vector_component(r.origin, axis);
+		const double direction = vector_component(r.direction, axis);
+		const double min = vector_component(box.min, axis);
+		const double max = vector_component(box.max, axis);
+		if (direction == 0) {
+			if ((origin < min) || (origin > max))
+				return false;
+			continue;
+		}
+		double t0 = (min - origin) / direction;
+		double t1 = (max - origin) / direction;
+		if (t0 > t1) {
+			const double swap = t0;
+			t0 = t1;
+			t1 = swap;
+		}
+		entry = (t0 > entry) ? t0 : entry;
+		exit = (t1 < exit) ? t1 : exit;
+	}
+	return entry <= exit;
+}
+
+DECLARE_TEST(geometry, ray_aabb) {
+	const aabb_t box = aabb(vector(-1, -1, -1, 1), vector(1, 1, 1, 1));
+	real tnear;
+
+	EXPECT_TRUE(ray_intersect_aabb(&tnear, ray(vector(-5, 0, 0, 1), vector(1, 0, 0, 0)), box, REAL_MAX));
+	EXPECT_REALEQ(tnear, 4);
+	EXPECT_TRUE(ray_intersect_aabb(&tnear, ray(vector(-5, 0.5f, 0, 1), vector(2, 0, 0, 0)), box, REAL_MAX));
+	EXPECT_REALEQ(tnear, 2);
+	EXPECT_TRUE(ray_intersect_aabb(&tnear, ray(vector(0, 0, 0, 1), vector(0, 0, -1, 0)), box, REAL_MAX));
+	EXPECT_REALEQ(tnear, 0);
+	EXPECT_TRUE(ray_intersect_aabb(&tnear, ray(vector(-3, -3, -3, 1), vector(1, 1, 1, 0)), box, REAL_MAX));
+	EXPECT_REALEQ(tnear, 2);
+
+	EXPECT_FALSE(ray_intersect_aabb(&tnear, ray(vector(-5, 0, 0, 1), vector(1, 0, 0, 0)), box, 3));
+	EXPECT_FALSE(ray_intersect_aabb(&tnear, ray(vector(-5, 0, 0, 1), vector(-1, 0, 0, 0)), box, REAL_MAX));
+	EXPECT_FALSE(ray_intersect_aabb(&tnear, ray(vector(-5, 2, 0, 1), vector(1, 0, 0, 0)), box, REAL_MAX));
+	EXPECT_FALSE(ray_intersect_aabb(&tnear, ray(vector(-5, 0, 0, 1), vector(1, 1, 0, 0)), box, REAL_MAX));
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, ray_aabb_batch) {
+	aabb_t boxes[45];
+	aabb_packet_t packets[12];
+	uint32_t hits[45];
+	ray_t rays[4];
+	size_t total_hits = 0;
+	size_t i;
+	int iloop, lane;
+
+	for (i = 0; i < 45; ++i)
+		boxes[i] = aabb_from_center(geometry_random_point(-10, 10), vector(geometry_random(0, 3), geometry_random(0, 3),
+		                                                                    geometry_random(0, 3), 0));
+	aabb_packet_build(packets, boxes, 45);
+
+	for (iloop = 0; iloop < 64; ++iloop) {
+		ray_packet_t packet;
+		ray_slab_t slab;
+		for (lane = 0; lane < 4; ++lane) {
+			size_t num_hits, expected = 0;
+			rays[lane] = geometry_random_ray();
+			//Axis parallel directions
+			if (lane == 3)
+				rays[lane].direction = vector(0, vector_y(rays[lane].direction), 0, 0);
+			num_hits = ray_intersect_aabbs(hits, rays[lane], packets, 45, 30);
+			for (i = 0; i < 45; ++i) {
+				real tnear;
+				const bool hit = ray_intersect_aabb(&tnear, rays[lane], boxes[i], 30);
+				EXPECT_EQ(hit, geometry_ray_aabb_reference(rays[lane], boxes[i], 30));
+				if (hit) {
+					EXPECT_TRUE(expected < num_hits);
+					EXPECT_UINTEQ(hits[expected], (uint32_t)i);
+					++expected;
+				}
+			}
+			EXPECT_SIZEEQ(num_hits, expected);
+			total_hits += num_hits;
+		}
+
+		packet = ray_packet(rays);
+		slab = ray_packet_slab(&packet);
+		for (i = 0; i < 45; ++i) {
+			vector_t tnear;
+			unsigned int lanes = ray_packet_intersect_aabb(&tnear, &slab, boxes[i], vector_uniform(30));
+			for (lane = 0; lane < 4; ++lane) {
+				real expect_near;
+				const bool hit = ray_intersect_aabb(&expect_near, rays[lane], boxes[i], 30);
+				EXPECT_EQ((lanes & (1U << lane)) != 0, hit);
+				if (hit)
+					EXPECT_REALEQ(vector_component(tnear, lane), expect_near);
+			}
+		}
+	}
+	EXPECT_SIZENE(total_hits, 0);
+
+	return 0;
+}
+
+
+DECLARE_TEST(geometry, plane) {
+	plane_t p = plane_from_points(vector(1, 0, 2, 1), vector(0, 1, 2, 1), vector(0, 0, 2, 1));
+	EXPECT_VECTORALMOSTEQ(plane_normal(p), vector(0, 0, 1, 0));
+	EXPECT_REALEQ(vector_w(p), -2);
+	EXPECT_REALEQ(plane_distance(p, vector(5, -3, 0, 0)), -2);
+	EXPECT_REALEQ(plane_distance(p, vector(5, -3, 3, 1)), 1);
+	EXPECT_REALEQ(plane_distance(plane_flip(p), vector(5, -3, 3, 1)), -1);
+	EXPECT_VECTOREQ(plane_project(p, vector(5, -3, 7, 1)), vector(5, -3, 2, 1));
+
+	p = plane(vector(0, 2, 0, 0), -4);
+	EXPECT_REALEQ(plane_distance(p, vector(9, 3, -1, 1)), 2);
+	p = plane_normalize(p);
+	EXPECT_VECTOREQ(p, vector(0, 1, 0, -2));
+	EXPECT_VECTOREQ(p, plane_from_point_normal(vector(7, 2, 1, 1), vector(0, 1, 0, 0)));
+	EXPECT_REALEQ(plane_distance(p, vector(9, 3, -1, 1)), 1);
+
+	EXPECT_UINTEQ(plane_classify(p, vector(0, 2.5f, 0, 1), REAL_C(0.1)), PLANE_FRONT);
+	EXPECT_UINTEQ(plane_classify(p, vector(0, 1.5f, 0, 1), REAL_C(0.1)), PLANE_BACK);
+	EXPECT_UINTEQ(plane_classify(p, vector(0, 2.05f, 0, 1), REAL_C(0.1)), 0);
+	EXPECT_UINTEQ(plane_classify(p, vector(0, 2.05f, 0, 1), 0), PLANE_FRONT);
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, plane_array) {
+	vector_t points[75];
+	real distance[75];
+	real classify_distance[75];
+	uint32_t front[3], back[3];
+	size_t count, i;
+	const real epsilon = REAL_C(0.5);
+	const plane_t p = plane_normalize(plane(vector(geometry_random(-1, 1), geometry_random(-1, 1),
+	                                               geometry_random(-1, 1), 0), 1));
+
+	for (i = 0; i < 75; ++i)
+		points[i] = geometry_random_point(-10, 10);
+	//Points on the plane
+	points[5] = plane_project(p, points[5]);
+	points[40] = plane_project(p, points[40]);
+
+	for (count = 0; count <= 75; count += (count < 9) ? 1 : 11) {
+		unsigned int expected_classes = 0;
+		unsigned int classes;
+		memset(front, 0xFF, sizeof(front));
+		memset(back, 0xFF, sizeof(back));
+		plane_array_distance(distance, p, points, count);
+		classes = plane_array_classify(front, back, classify_distance, p, points, count, epsilon);
+		for (i = 0; i < count; ++i) {
+			const unsigned int expected = plane_classify(p, points[i], epsilon);
+			const unsigned int bit = 1U << (i & 31);
+			EXPECT_TRUE(math_abs(distance[i] - plane_distance(p, points[i])) < REAL_C(0.0001));
+			EXPECT_TRUE(distance[i] == classify_distance[i]);
+			EXPECT_EQ((front[i >> 5] & bit) != 0, distance[i] > epsilon);
+			EXPECT_EQ((back[i >> 5] & bit) != 0, distance[i] < -epsilon);
+			if ((math_abs(distance[i] - epsilon) > REAL_C(0.001)) && (math_abs(distance[i] + epsilon) > REAL_C(0.001)))
+				EXPECT_UINTEQ(((front[i >> 5] & bit) ? PLANE_FRONT : 0) | ((back[i >> 5] & bit) ? PLANE_BACK : 0), expected);
+			expected_classes |= ((front[i >> 5] & bit) ? PLANE_FRONT : 0) | ((back[i >> 5] & bit) ? PLANE_BACK : 0);
+		}
+		//Bits past the last point are cleared in the last word
+		if (count & 31) {
+			EXPECT_UINTEQ(front[count >> 5] >> (count & 31), 0);
+			EXPECT_UINTEQ(back[count >> 5] >> (count & 31), 0);
+		}
+		EXPECT_UINTEQ(classes, expected_classes);
+		if (count > 8)
+			EXPECT_UINTEQ(classes, PLANE_SPANNING);
+		EXPECT_UINTEQ(plane_array_classify(front, back, 0, p, points, count, epsilon), classes);
+	}
+
+	EXPECT_UINTEQ(plane_array_classify(front, back, 0, p, points + 5, 1, epsilon), 0);
+	EXPECT_UINTEQ(plane_array_classify(front, back, 0, p, points, 0, epsilon), 0);
+
+	return 0;
+}
+
+//Check every primitive is referenced once and contained in the bounds of its leaf
+static bool
+geometry_bvh_validate(const bvh_t* bvh, const aabb_t* bounds, size_t count, unsigned int leaf_size) {
+	uint32_t* referenced = memory_allocate(HASH_TEST, sizeof(uint32_t) * count, 0, MEMORY_TEMPORARY | MEMORY_ZERO_INITIALIZED);
+	size_t inode, i;
+	bool valid = true;
+	for (inode = 0; inode < bvh->num_nodes; ++inode) {
+		const bvh_node_t* node = bvh->nodes + inode;
+		matrix_t min, max;
+		unsigned int lane;
+		min.row[0] = node->bounds.min[0];
+		min.row[1] = node->bounds.min[1];
+		min.row[2] = node->bounds.min[2];
+		min.row[3] = vector_zero();
+		max.row[0] = node->bounds.max[0];
+		max.row[1] = node->bounds.max[1];
+		max.row[2] = node->bounds.max[2];
+		max.row[3] = vector_zero();
+		min = matrix_transpose(min);
+		max = matrix_transpose(max);
+		if (!(node->lanes & 1) || (inode && (node->parent >= inode)))
+			valid = false;
+		for (lane = 0; lane < 4; ++lane) {
+			const aabb_t child_bounds = aabb(min.row[lane], max.row[lane]);
+			if (!(node->lanes & (1U << lane)))
+				continue;
+			if (node->count[lane]) {
+				if (node->count[lane] > leaf_size)
+					valid = false;
+				for (i = 0; i < node->count[lane]; ++i) {
+					const uint32_t primitive = bvh->indices[node->child[lane] + i];
+					++referenced[primitive];
+					if (!aabb_contains(child_bounds, bounds[primitive]))
+						valid = false;
+				}
+			}
+			else if ((node->child[lane] <= inode) || (node->child[lane] >= bvh->num_nodes) ||
+			         (bvh->nodes[node->child[lane]].parent != inode)) {
+				valid = false;
+			}
+			if (!aabb_contains(bvh->bounds, child_bounds))
+				valid = false;
+		}
+	}
+	for (i = 0; i < count; ++i) {
+		if (referenced[i] != 1)
+			valid = false;
+	}
+	memory_deallocate(referenced);
+	return valid;
+}
+
+DECLARE_TEST(geometry, bvh) {
+	bvh_t bvh;
+	aabb_t bounds[301];
+	triangle_t triangles[301];
+	size_t i, num_hits = 0;
+	int iloop;
+
+	bvh_initialize(&bvh);
+	bvh_build(&bvh, bounds, 0, 4);
+	EXPECT_SIZEEQ(bvh.num_nodes, 0);
+	EXPECT_TRUE(aabb_is_empty(bvh.bounds));
+
+	for (i = 0; i < 301; ++i) {
+		triangles[i] = geometry_random_triangle(-10, 10, 2);
+		bounds[i] = aabb_include(aabb_include(aabb(triangles[i].v[0], triangles[i].v[0]), triangles[i].v[1]),
+		                         triangles[i].v[2]);
+	}
+
+	bvh_build(&bvh, bounds, 1, 4);
+	EXPECT_SIZEEQ(bvh.num_nodes, 1);
+	EXPECT_TRUE(geometry_bvh_validate(&bvh, bounds, 1, 4));
+
+	bvh_build(&bvh, bounds, 301, 1);
+	EXPECT_TRUE(geometry_bvh_validate(&bvh, bounds, 301, 1));
+	EXPECT_SIZELE(bvh.num_nodes, 301);
+	bvh_build(&bvh, bounds, 301, 4);
+	EXPECT_TRUE(geometry_bvh_validate(&bvh, bounds, 301, 4));
+	EXPECT_SIZELE(bvh.num_nodes, 301);
+	EXPECT_TRUE(aabb_contains(bvh.bounds, aabb_array_union(bounds, 301)));
+	EXPECT_TRUE(aabb_contains(aabb_array_union(bounds, 301), bvh.bounds));
+
+	for (iloop = 0; iloop < 256; ++iloop) {
+		const ray_t r = geometry_random_ray();
+		ray_hit_t hit, reference;
+		bool found = false;
+		memset(&reference, 0, sizeof(reference));
+		memset(&hit, 0, sizeof(hit));
+		reference.t = REAL_MAX;
+		hit.t = REAL_MAX;
+		for (i = 0; i < 301; ++i) {
+			if (ray_intersect_triangle(&reference, r, triangles + i)) {
+				reference.index = (uint32_t)i;
+				found = true;
+			}
+		}
+		EXPECT_EQ(bvh_intersect_triangles(&bvh, &hit, r, triangles), found);
+		if (found) {
+			ray_hit_t check;
+			EXPECT_REALEQ(hit.t, reference.t);
+			memset(&check, 0, sizeof(check));
+			check.t = REAL_MAX;
+			EXPECT_TRUE(ray_intersect_triangle(&check, r, triangles + hit.index));
+			EXPECT_REALEQ(check.t, hit.t);
+			++num_hits;
+		}
+	}
+	EXPECT_SIZENE(num_hits, 0);
+	EXPECT_SIZENE(num_hits, 256);
+
+	bvh_finalize(&bvh);
+	EXPECT_EQ(bvh.nodes, 0);
+	EXPECT_SIZEEQ(bvh.num_primitives, 0);
+
+	return 0;
+}
+
+//Number of exact overlaps missing from the query candidates
+static size_t
+geometry_bvh_query_check(const uint32_t* results, size_t num_results, const bool* expected, size_t count) {
+	bool found[301];
+	size_t i, missing = 0;
+	memset(found, 0, sizeof(found));
+	for (i = 0; i < num_results; ++i)
+		found[results[i]] = true;
+	for (i = 0; i < count; ++i) {
+		if (expected[i] && !found[i])
+			++missing;
+	}
+	return missing;
+}
+
+DECLARE_TEST(geometry, bvh_query) {
+	bvh_t bvh;
+	aabb_t bounds[301];
+	uint32_t results[301];
+	bool expected[301];
+	size_t i, num_results, num_expected, total = 0;
+	unsigned int leaf_size;
+	int iloop;
+
+	for (i = 0; i < 301; ++i)
+		bounds[i] = aabb_from_center(geometry_random_point(-20, 20), vector(geometry_random(0, 2), geometry_random(0, 2),
+		                                                                     geometry_random(0, 2), 0));
+
+	bvh_initialize(&bvh);
+	for (leaf_size = 1; leaf_size <= 8; leaf_size *= 2) {
+		bvh_build(&bvh, bounds, 301, leaf_size);
+		for (iloop = 0; iloop < 64; ++iloop) {
+			const aabb_t box = aabb_from_center(geometry_random_point(-20, 20),
+			                                    vector(geometry_random(0, 6), geometry_random(0, 6), geometry_random(0, 6), 0));
+			const vector_t center = geometry_random_point(-20, 20);
+			const real radius = geometry_random(0, 6);
+			const vector_t sphere = vector(vector_x(center), vector_y(center), vector_z(center), radius);
+
+			num_expected = 0;
+			for (i = 0; i < 301; ++i) {
+				expected[i] = aabb_overlap(bounds[i], box);
+				num_expected += expected[i] ? 1 : 0;
+			}
+			num_results = bvh_query_aabb(&bvh, results, 301, box);
+			EXPECT_SIZEGE(num_results, num_expected);
+			EXPECT_SIZEEQ(geometry_bvh_query_check(results, num_results, expected, 301), 0);
+			if (leaf_size == 1)
+				EXPECT_SIZEEQ(num_results, num_expected);
+			EXPECT_SIZEEQ(bvh_query_aabb(&bvh, results, 1, box), num_results);
+			total += num_expected;
+
+			num_expected = 0;
+			for (i = 0; i < 301; ++i) {
+				const vector_t closest = vector_min(vector_max(center, bounds[i].min), bounds[i].max);
+				const vector_t delta = vector_sub(closest, center);
+				expected[i] = (vector_x(vector_dot3(delta, delta)) <= radius * radius);
+				num_expected += expected[i] ? 1 : 0;
+			}
+			num_results = bvh_query_sphere(&bvh, results, 301, sphere);
+			EXPECT_SIZEGE(num_results, num_expected);
+			EXPECT_SIZEEQ(geometry_bvh_query_check(results, num_results, expected, 301), 0);
+			if (leaf_size == 1)
+				EXPECT_SIZEEQ(num_results, num_expected);
+			EXPECT_SIZEEQ(bvh_query_sphere(&bvh, 0, 0, sphere), num_results);
+			total += num_expected;
+		}
+	}
+	EXPECT_SIZENE(total, 0);
+
+	//Refit after moving every primitive must give the same results as a rebuild
+	for (i = 0; i < 301; ++i) {
+		const vector_t offset = vector(geometry_random(-3, 3), geometry_random(-3, 3), geometry_random(-3, 3), 0);
+		bounds[i] = aabb(vector_add(bounds[i].min, offset), vector_add(bounds[i].max, offset));
+	}
+	bvh_refit(&bvh, bounds);
+	EXPECT_TRUE(geometry_bvh_validate(&bvh, bounds, 301, 8));
+	EXPECT_TRUE(aabb_contains(bvh.bounds, aabb_array_union(bounds, 301)));
+	EXPECT_TRUE(aabb_contains(aabb_array_union(bounds, 301), bvh.bounds));
+	for (iloop = 0; iloop < 64; ++iloop) {
+		const aabb_t box = aabb_from_center(geometry_random_point(-20, 20),
+		                                    vector(geometry_random(0, 6), geometry_random(0, 6), geometry_random(0, 6), 0));
+		num_expected = 0;
+		for (i = 0; i < 301; ++i) {
+			expected[i] = aabb_overlap(bounds[i], box);
+			num_expected += expected[i] ? 1 : 0;
+		}
+		num_results = bvh_query_aabb(&bvh, results, 301, box);
+		EXPECT_SIZEGE(num_results, num_expected);
+		EXPECT_SIZEEQ(geometry_bvh_query_check(results, num_results, expected, 301), 0);
+	}
+
+	bvh_finalize(&bvh);
+
+	return 0;
+}
+
+//Unit quaternion normalized with a full precision square root
+static quaternion_t
+geometry_random_rotation(void) {
+	const quaternion_t q = vector(geometry_random(-1, 1), geometry_random(-1, 1), geometry_random(-1, 1),
+	                              geometry_random(-1, 1));
+	return vector_div(q, vector_length(q));
+}
+
+static obb_t
+geometry_random_obb(real low, real high) {
+	return obb(geometry_random_point(low, high), vector(geometry_random(REAL_C(0.2), 3), geometry_random(REAL_C(0.2), 3),
+	                                                     geometry_random(REAL_C(0.2), 3), 0), geometry_random_rotation());
+}
+
+static vector_t
+geometry_obb_corner(const obb_t box, int corner) {
+	vector_t point = box.center;
+	point = vector_add(point, vector_scale(box.axis[0], (corner & 1) ? vector_x(box.extent) : -vector_x(box.extent)));
+	point = vector_add(point, vector_scale(box.axis[1], (corner & 2) ? vector_y(box.extent) : -vector_y(box.extent)));
+	point = vector_add(point, vector_scale(box.axis[2], (corner & 4) ? vector_z(box.extent) : -vector_z(box.extent)));
+	return point;
+}
+
+static bool
+geometry_obb_contains(const obb_t box, const vector_t point, real tolerance) {
+	obb_t grown = box;
+	grown.extent = vector_add(box.extent, vector_uniform(tolerance));
+	return obb_contains_point(grown, point);
+}
+
+/* Reference separating axis test in double precision projecting the corners on each of the
+   15 axes, returns the largest gap between the projections, positive if separated */
+static double
+geometry_obb_gap(const obb_t a, const obb_t b) {
+	double axis[15][3];
+	double corner[2][8][3];
+	double gap = -1e30;
+	int num_axes = 0;
+	int i, j, k;
+	for (i = 0; i < 3; ++i) {
+		for (k = 0; k < 3; ++k) {
+			axis[num_axes][k] = vector_component(a.axis[i], k);
+			axis[num_axes + 1][k] = vector_component(b.axis[i], k);
+		}
+		num_axes += 2;
+	}
+	for (i = 0; i < 3; ++i) {
+		for (j = 0; j < 3; ++j) {
+			const double* u = axis[i * 2];
+			const double* v = axis[(j * 2) + 1];
+			const double c[3] = { (u[1] * v[2]) - (u[2] * v[1]), (u[2] * v[0]) - (u[0] * v[2]),
+			                      (u[0] * v[1]) - (u[1] * v[0]) };
+			const double length = sqrt((c[0] * c[0]) + (c[1] * c[1]) + (c[2] * c[2]));
+			if (length < 1e-4)
+				continue;
+			for (k = 0; k < 3; ++k)
+				axis[num_axes][k] = c[k] / length;
+			++num_axes;
+		}
+	}
+	for (i = 0; i < 8; ++i) {
+		const vector_t ca = geometry_obb_corner(a, i);
+		const vector_t cb = geometry_obb_corner(b, i);
+		for (k = 0; k < 3; ++k) {
+			corner[0][i][k] = vector_component(ca, k);
+			corner[1][i][k] = vector_component(cb, k);
+		}
+	}
+	for (i = 0; i < num_axes; ++i) {
+		double min[2] = { 1e30, 1e30 };
+		double max[2] = { -1e30, -1e30 };
+		int box;
+		for (box = 0; box < 2; ++box) {
+			for (j = 0; j < 8; ++j) {
+				const double d = (corner[box][j][0] * axis[i][0]) + (corner[box][j][1] * axis[i][1]) +
+				                 (corner[box][j][2] * axis[i][2]);
+				min[box] = (d < min[box]) ? d : min[box];
+				max[box] = (d > max[box]) ? d : max[box];
+			}
+		}
+		gap = (min[1] - max[0] > gap) ? min[1] - max[0] : gap;
+		gap = (min[0] - max[1] > gap) ? min[0] - max[1] : gap;
+	}
+	return gap;
+}
+
+DECLARE_TEST(geometry, obb) {
+	const aabb_t box = aabb(vector(-1, 2, -3, 1), vector(4, 3, 1, 1));
+	vector_t points[64];
+	obb_t oriented = obb_from_aabb(box);
+	aabb_t bounds;
+	transform_t transform;
+	int iloop, corner, i;
+
+	EXPECT_VECTOREQ(obb_aabb(oriented).min, box.min);
+	EXPECT_VECTOREQ(obb_aabb(oriented).max, box.max);
+	EXPECT_TRUE(obb_contains_point(oriented, vector(0, 2.5f, 0, 1)));
+	EXPECT_TRUE(obb_contains_point(oriented, vector(4, 3, 1, 1)));
+	EXPECT_FALSE(obb_contains_point(oriented, vector(0, 3.5f, 0, 1)));
+
+	for (iloop = 0; iloop < 64; ++iloop) {
+		real scale;
+		oriented = geometry_random_obb(-10, 10);
+
+		//Axes are orthonormal
+		EXPECT_REALEQ(vector_x(vector_length3(oriented.axis[0])), 1);
+		EXPECT_TRUE(math_abs(vector_x(vector_dot3(oriented.axis[0], oriented.axis[1]))) < REAL_C(0.0001));
+
+		bounds = aabb_empty();
+		for (corner = 0; corner < 8; ++corner) {
+			const vector_t point = geometry_obb_corner(oriented, corner);
+			bounds = aabb_include(bounds, point);
+			EXPECT_TRUE(geometry_obb_contains(oriented, point, REAL_C(0.001)));
+		}
+		//w components are not compared
+		bounds = aabb(vector_blend(bounds.min, obb_aabb(oriented).min, VECTOR_BLEND_0001),
+		              vector_blend(bounds.max, obb_aabb(oriented).max, VECTOR_BLEND_0001));
+		EXPECT_VECTORALMOSTEQ(obb_aabb(oriented).min, bounds.min);
+		EXPECT_VECTORALMOSTEQ(obb_aabb(oriented).max, bounds.max);
+		EXPECT_FALSE(obb_contains_point(oriented, vector_add(oriented.center, vector_scale(oriented.axis[1],
+		                                                                     vector_y(oriented.extent) + REAL_C(0.01)))));
+
+		//Transformed corners are the corners of the transformed box
+		scale = geometry_random(REAL_C(0.5), 2);
+		transform.rotation = geometry_random_rotation();
+		transform.translation = vector(geometry_random(-10, 10), geometry_random(-10, 10), geometry_random(-10, 10), scale);
+		{
+			const obb_t transformed = obb_transform(oriented, transform);
+			EXPECT_VECTORALMOSTEQ(transformed.extent, vector_scale(oriented.extent, scale));
+			for (corner = 0; corner < 8; ++corner) {
+				const vector_t point = vector_add(quaternion_rotate(transform.rotation,
+				                                                    vector_scale(geometry_obb_corner(oriented, corner), scale)),
+				                                  transform.translation);
+				EXPECT_TRUE(geometry_obb_contains(transformed, point, REAL_C(0.001)));
+			}
+		}
+
+		//Fit to the corners recovers the box, fit to interior points is contained in it
+		for (corner = 0; corner < 8; ++corner)
+			points[corner] = geometry_obb_corner(oriented, corner);
+		{
+			const obb_t fitted = obb_from_points(points, 8);
+			const vector_t a = oriented.extent;
+			const vector_t b = fitted.extent;
+			EXPECT_TRUE(math_abs((vector_x(a) * vector_y(a) * vector_z(a)) - (vector_x(b) * vector_y(b) * vector_z(b))) <
+			            REAL_C(0.01) * (vector_x(a) * vector_y(a) * vector_z(a)));
+			EXPECT_REALEQ(vector_x(vector_dot3(vector_cross3(fitted.axis[0], fitted.axis[1]), fitted.axis[2])), 1);
+			for (corner = 0; corner < 8; ++corner)
+				EXPECT_TRUE(geometry_obb_contains(fitted, points[corner], REAL_C(0.001)));
+		}
+		for (i = 0; i < 64; ++i) {
+			const vector_t local = vector(geometry_random(-1, 1), geometry_random(-1, 1), geometry_random(-1, 1), 0);
+			points[i] = vector_add(oriented.center, vector_add(vector_scale(oriented.axis[0], vector_x(local) * vector_x(oriented.extent)),
+			                       vector_add(vector_scale(oriented.axis[1], vector_y(local) * vector_y(oriented.extent)),
+			                                  vector_scale(oriented.axis[2], vector_z(local) * vector_z(oriented.extent)))));
+		}
+		{
+			const obb_t fitted = obb_from_points(points, 64);
+			for (i = 0; i < 64; ++i)
+				EXPECT_TRUE(geometry_obb_contains(fitted, points[i], REAL_C(0.001)));
+		}
+	}
+
+	oriented = obb_from_points(points, 1);
+	EXPECT_VECTOREQ(oriented.extent, vector_zero());
+	EXPECT_VECTORALMOSTEQ(vector_blend(oriented.center, vector_zero(), VECTOR_BLEND_0001),
+	                      vector_blend(points[0], vector_zero(), VECTOR_BLEND_0001));
+	oriented = obb_from_points(points, 0);
+	EXPECT_VECTOREQ(oriented.extent, vector_zero());
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, obb_overlap) {
+	obb_t a[256], b[256];
+	uint32_t overlapping[256];
+	bool expected[256];
+	size_t num_overlapping, num_expected = 0, i;
+	size_t checked = 0;
+	transform_t transform;
+
+	for (i = 0; i < 256; ++i) {
+		double gap;
+		a[i] = geometry_random_obb(-4, 4);
+		b[i] = geometry_random_obb(-4, 4);
+		gap = geometry_obb_gap(a[i], b[i]);
+		expected[i] = (gap <= 0);
+		num_expected += expected[i] ? 1 : 0;
+		//Only compare cases clearly away from touching
+		if ((gap > 0.001) || (gap < -0.001)) {
+			EXPECT_EQ(obb_overlap(a[i], b[i]), expected[i]);
+			EXPECT_EQ(obb_overlap(b[i], a[i]), expected[i]);
+			++checked;
+		}
+	}
+	EXPECT_SIZENE(num_expected, 0);
+	EXPECT_SIZENE(num_expected, 256);
+	EXPECT_SIZEGE(checked, 200);
+
+	num_overlapping = obb_array_overlap(overlapping, a, b, 256);
+	num_expected = 0;
+	for (i = 0; i < 256; ++i) {
+		if (obb_overlap(a[i], b[i])) {
+			EXPECT_TRUE(num_expected < num_overlapping);
+			EXPECT_UINTEQ(overlapping[num_expected], (uint32_t)i);
+			++num_expected;
+		}
+	}
+	EXPECT_SIZEEQ(num_overlapping, num_expected);
+	EXPECT_SIZEEQ(obb_array_overlap(overlapping, a, b, 0), 0);
+
+	//Parallel boxes with degenerate edge cross products, separated only along a face axis
+	transform.rotation = geometry_random_rotation();
+	transform.translation = vector(1, 2, 3, 1);
+	a[0] = obb_transform(obb_from_aabb(aabb(vector(0, 0, 0, 1), vector(1, 1, 1, 1))), transform);
+	b[0] = obb_transform(obb_from_aabb(aabb(vector(REAL_C(1.01), 0, 0, 1), vector(2, 1, 1, 1))), transform);
+	EXPECT_FALSE(obb_overlap(a[0], b[0]));
+	b[0] = obb_transform(obb_from_aabb(aabb(vector(REAL_C(0.99), REAL_C(0.5), 0, 1), vector(2, 1, 1, 1))), transform);
+	EXPECT_TRUE(obb_overlap(a[0], b[0]));
+	EXPECT_TRUE(obb_overlap(a[0], a[0]));
+
+	//Edge-edge separation, boxes rotated 45 degrees around crossing axes
+	a[0] = obb(vector(0, 0, 0, 1), vector(1, 1, 1, 0), vector(0, 0, REAL_C(0.38268343), REAL_C(0.92387953)));
+	b[0] = obb(vector(REAL_C(2.9), REAL_C(2.9), 0, 1), vector(1, 1, 1, 0),
+	           vector(REAL_C(0.38268343), 0, 0, REAL_C(0.92387953)));
+	EXPECT_EQ(obb_overlap(a[0], b[0]), geometry_obb_gap(a[0], b[0]) <= 0);
+
+	return 0;
+}
+
+//Check pairs against all pairs of boxes, each overlapping pair reported exactly once
+static bool
+geometry_broadphase_check(const broadphase_pair_t* pairs, size_t num_pairs, const aabb_t* bounds, size_t count) {
+	uint8_t* found = memory_allocate(HASH_TEST, count * count, 0, MEMORY_TEMPORARY | MEMORY_ZERO_INITIALIZED);
+	bool valid = true;
+	size_t i, j;
+	for (i = 0; i < num_pairs; ++i) {
+		if ((pairs[i].a >= pairs[i].b) || (pairs[i].b >= count) || found[(pairs[i].a * count) + pairs[i].b])
+			valid = false;
+		else
+			found[(pairs[i].a * count) + pairs[i].b] = 1;
+	}
+	for (i = 0; i < count; ++i) {
+		for (j = i + 1; j < count; ++j) {
+			if (aabb_overlap(bounds[i], bounds[j]) != (found[(i * count) + j] != 0))
+				valid = false;
+		}
+	}
+	memory_deallocate(found);
+	return valid;
+}
+
+DECLARE_TEST(geometry, broadphase) {
+	broadphase_t broadphase;
+	aabb_t bounds[300];
+	vector_t velocity[300];
+	broadphase_pair_t pairs[2048];
+	size_t count = 200;
+	size_t num_pairs, total = 0;
+	size_t i;
+	int frame;
+
+	broadphase_initialize(&broadphase);
+	broadphase_update(&broadphase, bounds, 0);
+	EXPECT_SIZEEQ(broadphase_pairs(&broadphase, pairs, 2048), 0);
+
+	for (i = 0; i < 300; ++i) {
+		bounds[i] = aabb_from_center(geometry_random_point(-30, 30), vector(geometry_random(REAL_C(0.5), 3),
+		                                                                     geometry_random(REAL_C(0.5), 3),
+		                                                                     geometry_random(REAL_C(0.5), 3), 0));
+		velocity[i] = vector(geometry_random(-1, 1), geometry_random(-1, 1), geometry_random(-1, 1), 0);
+	}
+
+	for (frame = 0; frame < 32; ++frame) {
+		//Objects are added and removed between frames
+		if (frame == 10)
+			count = 300;
+		else if (frame == 20)
+			count = 150;
+		for (i = 0; i < count; ++i) {
+			bounds[i] = aabb(vector_add(bounds[i].min, velocity[i]), vector_add(bounds[i].max, velocity[i]));
+			if (math_abs(vector_x(aabb_center(bounds[i]))) > 30)
+				velocity[i] = vector_neg(velocity[i]);
+		}
+		broadphase_update(&broadphase, bounds, count);
+		EXPECT_SIZEEQ(broadphase.num_objects, count);
+		for (i = 1; i < count; ++i)
+			EXPECT_TRUE(broadphase.min_x[i - 1] <= broadphase.min_x[i]);
+		num_pairs = broadphase_pairs(&broadphase, pairs, 2048);
+		EXPECT_SIZELE(num_pairs, 2048);
+		EXPECT_TRUE(geometry_broadphase_check(pairs, num_pairs, bounds, count));
+		EXPECT_SIZEEQ(broadphase_pairs(&broadphase, pairs, 3), num_pairs);
+		total += num_pairs;
+	}
+	EXPECT_SIZENE(total, 0);
+
+	//Touching boxes overlap, also when sharing the same min x
+	bounds[0] = aabb(vector(0, 0, 0, 1), vector(1, 1, 1, 1));
+	bounds[1] = aabb(vector(1, 1, 1, 1), vector(2, 2, 2, 1));
+	bounds[2] = aabb(vector(0, REAL_C(1.5), 0, 1), vector(1, 2, 1, 1));
+	broadphase_update(&broadphase, bounds, 3);
+	EXPECT_SIZEEQ(broadphase_pairs(&broadphase, pairs, 2048), 2);
+	EXPECT_TRUE(geometry_broadphase_check(pairs, 2, bounds, 3));
+
+	//Unbounded box overlaps everything, the sweep must still end at the last object
+	bounds[0] = aabb(vector_uniform(-REAL_MAX), vector_uniform(REAL_MAX));
+	bounds[1] = aabb(vector(0, 0, 0, 1), vector(1, 1, 1, 1));
+	bounds[2] = aabb(vector(5, 0, 0, 1), vector(6, 1, 1, 1));
+	broadphase_update(&broadphase, bounds, 3);
+	EXPECT_SIZEEQ(broadphase_pairs(&broadphase, pairs, 2048), 2);
+	EXPECT_TRUE(geometry_broadphase_check(pairs, 2, bounds, 3));
+	bounds[3] = aabb(vector(0, 0, 0, 1), vector(REAL_MAX, 1, 1, 1));
+	bounds[4] = aabb(vector(REAL_MAX, 0, 0, 1), vector(REAL_MAX, 1, 1, 1));
+	broadphase_update(&broadphase, bounds, 5);
+	EXPECT_SIZEEQ(broadphase_pairs(&broadphase, pairs, 2048), 7);
+	EXPECT_TRUE(geometry_broadphase_check(pairs, 7, bounds, 5));
+
+	broadphase_finalize(&broadphase);
+	EXPECT_SIZEEQ(broadphase.num_objects, 0);
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, hashgrid) {
+	hashgrid_t grid, parallel;
+	vector_t points[2000];
+	uint32_t results[2000];
+	uint8_t found[2000];
+	size_t num_results, total = 0;
+	size_t count, i;
+	unsigned int num_tasks, task;
+	int iloop;
+
+	for (i = 0; i < 2000; ++i)
+		points[i] = geometry_random_point(-20, 20);
+	//Points on cell boundaries, also negative
+	points[0] = vector(0, 0, 0, 1);
+	points[1] = vector(-2, -4, 2, 1);
+	points[2] = vector(REAL_C(-0.0001), 2, -2, 1);
+
+	hashgrid_initialize(&grid, 2);
+	EXPECT_SIZEEQ(hashgrid_query_radius(&grid, results, 2000, vector_zero(), 5), 0);
+
+	for (count = 2000; count >= 500; count /= 4) {
+		hashgrid_build(&grid, points, count);
+		EXPECT_SIZEEQ(grid.num_points, count);
+		EXPECT_UINTEQ(grid.bucket_start[grid.num_buckets], (uint32_t)count);
+
+		for (iloop = 0; iloop < 128; ++iloop) {
+			const vector_t center = (iloop < 3) ? points[iloop] : geometry_random_point(-22, 22);
+			const real radius = geometry_random(0, 4);
+			size_t num_expected = 0;
+			memset(found, 0, sizeof(found));
+			num_results = hashgrid_query_radius(&grid, results, 2000, center, radius);
+			for (i = 0; i < num_results; ++i) {
+				EXPECT_TRUE(results[i] < count);
+				EXPECT_UINTEQ(found[results[i]], 0);
+				found[results[i]] = 1;
+			}
+			for (i = 0; i < count; ++i) {
+				const vector_t delta = vector_sub(points[i], center);
+				const bool inside = (vector_x(vector_dot3(delta, delta)) <= radius * radius);
+				EXPECT_EQ(found[i] != 0, inside);
+				num_expected += inside ? 1 : 0;
+			}
+			EXPECT_SIZEEQ(num_results, num_expected);
+			EXPECT_SIZEEQ(hashgrid_query_radius(&grid, results, 1, center, radius), num_expected);
+			total += num_expected;
+		}
+		//Query at a point finds the point itself
+		EXPECT_SIZEGE(hashgrid_query_radius(&grid, results, 2000, points[2], 0), 1);
+	}
+	EXPECT_SIZENE(total, 0);
+
+	//Build split in tasks gives the same arrays as the single task build
+	hashgrid_build(&grid, points, 2000);
+	hashgrid_initialize(&parallel, 2);
+	for (num_tasks = 1; num_tasks <= 7; num_tasks += 3) {
+		hashgrid_build_begin(&parallel, points, 2000, num_tasks);
+		for (task = num_tasks; task > 0; --task)
+			hashgrid_build_count(&parallel, task - 1);
+		hashgrid_build_prefix(&parallel);
+		for (task = 0; task < num_tasks; ++task)
+			hashgrid_build_scatter(&parallel, task);
+		EXPECT_SIZEEQ(parallel.num_buckets, grid.num_buckets);
+		EXPECT_EQ(memcmp(parallel.bucket_start, grid.bucket_start, sizeof(uint32_t) * (grid.num_buckets + 1)), 0);
+		EXPECT_EQ(memcmp(parallel.indices, grid.indices, sizeof(uint32_t) * 2000), 0);
+		EXPECT_EQ(memcmp(parallel.cells, grid.cells, sizeof(uint64_t) * 2000), 0);
+	}
+	hashgrid_finalize(&parallel);
+
+	hashgrid_build(&grid, points, 0);
+	EXPECT_SIZEEQ(hashgrid_query_radius(&grid, results, 2000, vector_zero(), 5), 0);
+	hashgrid_finalize(&grid);
+	EXPECT_REALEQ(grid.cell_size, 2);
+
+	return 0;
+}
+
+static uint32_t
+geometry_random_bits(void) {
+	uint32_t high;
+	_geometry_random_state = _geometry_random_state * 1664525U + 1013904223U;
+	high = _geometry_random_state >> 16;
+	_geometry_random_state = _geometry_random_state * 1664525U + 1013904223U;
+	return (high << 16) | (_geometry_random_state >> 16);
+}
+
+static uint64_t
+geometry_morton_interleave(uint32_t x, uint32_t y, uint32_t z, unsigned int bits) {
+	uint64_t code = 0;
+	unsigned int bit;
+	for (bit = 0; bit < bits; ++bit) {
+		code |= (uint64_t)((x >> bit) & 1) << (bit * 3);
+		code |= (uint64_t)((y >> bit) & 1) << (bit * 3 + 1);
+		code |= (uint64_t)((z >> bit) & 1) << (bit * 3 + 2);
+	}
+	return code;
+}
+
+DECLARE_TEST(geometry, morton) {
+	vector_t points[67];
+	uint32_t codes30[67];
+	uint64_t codes63[67];
+	uint32_t single30;
+	uint64_t single63;
+	aabb_t bounds;
+	size_t count, i;
+	unsigned int axis;
+	int iloop;
+
+	for (iloop = 0; iloop < 256; ++iloop) {
+		const uint32_t x = geometry_random_bits() & 0x1FFFFF;
+		const uint32_t y = geometry_random_bits() & 0x1FFFFF;
+		const uint32_t z = geometry_random_bits() & 0x1FFFFF;
+		const uint32_t code30 = morton_encode30(x & 0x3FF, y & 0x3FF, z & 0x3FF);
+		const uint64_t code63 = morton_encode63(x, y, z);
+		EXPECT_UINTEQ(code30, (uint32_t)geometry_morton_interleave(x, y, z, 10));
+		EXPECT_TRUE(code63 == geometry_morton_interleave(x, y, z, 21));
+		EXPECT_UINTEQ(morton_decode30(code30, 0), x & 0x3FF);
+		EXPECT_UINTEQ(morton_decode30(code30, 1), y & 0x3FF);
+		EXPECT_UINTEQ(morton_decode30(code30, 2), z & 0x3FF);
+		EXPECT_UINTEQ(morton_decode63(code63, 0), x);
+		EXPECT_UINTEQ(morton_decode63(code63, 1), y);
+		EXPECT_UINTEQ(morton_decode63(code63, 2), z);
+	}
+	EXPECT_UINTEQ(morton_encode30(0x3FF, 0x3FF, 0x3FF), 0x3FFFFFFF);
+	EXPECT_TRUE(morton_encode63(0x1FFFFF, 0x1FFFFF, 0x1FFFFF) == 0x7FFFFFFFFFFFFFFFULL);
+
+	bounds = aabb(vector(-10, -5, 0, 0), vector(10, 5, 0, 0));
+	for (i = 0; i < 67; ++i)
+		points[i] = geometry_random_point(-12, 12);
+	points[0] = bounds.min;
+	points[1] = bounds.max;
+	points[2] = vector(0, 0, 0, 1);
+	for (count = 67; count > 60; --count) {
+		morton_array_encode30(codes30, points, count, bounds);
+		morton_array_encode63(codes63, points, count, bounds);
+		for (i = 0; i < count; ++i) {
+			//Four wide and single point paths quantize identically
+			morton_array_encode30(&single30, points + i, 1, bounds);
+			morton_array_encode63(&single63, points + i, 1, bounds);
+			EXPECT_UINTEQ(codes30[i], single30);
+			EXPECT_TRUE(codes63[i] == single63);
+			//Coarse code is the prefix of the fine code, up to rounding of the quantization
+			for (axis = 0; axis < 3; ++axis) {
+				const uint32_t coarse = morton_decode30(codes30[i], axis);
+				const uint32_t fine = morton_decode63(codes63[i], axis) >> 11;
+				EXPECT_TRUE((coarse == fine) || (coarse + 1 == fine) || (coarse == fine + 1));
+			}
+			EXPECT_UINTEQ(morton_decode30(codes30[i], 2), 0);
+		}
+	}
+	EXPECT_UINTEQ(codes30[0], 0);
+	EXPECT_UINTEQ(codes30[1], morton_encode30(0x3FF, 0x3FF, 0));
+	EXPECT_TRUE(codes63[1] == morton_encode63(0x1FFFFF, 0x1FFFFF, 0));
+	//Points outside bounds are clamped
+	for (i = 0; i < 67; ++i) {
+		for (axis = 0; axis < 2; ++axis) {
+			const real coord = vector_component(points[i], (int)axis);
+			if (coord <= vector_component(bounds.min, (int)axis))
+				EXPECT_UINTEQ(morton_decode30(codes30[i], axis), 0);
+			else if (coord >= vector_component(bounds.max, (int)axis))
+				EXPECT_UINTEQ(morton_decode30(codes30[i], axis), 0x3FF);
+		}
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(geometry, morton_sort) {
+	vector_t points[3000];
+	vector_t sorted[3000];
+	uint32_t codes30[3000];
+	uint32_t input30[3000];
+	uint64_t codes63[3000];
+	uint64_t input63[3000];
+	uint32_t order[3000];
+	aabb_t bounds;
+	size_t count, i;
+
+	for (i = 0; i < 3000; ++i) {
+		points[i] = geometry_random_point(-100, 100);
+		input30[i] = geometry_random_bits() & 0x3FFFFFFF;
+		input63[i] = (((uint64_t)geometry_random_bits() << 32) | geometry_random_bits()) & 0x7FFFFFFFFFFFFFFFULL;
+	}
+	//Duplicates to check stability, and high digits all equal in the small range
+	for (i = 0; i < 3000; i += 7) {
+		input30[i] = input30[i / 2];
+		input63[i] = input63[i / 2];
+	}
+
+	for (count = 3000; count > 0; count /= 5) {
+		memcpy(codes30, input30, sizeof(uint32_t) * count);
+		morton_sort30(codes30, order, count);
+		for (i = 0; i < count; ++i) {
+			EXPECT_UINTEQ(codes30[i], input30[order[i]]);
+			if (i) {
+				EXPECT_TRUE(codes30[i - 1] <= codes30[i]);
+				if (codes30[i - 1] == codes30[i])
+					EXPECT_TRUE(order[i - 1] < order[i]);
+			}
+		}
+		memcpy(codes63, input63, sizeof(uint64_t) * count);
+		morton_sort63(codes63, order, count);
+		for (i = 0; i < count; ++i) {
+			EXPECT_TRUE(codes63[i] == input63[order[i]]);
+			if (i) {
+				EXPECT_TRUE(codes63[i - 1] <= codes63[i]);
+				if (codes63[i - 1] == codes63[i])
+					EXPECT_TRUE(order[i - 1] < order[i]);
+			}
+		}
+		//Without order
+		memcpy(input63 + 1500, codes63, sizeof(uint64_t) * ((count < 1500) ? count : 1500));
+		memcpy(codes63, input63, sizeof(uint64_t) * count);
+		morton_sort63(codes63, 0, count);
+		for (i = 1; i < count; ++i)
+			EXPECT_TRUE(codes63[i - 1] <= codes63[i]);
+		memcpy(codes30, input30, sizeof(uint32_t) * count);
+		morton_sort30(codes30, 0, count);
+		for (i = 1; i < count; ++i)
+			EXPECT_TRUE(codes30[i - 1] <= codes30[i]);
+	}
+
+	//Small codes only use the lowest digit
+	for (i = 0; i < 100; ++i)
+		codes30[i] = (uint32_t)(99 - i);
+	morton_sort30(codes30, order, 100);
+	for (i = 0; i < 100; ++i) {
+		EXPECT_UINTEQ(codes30[i], (uint32_t)i);
+		EXPECT_UINTEQ(order[i], (uint32_t)(99 - i));
+	}
+
+	memcpy(sorted, points, sizeof(points));
+	morton_sort_points(sorted, order, 3000);
+	bounds = aabb_from_points(points, 3000);
+	morton_array_encode30(codes30, sorted, 3000, bounds);
+	for (i = 0; i < 3000; ++i) {
+		EXPECT_VECTOREQ(sorted[i], points[order[i]]);
+		if (i)
+			EXPECT_TRUE(codes30[i - 1] <= codes30[i]);
+	}
+	morton_sort_points(sorted, 0, 3000);
+	for (i = 0; i < 3000; ++i)
+		EXPECT_VECTOREQ(sorted[i], points[order[i]]);
+	morton_sort_points(sorted, order, 1);
+	EXPECT_UINTEQ(order[0], 0);
+
+	return 0;
+}
+
+static void
+test_geometry_declare(void) {
+	ADD_TEST(geometry, aabb);
+	ADD_TEST(geometry, aabb_transform);
+	ADD_TEST(geometry, aabb_array);
+	ADD_TEST(geometry, plane);
+	ADD_TEST(geometry, plane_array);
+	ADD_TEST(geometry, frustum);
+	ADD_TEST(geometry, frustum_cull);
+	ADD_TEST(geometry, ray_triangle);
+	ADD_TEST(geometry, ray_triangle_batch);
+	ADD_TEST(geometry, ray_aabb);
+	ADD_TEST(geometry, ray_aabb_batch);
+	ADD_TEST(geometry, bvh);
+	ADD_TEST(geometry, bvh_query);
+	ADD_TEST(geometry, obb);
+	ADD_TEST(geometry, obb_overlap);
+	ADD_TEST(geometry, broadphase);
+	ADD_TEST(geometry, hashgrid);
+	ADD_TEST(geometry, morton);
+	ADD_TEST(geometry, morton_sort);
+}
+
+static test_suite_t test_geometry_suite = {
+	test_geometry_application,
+	test_geometry_memory_system,
+	test_geometry_config,
+	test_geometry_declare,
+	test_geometry_initialize,
+	test_geometry_finalize,
+	0
+};
+
+#if BUILD_MONOLITHIC
+
+int
+test_geometry_run(void);
+
+int
+test_geometry_run(void) {
+	test_suite = test_geometry_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_geometry_suite;
+}
+
+#endif
@@ -0,0 +1,89 @@
+/* backend.h  -  Vector tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/* Force a specific implementation in a translation unit. Define VECTOR_TEST_BACKEND to one of the
+   VECTOR_TEST_BACKEND_* values and include this header after foundation.h and before anything
+   including vector.h. The backend can only be selected down from what the compiler targets, so
+   VECTOR_TEST_BACKEND_AVAILABLE is 0 if the requested backend is not supported by the build
+   (the translation unit then compiles the fallback implementation).
+   VECTOR_TEST_BACKEND_SYMBOL(name) appends the backend suffix to a symbol name, allowing the same
+   source to be compiled once per backend and linked into a single binary. Library functions taking
+   or returning vector_t must not be called from such a translation unit unless the backend matches
+   the one the library was built with. Without VECTOR_TEST_BACKEND defined only the backend
+   identifiers are declared. */
+
+#include <foundation/platform.h>
+
+#define VECTOR_TEST_BACKEND_FALLBACK 0
+#define VECTOR_TEST_BACKEND_SSE2     1
+#define VECTOR_TEST_BACKEND_SSE3     2
+#define VECTOR_TEST_BACKEND_SSE4     3
+
+#define VECTOR_TEST_BACKEND_COUNT    4
+
+#if defined( VECTOR_TEST_BACKEND )
+
+#if VECTOR_TEST_BACKEND == VECTOR_TEST_BACKEND_SSE4
+#  define VECTOR_TEST_BACKEND_SUFFIX _sse4
+#  if FOUNDATION_ARCH_SSE4
+#    define VECTOR_TEST_BACKEND_AVAILABLE 1
+#  else
+#    define VECTOR_TEST_BACKEND_AVAILABLE 0
+#  endif
+#elif VECTOR_TEST_BACKEND == VECTOR_TEST_BACKEND_SSE3
+#  define VECTOR_TEST_BACKEND_SUFFIX _sse3
+#  if FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE4
+#    define VECTOR_TEST_BACKEND_AVAILABLE 1
+#    undef  FOUNDATION_ARCH_SSE3
+#    define FOUNDATION_ARCH_SSE3 1
+#  else
+#    define VECTOR_TEST_BACKEND_AVAILABLE 0
+#  endif
+#  undef  FOUNDATION_ARCH_SSE4
+#  define FOUNDATION_ARCH_SSE4 0
+#elif VECTOR_TEST_BACKEND == VECTOR_TEST_BACKEND_SSE2
+#  define VECTOR_TEST_BACKEND_SUFFIX _sse2
+#  if FOUNDATION_ARCH_SSE2 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE4
+#    define VECTOR_TEST_BACKEND_AVAILABLE 1
+#    undef  FOUNDATION_ARCH_SSE2
+#    define FOUNDATION_ARCH_SSE2 1
+#  else
+#    define VECTOR_TEST_BACKEND_AVAILABLE 0
+#  endif
+#  undef  FOUNDATION_ARCH_SSE4
+#  define FOUNDATION_ARCH_SSE4 0
+#  undef  FOUNDATION_ARCH_SSE3
+#  define FOUNDATION_ARCH_SSE3 0
+#else
+#  define VECTOR_TEST_BACKEND_SUFFIX _fallback
+#  define VECTOR_TEST_BACKEND_AVAILABLE 1
+#  undef  FOUNDATION_ARCH_SSE4
+#  define FOUNDATION_ARCH_SSE4 0
+#  undef  FOUNDATION_ARCH_SSE3
+#  define FOUNDATION_ARCH_SSE3 0
+#  undef  FOUNDATION_ARCH_SSE2
+#  define FOUNDATION_ARCH_SSE2 0
+#endif
+
+//Unavailable SSE backends compile as fallback
+#undef  FOUNDATION_ARCH_NEON
+#define FOUNDATION_ARCH_NEON 0
+
+#define VECTOR_TEST_BACKEND_SYMBOL(name) FOUNDATION_PREPROCESSOR_JOIN(name, VECTOR_TEST_BACKEND_SUFFIX)
+
+#endif
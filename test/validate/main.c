@@ -0,0 +1,257 @@
+/* main.c  -  Validate tests  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <foundation/foundation.h>
+#include <test/test.h>
+
+//Validation is header only, force it in this translation unit regardless of build configuration
+#undef  VECTOR_VALIDATE
+#define VECTOR_VALIDATE 1
+
+#include <vector/vector.h>
+
+static size_t _validate_count;
+static char _validate_function[64];
+static char _validate_message[64];
+static unsigned int _validate_line;
+static bool _validate_file_match;
+
+static int
+validate_handler(hash_t context, const char* condition, size_t cond_length, const char* file, size_t file_length,
+                 unsigned int line, const char* msg, size_t msg_length) {
+	FOUNDATION_UNUSED(context);
+	//Keep the first report, an invalid argument usually gives an invalid result as well
+	if (_validate_count++)
+		return 0;
+	string_copy(_validate_function, sizeof(_validate_function), condition, cond_length);
+	string_copy(_validate_message, sizeof(_validate_message), msg, msg_length);
+	_validate_file_match = string_equal(file, file_length, STRING_CONST(__FILE__));
+	_validate_line = line;
+	return 0;
+}
+
+static void
+validate_reset(void) {
+	_validate_count = 0;
+	_validate_function[0] = 0;
+	_validate_message[0] = 0;
+	_validate_line = 0;
+	_validate_file_match = false;
+}
+
+//Bit pattern, fast math builds may fold NaN constants
+static real
+validate_nan(void) {
+	const uint32_t bits = 0x7FC00000U;
+	float32_t value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static application_t
+test_validate_application(void) {
+	application_t app;
+	memset(&app, 0, sizeof(app));
+	app.name = string_const(STRING_CONST("Validate tests"));
+	app.short_name = string_const(STRING_CONST("test_validate"));
+	app.company = string_const(STRING_CONST("Rampant Pixels"));
+	app.version = vector_module_version();
+	app.exception_handler = test_exception_handler;
+	app.flags = APPLICATION_UTILITY;
+	return app;
+}
+
+static memory_system_t
+test_validate_memory_system(void) {
+	return memory_system_malloc();
+}
+
+static foundation_config_t
+test_validate_config(void) {
+	foundation_config_t config;
+	memset(&config, 0, sizeof(config));
+	return config;
+}
+
+static int
+test_validate_initialize(void) {
+	vector_config_t config;
+	memset(&config, 0, sizeof(config));
+	return vector_module_initialize(config);
+}
+
+static void
+test_validate_finalize(void) {
+	vector_module_finalize();
+}
+
+DECLARE_TEST(validate, finite) {
+	assert_handler_fn handler = assert_handler();
+	const vector_t nan = vector(0, validate_nan(), 0, 0);
+	matrix_t m = matrix_identity();
+	vector_t v;
+	unsigned int line;
+
+	assert_set_handler(validate_handler);
+	validate_reset();
+
+	v = vector_add(vector_one(), vector_two());
+	v = vector_normalize(vector_cross3(vector_xaxis(), vector_yaxis()));
+	v = matrix_transform(matrix_mul(m, m), v);
+	EXPECT_SIZEEQ(_validate_count, 0);
+
+	line = __LINE__; v = vector_add(vector_one(), nan);
+	EXPECT_SIZEEQ(_validate_count, 2);
+	EXPECT_TRUE(string_equal(_validate_function, string_length(_validate_function), STRING_CONST("vector_add")));
+	EXPECT_TRUE(string_equal(_validate_message, string_length(_validate_message), STRING_CONST("Argument is NaN or infinite")));
+	EXPECT_TRUE(_validate_file_match);
+	EXPECT_UINTEQ(_validate_line, line);
+
+	validate_reset();
+	v = vector_div(vector_one(), vector_zero());
+	EXPECT_SIZEEQ(_validate_count, 1);
+	EXPECT_TRUE(string_equal(_validate_message, string_length(_validate_message), STRING_CONST("Result is NaN or infinite")));
+
+	validate_reset();
+	m.row[2] = nan;
+	line = __LINE__; v = matrix_rotate(m, vector_one());
+	EXPECT_SIZEEQ(_validate_count, 2);
+	EXPECT_TRUE(string_equal(_validate_function, string_length(_validate_function), STRING_CONST("matrix_rotate")));
+	EXPECT_UINTEQ(_validate_line, line);
+
+	validate_reset();
+	v = vector_scale(vector_one(), validate_nan());
+	EXPECT_SIZEGE(_validate_count, 1);
+
+	//Comparison masks are NaN bit patterns and must not be reported
+	validate_reset();
+	v = vector_select(vector_cmplt(vector_zero(), vector_one()), vector_one(), vector_two());
+	EXPECT_SIZEEQ(_validate_count, 0);
+	FOUNDATION_UNUSED(v);
+
+	assert_set_handler(handler);
+
+	return 0;
+}
+
+DECLARE_TEST(validate, slerp) {
+	assert_handler_fn handler = assert_handler();
+	const quaternion_t unit = quaternion_normalize(vector(1, 2, 3, 4));
+	quaternion_t q;
+	unsigned int line;
+
+	assert_set_handler(validate_handler);
+	validate_reset();
+
+	q = quaternion_slerp(quaternion_identity(), unit, REAL_C(0.5));
+	EXPECT_SIZEEQ(_validate_count, 0);
+
+	line = __LINE__; q = quaternion_slerp(quaternion_identity(), vector(1, 2, 3, 4), REAL_C(0.5));
+	EXPECT_SIZEEQ(_validate_count, 1);
+	EXPECT_TRUE(string_equal(_validate_function, string_length(_validate_function), STRING_CONST("quaternion_slerp")));
+	EXPECT_TRUE(string_equal(_validate_message, string_length(_validate_message), STRING_CONST("Quaternions must be unit length")));
+	EXPECT_TRUE(_validate_file_match);
+	EXPECT_UINTEQ(_validate_line, line);
+	FOUNDATION_UNUSED(q);
+
+	assert_set_handler(handler);
+
+	return 0;
+}
+
+DECLARE_TEST(validate, aligned) {
+	assert_handler_fn handler = assert_handler();
+	VECTOR_ALIGN float32_t buffer[24];
+	vector_t v;
+	matrix_t m;
+	quaternion_t q;
+	unsigned int line;
+	int i;
+
+	for (i = 0; i < 24; ++i)
+		buffer[i] = (float32_t)i;
+	assert_set_handler(validate_handler);
+	validate_reset();
+
+	v = vector_aligned(buffer);
+	m = matrix_aligned(buffer);
+	EXPECT_SIZEEQ(_validate_count, 0);
+
+	v = vector_unaligned(buffer + 1);
+	EXPECT_SIZEEQ(_validate_count, 0);
+	line = __LINE__; m = matrix_aligned(buffer + 2);
+	EXPECT_SIZEEQ(_validate_count, 1);
+	EXPECT_TRUE(string_equal(_validate_function, string_length(_validate_function), STRING_CONST("matrix_aligned")));
+	EXPECT_TRUE(string_equal(_validate_message, string_length(_validate_message), STRING_CONST("Pointer must be 16 byte aligned")));
+	EXPECT_UINTEQ(_validate_line, line);
+
+	//Misaligned loads complete after the report and read the same values as the unaligned load
+	EXPECT_TRUE(vector_equal(m.row[0], vector(2, 3, 4, 5)));
+	EXPECT_TRUE(vector_equal(m.row[3], vector(14, 15, 16, 17)));
+	v = vector_aligned(buffer + 1);
+	EXPECT_SIZEEQ(_validate_count, 2);
+	EXPECT_TRUE(vector_equal(v, vector(1, 2, 3, 4)));
+	validate_reset();
+	q = quaternion_aligned(buffer + 3);
+	EXPECT_SIZEEQ(_validate_count, 1);
+	EXPECT_TRUE(string_equal(_validate_function, string_length(_validate_function), STRING_CONST("quaternion_aligned")));
+	EXPECT_TRUE(vector_equal(q, vector(3, 4, 5, 6)));
+
+	assert_set_handler(handler);
+
+	return 0;
+}
+
+static void
+test_validate_declare(void) {
+	ADD_TEST(validate, finite);
+	ADD_TEST(validate, slerp);
+	ADD_TEST(validate, aligned);
+}
+
+static test_suite_t test_validate_suite = {
+	test_validate_application,
+	test_validate_memory_system,
+	test_validate_config,
+	test_validate_declare,
+	test_validate_initialize,
+	test_validate_finalize,
+	0
+};
+
+
+#if BUILD_MONOLITHIC
+
+int
+test_validate_run(void);
+
+int
+test_validate_run(void) {
+	test_suite = test_validate_suite;
+	return test_run_all();
+}
+
+#else
+
+test_suite_t
+test_suite_define(void);
+
+test_suite_t
+test_suite_define(void) {
+	return test_validate_suite;
+}
+
+#endif
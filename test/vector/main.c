@@ -734,6 +734,15 @@ DECLARE_TEST(vector, minmax) {
 	vec = vector_max(vector(1, 2, 3, 4), vector(2, -3, 4, -5));
 	EXPECT_VECTOREQ(vec, vector(2, 2, 4, 4));
 
+	vec = vector_abs(vector_zero());
+	EXPECT_VECTOREQ(vec, vector_zero());
+
+	vec = vector_abs(vector_uniform(-1));
+	EXPECT_VECTOREQ(vec, vector_one());
+
+	vec = vector_abs(vector(1, -2, 3, -4));
+	EXPECT_VECTOREQ(vec, vector(1, 2, 3, 4));
+
 	return 0;
 }
 
@@ -774,6 +783,256 @@ DECLARE_TEST(vector, equal) {
 	EXPECT_FALSE(vector_equal(vector_uniform(-5), vector_uniform(5)));
 	EXPECT_FALSE(vector_equal(vector(1, -2, 3, -4), vector(1, 2, 3, -4)));
 
+	EXPECT_UINTEQ(vector_equal_exact_lanes(vector(1, -2, 3, -4), vector(1, -2, 3, -4)), VECTOR_LANES_ALL);
+	EXPECT_UINTEQ(vector_equal_exact_lanes(vector(1, -2, 3, -4), vector(1, 2, 3, 4)), 0x5);
+	EXPECT_UINTEQ(vector_equal_exact_lanes(vector(0, 0, 0, 0), vector(-0.0f, 1, 0, 0)), 0xD);
+	EXPECT_TRUE(vector_equal_exact(vector(1, -2, 3, -4), vector(1, -2, 3, -4)));
+	EXPECT_FALSE(vector_equal_exact(vector(1, -2, 3, -4), vector(1, -2, 3, -4.0001f)));
+
+	EXPECT_UINTEQ(vector_equal_abs_lanes(vector(1, 2, 3, 4), vector(1.05f, 2.2f, 2.95f, 4), REAL_C(0.1)), 0xD);
+	EXPECT_TRUE(vector_equal_abs(vector(1, 2, 3, 4), vector(1.05f, 2.05f, 2.95f, 4), REAL_C(0.1)));
+	EXPECT_FALSE(vector_equal_abs(vector(1, 2, 3, 4), vector(1, 2, 3, 4.5f), REAL_C(0.1)));
+	EXPECT_TRUE(vector_equal_abs(vector(1, 2, 3, 4), vector(1, 2, 3, 4), 0));
+
+	EXPECT_UINTEQ(vector_equal_rel_lanes(vector(1000, 1, 0, -1000), vector(1001, 1.01f, 0, -1001), REAL_C(0.005)), 0xD);
+	EXPECT_TRUE(vector_equal_rel(vector(1000, 1, 0, -1000), vector(1001, 1.001f, 0, -1001), REAL_C(0.005)));
+	EXPECT_FALSE(vector_equal_rel(vector(1000, 1, 0, -1000), vector(1001, 1.001f, 0, 1000), REAL_C(0.005)));
+
+	{
+		//Build values from bits, fast math compiler flags may fold the arithmetic ones
+		union {
+			float32_t fval;
+			uint32_t uival;
+		} one, one_up, one_down, nan, tiny, inf;
+		one.fval = 1.0f;
+		one_up.uival = one.uival + 3;
+		one_down.uival = one.uival - 3;
+		nan.uival = 0x7FC00000U;
+		tiny.uival = 0x00000002U;
+		inf.uival = 0x7F800000U;
+
+		EXPECT_UINTEQ(vector_equal_ulps_lanes(vector(one.fval, one.fval, one.fval, one.fval),
+		                                      vector(one_up.fval, one_down.fval, one.fval, one.fval), 3), VECTOR_LANES_ALL);
+		EXPECT_UINTEQ(vector_equal_ulps_lanes(vector(one.fval, one.fval, one.fval, one.fval),
+		                                      vector(one_up.fval, one_down.fval, one.fval, one.fval), 2), 0xC);
+		EXPECT_UINTEQ(vector_equal_ulps_lanes(vector(0, tiny.fval, -tiny.fval, inf.fval),
+		                                      vector(-0.0f, -tiny.fval, tiny.fval, inf.fval), 4), VECTOR_LANES_ALL);
+		EXPECT_UINTEQ(vector_equal_ulps_lanes(vector(0, tiny.fval, -tiny.fval, inf.fval),
+		                                      vector(-0.0f, -tiny.fval, tiny.fval, inf.fval), 3), 0x9);
+		EXPECT_UINTEQ(vector_equal_ulps_lanes(vector(nan.fval, 1, nan.fval, -1),
+		                                      vector(nan.fval, nan.fval, 1, -1), 1000), 0x8);
+		EXPECT_UINTEQ(vector_equal_ulps_lanes(vector(-inf.fval, 1, 2, 3), vector(inf.fval, -1, -2, -3), 0x7FFFFFFF), 0x2);
+		EXPECT_TRUE(vector_equal_ulps(vector(one_up.fval, 2, 3, 4), vector(one_down.fval, 2, 3, 4), 6));
+		EXPECT_FALSE(vector_equal_ulps(vector(one_up.fval, 2, 3, 4), vector(one_down.fval, 2, 3, 4), 5));
+		EXPECT_TRUE(vector_equal(vector(one_up.fval, 2, 3, 4), vector(one_down.fval, 2, 3, 4)));
+		EXPECT_FALSE(vector_equal(vector(nan.fval, 2, 3, 4), vector(nan.fval, 2, 3, 4)));
+	}
+
+	return 0;
+}
+
+DECLARE_TEST(vector, compare) {
+	VECTOR_ALIGN vector_t a[64];
+	VECTOR_ALIGN vector_t b[64];
+	size_t indices[8];
+	size_t i;
+
+	for (i = 0; i < 64; ++i) {
+		a[i] = vector((real)i, (real)i * 2, (real)i * 3, 1);
+		b[i] = a[i];
+	}
+
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 64, 1, 0), 0);
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 32, 2, 0), 0);
+	EXPECT_SIZEEQ(vector_array_find_differing(indices, 8, a, b, 16, 4, 0), 0);
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 0, 4, 0), 0);
+
+	b[5] = vector(5, 10, 15, REAL_C(1.05));
+	b[6] = vector(6, 12, REAL_C(18.5), 1);
+	b[63] = vector(64, 126, 189, 1);
+
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 64, 1, 0), 3);
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 64, 1, REAL_C(0.1)), 2);
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 64, 1, 1), 0);
+	EXPECT_SIZEEQ(vector_array_count_differing(a, b, 63, 1, 0), 2);
+
+	EXPECT_SIZEEQ(vector_array_find_differing(indices, 8, a, b, 64, 1, 0), 3);
+	EXPECT_SIZEEQ(indices[0], 5);
+	EXPECT_SIZEEQ(indices[1], 6);
+	EXPECT_SIZEEQ(indices[2], 63);
+
+	//Elements of two vectors, changed vectors 5 and 6 fall in elements 2 and 3
+	EXPECT_SIZEEQ(vector_array_find_differing(indices, 8, a, b, 32, 2, 0), 3);
+	EXPECT_SIZEEQ(indices[0], 2);
+	EXPECT_SIZEEQ(indices[1], 3);
+	EXPECT_SIZEEQ(indices[2], 31);
+
+	//Elements of four vectors
+	EXPECT_SIZEEQ(vector_array_find_differing(indices, 8, a, b, 16, 4, 0), 2);
+	EXPECT_SIZEEQ(indices[0], 1);
+	EXPECT_SIZEEQ(indices[1], 15);
+
+	//Capacity limits stored indices but not the returned count
+	indices[1] = 0;
+	EXPECT_SIZEEQ(vector_array_find_differing(indices, 1, a, b, 64, 1, 0), 3);
+	EXPECT_SIZEEQ(indices[0], 5);
+	EXPECT_SIZEEQ(indices[1], 0);
+	EXPECT_SIZEEQ(vector_array_find_differing(0, 0, a, b, 64, 1, REAL_C(0.1)), 2);
+
+	return 0;
+}
+
+DECLARE_TEST(vector, select) {
+	const vector_t v0 = vector(1, -2, 3, -4);
+	const vector_t v1 = vector(2, -2, -3, 4);
+	vector_t mask;
+
+	EXPECT_UINTEQ(vector_movemask(vector_cmplt(v0, v1)), 0x9);
+	EXPECT_UINTEQ(vector_movemask(vector_cmple(v0, v1)), 0xB);
+	EXPECT_UINTEQ(vector_movemask(vector_cmpeq(v0, v1)), 0x2);
+	EXPECT_UINTEQ(vector_movemask(vector_cmpneq(v0, v1)), 0xD);
+	EXPECT_UINTEQ(vector_movemask(vector_cmpgt(v0, v1)), 0x4);
+	EXPECT_UINTEQ(vector_movemask(vector_cmpge(v0, v1)), 0x6);
+	EXPECT_UINTEQ(vector_movemask(v0), 0xA);
+	EXPECT_UINTEQ(vector_movemask(vector_zero()), 0);
+
+	mask = vector_cmplt(v0, v1);
+	EXPECT_VECTOREQ(vector_select(mask, v0, v1), vector(1, -2, -3, -4));
+	EXPECT_VECTOREQ(vector_select(mask, v1, v0), vector(2, -2, 3, 4));
+	EXPECT_VECTOREQ(vector_select(vector_cmpge(v0, vector_zero()), v0, vector_zero()), vector(1, 0, 3, 0));
+
+	EXPECT_UINTEQ(vector_movemask(vector_and(vector_cmple(v0, v1), vector_cmpge(v0, v1))), 0x2);
+	EXPECT_UINTEQ(vector_movemask(vector_or(vector_cmplt(v0, v1), vector_cmpgt(v0, v1))), 0xD);
+	EXPECT_UINTEQ(vector_movemask(vector_xor(vector_cmple(v0, v1), vector_cmpge(v0, v1))), 0xD);
+	EXPECT_UINTEQ(vector_movemask(vector_andnot(vector_cmple(v0, v1), vector_cmpeq(v0, v1))), 0x9);
+	mask = vector_xor(v0, vector_abs(v0));
+	EXPECT_VECTOREQ(vector_xor(v0, vector_and(vector_cmplt(v0, vector_zero()), mask)), vector_abs(v0));
+	mask = vector_cmplt(v0, v1);
+
+	EXPECT_TRUE(vector_any(mask));
+	EXPECT_FALSE(vector_all(mask));
+	EXPECT_TRUE(vector_all(vector_cmpeq(v0, v0)));
+	EXPECT_FALSE(vector_any(vector_cmpneq(v1, v1)));
+
+	EXPECT_VECTOREQ(vector_blend(v0, v1, VECTOR_BLEND_0000), v0);
+	EXPECT_VECTOREQ(vector_blend(v0, v1, VECTOR_BLEND_1111), v1);
+	EXPECT_VECTOREQ(vector_blend(v0, v1, VECTOR_BLEND_1000), vector(2, -2, 3, -4));
+	EXPECT_VECTOREQ(vector_blend(v0, v1, VECTOR_BLEND_0011), vector(1, -2, -3, 4));
+	EXPECT_VECTOREQ(vector_blend(v0, v1, VECTOR_BLEND_0101), vector(1, -2, 3, 4));
+	EXPECT_VECTOREQ(vector_blend(v0, v1, VECTOR_BLEND(0, 0, 1, 0)), vector(1, -2, -3, -4));
+
+	return 0;
+}
+
+DECLARE_TEST(vector, octahedral) {
+	VECTOR_ALIGN vector_t dir[19];
+	VECTOR_ALIGN vector_t decoded[19];
+	uint16_t packed16[19];
+	uint8_t packed24[19 * 3];
+	uint32_t packed32[19];
+	vector_t vec;
+	size_t i;
+
+	dir[0] = vector(1, 0, 0, 0);
+	dir[1] = vector(-1, 0, 0, 0);
+	dir[2] = vector(0, 1, 0, 0);
+	dir[3] = vector(0, -1, 0, 0);
+	dir[4] = vector(0, 0, 1, 0);
+	dir[5] = vector(0, 0, -1, 0);
+	dir[6] = vector(1, 1, 1, 0);
+	dir[7] = vector(-1, 1, -1, 0);
+	dir[8] = vector(1, -1, -1, 0);
+	dir[9] = vector(-1, -1, -1, 0);
+	dir[10] = vector(0, -3, 7, 0);
+	dir[11] = vector(2, 5, -9, 0);
+	dir[12] = vector(-7, 1, 0, 0);
+	dir[13] = vector(REAL_C(0.001), REAL_C(-0.002), -1, 0);
+	dir[14] = vector(-4, -2, REAL_C(0.5), 0);
+	dir[15] = vector(3, -8, -1, 0);
+	dir[16] = vector(1, 0, -1, 0);
+	dir[17] = vector(0, 1, -1, 0);
+	dir[18] = vector(-1, -2, -3, 0);
+	for (i = 0; i < 19; ++i)
+		dir[i] = vector_div(dir[i], vector_length3(dir[i]));
+
+	for (i = 0; i < 19; ++i) {
+		vec = vector_octahedral_encode(dir[i]);
+		EXPECT_TRUE(math_abs(vector_x(vec)) <= REAL_C(1.0));
+		EXPECT_TRUE(math_abs(vector_y(vec)) <= REAL_C(1.0));
+		vec = vector_octahedral_decode(vec);
+		EXPECT_VECTORALMOSTEQ(vec, dir[i]);
+	}
+
+	vector_octahedral_encode16(packed16, dir, 19);
+	vector_octahedral_decode16(decoded, packed16, 19);
+	for (i = 0; i < 19; ++i) {
+		EXPECT_TRUE(vector_x(vector_dot3(decoded[i], dir[i])) >= REAL_C(0.999));
+		EXPECT_REALEQ(vector_x(vector_length3(decoded[i])), REAL_C(1.0));
+		EXPECT_REALEQ(vector_w(decoded[i]), REAL_C(0.0));
+	}
+
+	vector_octahedral_encode24(packed24, dir, 19);
+	vector_octahedral_decode24(decoded, packed24, 19);
+	for (i = 0; i < 19; ++i)
+		EXPECT_TRUE(vector_x(vector_dot3(decoded[i], dir[i])) >= REAL_C(0.99999));
+
+	vector_octahedral_encode32(packed32, dir, 19);
+	vector_octahedral_decode32(decoded, packed32, 19);
+	for (i = 0; i < 19; ++i)
+		EXPECT_VECTORALMOSTEQ(decoded[i], dir[i]);
+
+	return 0;
+}
+
+DECLARE_TEST(vector, fpenv) {
+	volatile float32_t tiny = 1e-20f;
+	volatile float32_t one = 1.0f;
+	volatile float32_t three = 3.0f;
+	volatile float32_t third_up, third_down;
+	volatile bool denormal_kept, denormal_flushed;
+	vector_fpenv_t saved;
+	vector_fpenv_t nearest, flushed, up, down, toward_zero;
+
+	//Record results in locals and restore the environment before any check, since a failed
+	//check returns early and would leave the modified state for the following tests
+	saved = vector_fpenv_set(0, VECTOR_ROUND_NEAREST);
+	nearest = vector_fpenv_get();
+	//Product is denormal, kept without flush to zero
+	denormal_kept = (vector_x(vector_mul(vector_uniform(tiny), vector_uniform(tiny))) != 0);
+
+	vector_fpenv_set(VECTOR_FPENV_SUPPORTED_FLAGS, VECTOR_ROUND_DEFAULT);
+	flushed = vector_fpenv_get();
+	denormal_flushed = (vector_x(vector_mul(vector_uniform(tiny), vector_uniform(tiny))) == 0);
+
+	vector_fpenv_set(0, VECTOR_ROUND_UP);
+	up = vector_fpenv_get();
+	third_up = one / three;
+	vector_fpenv_set(0, VECTOR_ROUND_DOWN);
+	down = vector_fpenv_get();
+	third_down = one / three;
+	vector_fpenv_set(0, VECTOR_ROUND_TOWARD_ZERO);
+	toward_zero = vector_fpenv_get();
+
+	vector_fpenv_restore(saved);
+	EXPECT_TRUE(vector_fpenv_get().control == saved.control);
+
+	EXPECT_UINTEQ(vector_fpenv_flags(nearest), 0);
+	EXPECT_INTEQ(vector_fpenv_rounding(nearest), VECTOR_ROUND_NEAREST);
+	EXPECT_TRUE(denormal_kept);
+
+	EXPECT_UINTEQ(vector_fpenv_flags(flushed), VECTOR_FPENV_SUPPORTED_FLAGS);
+	EXPECT_INTEQ(vector_fpenv_rounding(flushed), VECTOR_ROUND_NEAREST);
+#if VECTOR_FPENV_SUPPORTED_FLAGS & VECTOR_FPENV_FLUSH_TO_ZERO
+	EXPECT_TRUE(denormal_flushed);
+#else
+	FOUNDATION_UNUSED(denormal_flushed);
+#endif
+
+	EXPECT_INTEQ(vector_fpenv_rounding(up), VECTOR_ROUND_UP);
+	EXPECT_INTEQ(vector_fpenv_rounding(down), VECTOR_ROUND_DOWN);
+	EXPECT_INTEQ(vector_fpenv_rounding(toward_zero), VECTOR_ROUND_TOWARD_ZERO);
+	EXPECT_TRUE(third_up > third_down);
+
 	return 0;
 }
 
@@ -802,6 +1061,10 @@ test_vector_declare(void) {
 	ADD_TEST(vector, minmax);
 	ADD_TEST(vector, component);
 	ADD_TEST(vector, equal);
+	ADD_TEST(vector, compare);
+	ADD_TEST(vector, select);
+	ADD_TEST(vector, octahedral);
+	ADD_TEST(vector, fpenv);
 }
 
 static test_suite_t test_vector_suite = {
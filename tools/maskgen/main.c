@@ -86,6 +86,24 @@ int main_run(void* main_arg) {
 					log_infof(HASH_TOOL, STRING_CONST("#define VECTOR_MASK_%s%s%s%s VECTOR_MASK(%d, %d, %d, %d)"),
 						element[e0], element[e1], element[e2], element[e3], e0, e1, e2, e3);
 
+	log_info(HASH_TOOL, STRING_CONST(
+	             "\n#define VECTOR_BLEND(x, y, z, w) (((w) << 3) | ((z) << 2) | ((y) << 1) | ((x)))\n\n"
+
+	             "/* Vector blend masks where the operation performed by\n"
+	             "   v2 = vector_blend(v0, v1, VECTOR_BLEND_abcd)\n"
+	             "   will be equal to\n"
+	             "   v2.x = a ? v1.x : v0.x\n"
+	             "   v2.y = b ? v1.y : v0.y\n"
+	             "   v2.z = c ? v1.z : v0.z\n"
+	             "   v2.w = d ? v1.w : v0.w */\n"));
+
+	for (int b0 = 0; b0 < 2; ++b0)
+		for (int b1 = 0; b1 < 2; ++b1)
+			for (int b2 = 0; b2 < 2; ++b2)
+				for (int b3 = 0; b3 < 2; ++b3)
+					log_infof(HASH_TOOL, STRING_CONST("#define VECTOR_BLEND_%d%d%d%d VECTOR_BLEND(%d, %d, %d, %d)"),
+						b0, b1, b2, b3, b0, b1, b2, b3);
+
 	return 0;
 }
 
@@ -0,0 +1,102 @@
+/* aabb.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/aabb.h>
+
+aabb_t
+aabb_from_points(const vector_t* points, size_t count) {
+	//Two independent accumulators to break the min/max dependency chain
+	vector_t min0 = vector_uniform(REAL_MAX);
+	vector_t max0 = vector_uniform(-REAL_MAX);
+	vector_t min1 = min0;
+	vector_t max1 = max0;
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		min0 = vector_min(min0, points[i]);
+		max0 = vector_max(max0, points[i]);
+		min1 = vector_min(min1, points[i + 1]);
+		max1 = vector_max(max1, points[i + 1]);
+	}
+	if (i < count) {
+		min0 = vector_min(min0, points[i]);
+		max0 = vector_max(max0, points[i]);
+	}
+	return aabb(vector_min(min0, min1), vector_max(max0, max1));
+}
+
+aabb_t
+aabb_array_union(const aabb_t* boxes, size_t count) {
+	vector_t min0 = vector_uniform(REAL_MAX);
+	vector_t max0 = vector_uniform(-REAL_MAX);
+	vector_t min1 = min0;
+	vector_t max1 = max0;
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		min0 = vector_min(min0, boxes[i].min);
+		max0 = vector_max(max0, boxes[i].max);
+		min1 = vector_min(min1, boxes[i + 1].min);
+		max1 = vector_max(max1, boxes[i + 1].max);
+	}
+	if (i < count) {
+		min0 = vector_min(min0, boxes[i].min);
+		max0 = vector_max(max0, boxes[i].max);
+	}
+	return aabb(vector_min(min0, min1), vector_max(max0, max1));
+}
+
+void
+aabb_array_expand(aabb_t* dst, const aabb_t* src, size_t count, const vector_t margin) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = aabb_expand(src[i], margin);
+}
+
+void
+aabb_array_transform(aabb_t* dst, const aabb_t* src, size_t count, const matrix_t* m) {
+	const matrix_t transform = *m;
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = aabb_transform(src[i], transform);
+}
+
+void
+aabb_array_transform_each(aabb_t* dst, const aabb_t* src, const matrix_t* transforms, size_t count) {
+	size_t i;
+	for (i = 0; i < count; ++i)
+		dst[i] = aabb_transform(src[i], transforms[i]);
+}
+
+void
+aabb_packet_build(aabb_packet_t* packets, const aabb_t* boxes, size_t count) {
+	const aabb_t empty = aabb_empty();
+	size_t i;
+	for (i = 0; i < count; i += 4, ++packets) {
+		matrix_t min, max;
+		int lane;
+		for (lane = 0; lane < 4; ++lane) {
+			const aabb_t* box = (i + (size_t)lane < count) ? boxes + i + lane : &empty;
+			min.row[lane] = box->min;
+			max.row[lane] = box->max;
+		}
+		min = matrix_transpose(min);
+		max = matrix_transpose(max);
+		for (lane = 0; lane < 3; ++lane) {
+			packets->min[lane] = min.row[lane];
+			packets->max[lane] = max.row[lane];
+		}
+	}
+}
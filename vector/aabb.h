@@ -0,0 +1,218 @@
+/* aabb.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file aabb.h
+    Axis-aligned bounding boxes. A box is given by its min and max corners, the w components
+    are ignored. The empty box has inverted bounds so it can be used as the initial value when
+    accumulating bounds with aabb_union and aabb_include. The array functions process boxes
+    in bulk for re-bounding of moving objects. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/matrix.h>
+
+//! Construct box from min and max corners
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb(const vector_t min, const vector_t max);
+
+//! Empty box with min at REAL_MAX and max at -REAL_MAX
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_empty(void);
+
+//! Construct box from center and half size along each axis
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_from_center(const vector_t center, const vector_t extent);
+
+//! Center of box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+aabb_center(const aabb_t box);
+
+//! Half size of box along each axis
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+aabb_extent(const aabb_t box);
+
+//! Surface area of box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
+aabb_surface_area(const aabb_t box);
+
+//! Check if box is empty, min larger than max along any axis
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_is_empty(const aabb_t box);
+
+//! Smallest box containing both boxes
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_union(const aabb_t a, const aabb_t b);
+
+//! Intersection of boxes, empty if the boxes do not overlap
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_intersect(const aabb_t a, const aabb_t b);
+
+//! Smallest box containing box and point
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_include(const aabb_t box, const vector_t point);
+
+//! Grow box by margin along each axis on both sides
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_expand(const aabb_t box, const vector_t margin);
+
+//! Check if point is inside or on the boundary of box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_contains_point(const aabb_t box, const vector_t point);
+
+//! Check if inner box is completely inside outer box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_contains(const aabb_t outer, const aabb_t inner);
+
+//! Check if boxes overlap, touching boxes overlap
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_overlap(const aabb_t a, const aabb_t b);
+
+/*! Bounds of box transformed by matrix (Arvo). The translation row is the starting point
+    and each rotation row scaled by the min and max corner component is added as the
+    smaller and larger term, which gives the exact bounds of the transformed corners
+    without transforming all eight. Matrix must be affine, box must not be empty */
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_transform(const aabb_t box, const matrix_t m);
+
+//! Bounds of array of points, empty box if count is zero
+VECTOR_API aabb_t
+aabb_from_points(const vector_t* points, size_t count);
+
+//! Union of array of boxes, empty box if count is zero
+VECTOR_API aabb_t
+aabb_array_union(const aabb_t* boxes, size_t count);
+
+//! Grow array of boxes by margin, dst and src can be the same array
+VECTOR_API void
+aabb_array_expand(aabb_t* dst, const aabb_t* src, size_t count, const vector_t margin);
+
+//! Transform array of boxes by the same matrix, dst and src can be the same array
+VECTOR_API void
+aabb_array_transform(aabb_t* dst, const aabb_t* src, size_t count, const matrix_t* m);
+
+/*! Transform array of boxes by one matrix per box, for example local bounds by world
+    transforms. dst and src can be the same array */
+VECTOR_API void
+aabb_array_transform_each(aabb_t* dst, const aabb_t* src, const matrix_t* transforms, size_t count);
+
+/*! Convert array of boxes to packets of four boxes. Packets must have room for
+    (count + 3) / 4 packets, unused lanes in the last packet are empty boxes */
+VECTOR_API void
+aabb_packet_build(aabb_packet_t* packets, const aabb_t* boxes, size_t count);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb(const vector_t min, const vector_t max) {
+	aabb_t box;
+	box.min = min;
+	box.max = max;
+	return box;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_empty(void) {
+	return aabb(vector_uniform(REAL_MAX), vector_uniform(-REAL_MAX));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_from_center(const vector_t center, const vector_t extent) {
+	return aabb(vector_sub(center, extent), vector_add(center, extent));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+aabb_center(const aabb_t box) {
+	return vector_mul(vector_add(box.min, box.max), vector_half());
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+aabb_extent(const aabb_t box) {
+	return vector_mul(vector_sub(box.max, box.min), vector_half());
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
+aabb_surface_area(const aabb_t box) {
+	//xy + yz + zx as dot product of size with rotated size
+	const vector_t size = vector_sub(box.max, box.min);
+	return REAL_C(2.0) * vector_x(vector_dot3(size, vector_shuffle(size, VECTOR_MASK_YZXW)));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_is_empty(const aabb_t box) {
+	return (vector_movemask(vector_cmpgt(box.min, box.max)) & VECTOR_LANES_XYZ) != 0;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_union(const aabb_t a, const aabb_t b) {
+	return aabb(vector_min(a.min, b.min), vector_max(a.max, b.max));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_intersect(const aabb_t a, const aabb_t b) {
+	return aabb(vector_max(a.min, b.min), vector_min(a.max, b.max));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_include(const aabb_t box, const vector_t point) {
+	return aabb(vector_min(box.min, point), vector_max(box.max, point));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_expand(const aabb_t box, const vector_t margin) {
+	return aabb(vector_sub(box.min, margin), vector_add(box.max, margin));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_contains_point(const aabb_t box, const vector_t point) {
+	const vector_t inside = vector_and(vector_cmple(box.min, point), vector_cmple(point, box.max));
+	return (vector_movemask(inside) & VECTOR_LANES_XYZ) == VECTOR_LANES_XYZ;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_contains(const aabb_t outer, const aabb_t inner) {
+	const vector_t inside = vector_and(vector_cmple(outer.min, inner.min), vector_cmple(inner.max, outer.max));
+	return (vector_movemask(inside) & VECTOR_LANES_XYZ) == VECTOR_LANES_XYZ;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+aabb_overlap(const aabb_t a, const aabb_t b) {
+	const vector_t overlap = vector_and(vector_cmple(a.min, b.max), vector_cmple(b.min, a.max));
+	return (vector_movemask(overlap) & VECTOR_LANES_XYZ) == VECTOR_LANES_XYZ;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+aabb_transform(const aabb_t box, const matrix_t m) {
+	vector_t min = m.row[3];
+	vector_t max = m.row[3];
+	vector_t lo, hi;
+
+	lo = vector_mul(m.row[0], vector_shuffle(box.min, VECTOR_MASK_XXXX));
+	hi = vector_mul(m.row[0], vector_shuffle(box.max, VECTOR_MASK_XXXX));
+	min = vector_add(min, vector_min(lo, hi));
+	max = vector_add(max, vector_max(lo, hi));
+
+	lo = vector_mul(m.row[1], vector_shuffle(box.min, VECTOR_MASK_YYYY));
+	hi = vector_mul(m.row[1], vector_shuffle(box.max, VECTOR_MASK_YYYY));
+	min = vector_add(min, vector_min(lo, hi));
+	max = vector_add(max, vector_max(lo, hi));
+
+	lo = vector_mul(m.row[2], vector_shuffle(box.min, VECTOR_MASK_ZZZZ));
+	hi = vector_mul(m.row[2], vector_shuffle(box.max, VECTOR_MASK_ZZZZ));
+	min = vector_add(min, vector_min(lo, hi));
+	max = vector_add(max, vector_max(lo, hi));
+
+	return aabb(min, max);
+}
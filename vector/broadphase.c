@@ -0,0 +1,203 @@
+/* broadphase.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/broadphase.h>
+#include <vector/internal.h>
+
+#include <stdlib.h>
+
+//Padding of the SoA arrays, four wide loads may start at the last object
+#define BROADPHASE_PADDING 4
+//Average number of shifts per object the insertion sort may use before falling back to a full sort
+#define BROADPHASE_MAX_SHIFTS 8
+
+typedef struct broadphase_key_t broadphase_key_t;
+
+struct broadphase_key_t {
+	real key;
+	uint32_t index;
+};
+
+void
+broadphase_initialize(broadphase_t* broadphase) {
+	memset(broadphase, 0, sizeof(broadphase_t));
+}
+
+void
+broadphase_finalize(broadphase_t* broadphase) {
+	memory_deallocate(broadphase->order);
+	memory_deallocate(broadphase->min_x);
+	broadphase_initialize(broadphase);
+}
+
+static void
+broadphase_reserve(broadphase_t* broadphase, size_t capacity) {
+	const size_t stride = capacity + BROADPHASE_PADDING;
+	uint32_t* order = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * capacity, 0, MEMORY_PERSISTENT);
+	real* soa = memory_allocate(HASH_VECTOR, sizeof(real) * stride * 6, 16, MEMORY_PERSISTENT);
+	if (broadphase->num_objects)
+		memcpy(order, broadphase->order, sizeof(uint32_t) * broadphase->num_objects);
+	memory_deallocate(broadphase->order);
+	memory_deallocate(broadphase->min_x);
+	broadphase->order = order;
+	broadphase->min_x = soa;
+	broadphase->max_x = soa + stride;
+	broadphase->min_y = soa + (stride * 2);
+	broadphase->max_y = soa + (stride * 3);
+	broadphase->min_z = soa + (stride * 4);
+	broadphase->max_z = soa + (stride * 5);
+	broadphase->capacity = capacity;
+}
+
+static int
+broadphase_key_compare(const void* lhs, const void* rhs) {
+	const broadphase_key_t* a = lhs;
+	const broadphase_key_t* b = rhs;
+	if (a->key != b->key)
+		return (a->key < b->key) ? -1 : 1;
+	return (a->index < b->index) ? -1 : ((a->index > b->index) ? 1 : 0);
+}
+
+static void
+broadphase_sort_full(broadphase_t* broadphase, size_t count) {
+	broadphase_key_t* keys = memory_allocate(HASH_VECTOR, sizeof(broadphase_key_t) * count, 0, MEMORY_TEMPORARY);
+	size_t i;
+	for (i = 0; i < count; ++i) {
+		keys[i].key = broadphase->min_x[i];
+		keys[i].index = broadphase->order[i];
+	}
+	qsort(keys, count, sizeof(broadphase_key_t), broadphase_key_compare);
+	for (i = 0; i < count; ++i) {
+		broadphase->min_x[i] = keys[i].key;
+		broadphase->order[i] = keys[i].index;
+	}
+	memory_deallocate(keys);
+}
+
+//Insertion sort of keys and order, false if the shift budget ran out before the keys were sorted
+static bool
+broadphase_sort_incremental(broadphase_t* broadphase, size_t count) {
+	real* key = broadphase->min_x;
+	uint32_t* order = broadphase->order;
+	size_t budget = count * BROADPHASE_MAX_SHIFTS;
+	size_t i;
+	for (i = 1; i < count; ++i) {
+		const real value = key[i];
+		const uint32_t index = order[i];
+		size_t j = i;
+		while (j && (key[j - 1] > value)) {
+			key[j] = key[j - 1];
+			order[j] = order[j - 1];
+			--j;
+		}
+		key[j] = value;
+		order[j] = index;
+		if (i - j > budget)
+			return false;
+		budget -= i - j;
+	}
+	return true;
+}
+
+void
+broadphase_update(broadphase_t* broadphase, const aabb_t* bounds, size_t count) {
+	uint32_t* order;
+	size_t num_kept = 0;
+	size_t i;
+
+	if (!broadphase->min_x || (count > broadphase->capacity)) {
+		const size_t capacity = broadphase->capacity ? broadphase->capacity * 2 : 16;
+		broadphase_reserve(broadphase, (count > capacity) ? count : capacity);
+	}
+	order = broadphase->order;
+
+	//Keep the order of remaining objects and append new objects
+	for (i = 0; i < broadphase->num_objects; ++i) {
+		if (order[i] < count)
+			order[num_kept++] = order[i];
+	}
+	for (i = broadphase->num_objects; i < count; ++i)
+		order[num_kept++] = (uint32_t)i;
+
+	for (i = 0; i < count; ++i)
+		broadphase->min_x[i] = vector_x(bounds[order[i]].min);
+	if (!broadphase_sort_incremental(broadphase, count))
+		broadphase_sort_full(broadphase, count);
+
+	for (i = 0; i < count; ++i) {
+		const aabb_t* box = bounds + order[i];
+		broadphase->max_x[i] = vector_x(box->max);
+		broadphase->min_y[i] = vector_y(box->min);
+		broadphase->max_y[i] = vector_y(box->max);
+		broadphase->min_z[i] = vector_z(box->min);
+		broadphase->max_z[i] = vector_z(box->max);
+	}
+	//Padding keeps the four wide loads of the last objects in bounds, lanes past the end are masked
+	for (i = count; i < count + BROADPHASE_PADDING; ++i) {
+		broadphase->min_x[i] = broadphase->min_y[i] = broadphase->min_z[i] = REAL_MAX;
+		broadphase->max_x[i] = broadphase->max_y[i] = broadphase->max_z[i] = -REAL_MAX;
+	}
+	broadphase->num_objects = count;
+}
+
+size_t
+broadphase_pairs(const broadphase_t* broadphase, broadphase_pair_t* pairs, size_t capacity) {
+	const uint32_t* order = broadphase->order;
+	const size_t num_objects = broadphase->num_objects;
+	size_t num_pairs = 0;
+	size_t i, j;
+
+	for (i = 0; i < num_objects; ++i) {
+		const vector_t max_x = vector_uniform(broadphase->max_x[i]);
+		const vector_t min_y = vector_uniform(broadphase->min_y[i]);
+		const vector_t max_y = vector_uniform(broadphase->max_y[i]);
+		const vector_t min_z = vector_uniform(broadphase->min_z[i]);
+		const vector_t max_z = vector_uniform(broadphase->max_z[i]);
+		const uint32_t id = order[i];
+		for (j = i + 1; j < num_objects; j += 4) {
+			//Candidates are sorted on min x, the sweep ends at the first one past max x or at the
+			//last object, since no bound value is guaranteed to stop the sweep of an unbounded box
+			const vector_t candidate = vector_cmple(vector_unaligned(broadphase->min_x + j), max_x);
+			const unsigned int lanes_valid = (num_objects - j >= 4) ? VECTOR_LANES_ALL :
+			                                 ((1U << (num_objects - j)) - 1);
+			const unsigned int lanes_x = vector_movemask(candidate) & lanes_valid;
+			vector_t overlap;
+			unsigned int lanes;
+			int lane;
+			if (!lanes_x)
+				break;
+			overlap = vector_and(vector_cmple(vector_unaligned(broadphase->min_y + j), max_y),
+			                     vector_cmple(min_y, vector_unaligned(broadphase->max_y + j)));
+			overlap = vector_and(overlap, vector_and(vector_cmple(vector_unaligned(broadphase->min_z + j), max_z),
+			                                         vector_cmple(min_z, vector_unaligned(broadphase->max_z + j))));
+			lanes = vector_movemask(overlap) & lanes_x;
+			for (lane = 0; lanes; ++lane, lanes >>= 1) {
+				if (lanes & 1) {
+					const uint32_t other = order[j + (size_t)lane];
+					if (num_pairs < capacity) {
+						pairs[num_pairs].a = (id < other) ? id : other;
+						pairs[num_pairs].b = (id < other) ? other : id;
+					}
+					++num_pairs;
+				}
+			}
+			if (lanes_x != VECTOR_LANES_ALL)
+				break;
+		}
+	}
+	return num_pairs;
+}
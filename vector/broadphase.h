@@ -0,0 +1,61 @@
+/* broadphase.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file broadphase.h
+    Sweep and prune broadphase over arrays of object bounds. The objects are sorted on the
+    min x of their bounds, and the order is kept between updates and restored with an
+    insertion sort, which is close to linear when objects move little between frames.
+    Large changes in order, for example on the first update, fall back to a full sort.
+
+    Finding pairs sweeps the sorted objects. The candidates overlapping an object on the
+    x axis are the following objects with min x up to its max x, and four candidates at a
+    time are tested on the y and z axes with SIMD compares on the sorted SoA bounds.
+
+        broadphase_t broadphase;
+        broadphase_initialize(&broadphase);
+        ...
+        broadphase_update(&broadphase, bounds, num_objects);
+        num_pairs = broadphase_pairs(&broadphase, pairs, capacity);
+        ...
+        broadphase_finalize(&broadphase);
+
+    Objects are identified by their index in the bounds array. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/aabb.h>
+
+//! Initialize empty broadphase
+VECTOR_API void
+broadphase_initialize(broadphase_t* broadphase);
+
+//! Finalize broadphase and release memory
+VECTOR_API void
+broadphase_finalize(broadphase_t* broadphase);
+
+/*! Update bounds of objects and restore sort order. Objects added since the last update,
+    indices from the previous count up to count, are inserted in order and objects past
+    count are removed. Bounds must not be empty */
+VECTOR_API void
+broadphase_update(broadphase_t* broadphase, const aabb_t* bounds, size_t count);
+
+/*! Find pairs of objects with overlapping bounds as of the last update, storing the first
+    capacity pairs. Touching bounds overlap. Returns the total number of pairs, which can
+    be larger than capacity */
+VECTOR_API size_t
+broadphase_pairs(const broadphase_t* broadphase, broadphase_pair_t* pairs, size_t capacity);
@@ -35,3 +35,27 @@
 #  define VECTOR_API extern
 #  endif
 #endif
+
+/*! Deterministic mode. When enabled all backends (fallback, SSE2, SSE3, SSE4) produce bit
+    identical results for the same inputs: reciprocal square root estimates are replaced by
+    a full precision divide, FMA contraction and the SSE4 dot product instruction are not
+    used and every backend accumulates horizontal sums in the same order. Enabled by
+    configuring the build with --deterministic, which also disables fast math compiler
+    flags. Transcendental functions (quaternion_slerp) still depend on the C library. */
+#if defined( BUILD_DETERMINISTIC ) && BUILD_DETERMINISTIC
+#  define VECTOR_DETERMINISTIC 1
+#elif !defined( VECTOR_DETERMINISTIC )
+#  define VECTOR_DETERMINISTIC 0
+#endif
+
+/*! Debug validation mode. When enabled the inline functions check arguments and results for
+    NaN and infinite components, quaternion_slerp checks that the quaternions are unit length
+    and the aligned load functions check pointer alignment, reporting failures with the call
+    site through the foundation assert handler (see validate.h). Enabled by configuring the
+    build with --validate, or by defining VECTOR_VALIDATE to 1 before including any library
+    header. Disabled builds compile no validation code. */
+#if defined( BUILD_VALIDATE ) && BUILD_VALIDATE
+#  define VECTOR_VALIDATE 1
+#elif !defined( VECTOR_VALIDATE )
+#  define VECTOR_VALIDATE 0
+#endif
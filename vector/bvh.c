@@ -0,0 +1,540 @@
+/* bvh.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/bvh.h>
+#include <vector/internal.h>
+
+#define BVH_BINS 16
+//Deeper splits use the object median, keeping the depth and traversal stack bounded
+#define BVH_MAX_DEPTH 48
+//Median splits at least halve the primitive count of 32 bit ranges below BVH_MAX_DEPTH
+#define BVH_MAX_TREE_DEPTH (BVH_MAX_DEPTH + 32)
+//Traversal keeps at most three pending siblings per level plus the children of the last node
+#define BVH_STACK_SIZE (3 * BVH_MAX_TREE_DEPTH + 4)
+
+typedef struct bvh_range_t bvh_range_t;
+typedef struct bvh_split_t bvh_split_t;
+typedef struct bvh_builder_t bvh_builder_t;
+typedef struct bvh_stack_entry_t bvh_stack_entry_t;
+
+struct bvh_range_t {
+	aabb_t bounds;
+	aabb_t centroid_bounds;
+	uint32_t begin;
+	uint32_t end;
+};
+
+struct bvh_split_t {
+	int axis;
+	int bin;
+	real min;
+	real scale;
+};
+
+struct bvh_builder_t {
+	bvh_t* bvh;
+	const aabb_t* bounds;
+	real* centroid[3];
+	unsigned int leaf_size;
+};
+
+struct bvh_stack_entry_t {
+	uint32_t child;
+	uint32_t count;
+	real tnear;
+};
+
+void
+bvh_initialize(bvh_t* bvh) {
+	memset(bvh, 0, sizeof(bvh_t));
+	bvh->bounds = aabb_empty();
+}
+
+void
+bvh_finalize(bvh_t* bvh) {
+	memory_deallocate(bvh->nodes);
+	memory_deallocate(bvh->indices);
+	bvh_initialize(bvh);
+}
+
+static FOUNDATION_FORCEINLINE int
+bvh_bin(real centroid, real min, real scale) {
+	const int bin = (int)((centroid - min) * scale);
+	return (bin < 0) ? 0 : ((bin >= BVH_BINS) ? BVH_BINS - 1 : bin);
+}
+
+static void
+bvh_range_update(const bvh_builder_t* builder, bvh_range_t* range) {
+	const uint32_t* indices = builder->bvh->indices;
+	aabb_t bounds = aabb_empty();
+	aabb_t centroid_bounds = aabb_empty();
+	uint32_t i;
+	for (i = range->begin; i < range->end; ++i) {
+		const aabb_t* box = builder->bounds + indices[i];
+		bounds = aabb_union(bounds, *box);
+		centroid_bounds = aabb_include(centroid_bounds, aabb_center(*box));
+	}
+	range->bounds = bounds;
+	range->centroid_bounds = centroid_bounds;
+}
+
+//Binned surface area heuristic over all three axes, false if no split separates the centroids
+static bool
+bvh_find_split(const bvh_builder_t* builder, const bvh_range_t* range, bvh_split_t* split) {
+	const uint32_t* indices = builder->bvh->indices;
+	aabb_t bin_bounds[3][BVH_BINS];
+	uint32_t bin_count[3][BVH_BINS];
+	real right_area[BVH_BINS];
+	uint32_t right_count[BVH_BINS];
+	real min[3], scale[3];
+	real best_cost = REAL_MAX;
+	bool found = false;
+	uint32_t i;
+	int axis, bin;
+
+	for (axis = 0; axis < 3; ++axis) {
+		const real extent = vector_component(range->centroid_bounds.max, axis) -
+		                    vector_component(range->centroid_bounds.min, axis);
+		min[axis] = vector_component(range->centroid_bounds.min, axis);
+		scale[axis] = (extent > 0) ? (real)BVH_BINS / extent : 0;
+		for (bin = 0; bin < BVH_BINS; ++bin) {
+			bin_bounds[axis][bin] = aabb_empty();
+			bin_count[axis][bin] = 0;
+		}
+	}
+
+	for (i = range->begin; i < range->end; ++i) {
+		const uint32_t primitive = indices[i];
+		for (axis = 0; axis < 3; ++axis) {
+			bin = bvh_bin(builder->centroid[axis][primitive], min[axis], scale[axis]);
+			bin_bounds[axis][bin] = aabb_union(bin_bounds[axis][bin], builder->bounds[primitive]);
+			++bin_count[axis][bin];
+		}
+	}
+
+	for (axis = 0; axis < 3; ++axis) {
+		aabb_t accumulated = aabb_empty();
+		uint32_t count = 0;
+		if (scale[axis] <= 0)
+			continue;
+		for (bin = BVH_BINS - 1; bin > 0; --bin) {
+			accumulated = aabb_union(accumulated, bin_bounds[axis][bin]);
+			count += bin_count[axis][bin];
+			right_area[bin] = count ? aabb_surface_area(accumulated) : 0;
+			right_count[bin] = count;
+		}
+		accumulated = aabb_empty();
+		count = 0;
+		for (bin = 1; bin < BVH_BINS; ++bin) {
+			accumulated = aabb_union(accumulated, bin_bounds[axis][bin - 1]);
+			count += bin_count[axis][bin - 1];
+			if (count && right_count[bin]) {
+				const real cost = (aabb_surface_area(accumulated) * (real)count) + (right_area[bin] * (real)right_count[bin]);
+				if (cost < best_cost) {
+					best_cost = cost;
+					split->axis = axis;
+					split->bin = bin;
+					split->min = min[axis];
+					split->scale = scale[axis];
+					found = true;
+				}
+			}
+		}
+	}
+	return found;
+}
+
+static uint32_t
+bvh_partition(const bvh_builder_t* builder, const bvh_range_t* range, const bvh_split_t* split) {
+	uint32_t* indices = builder->bvh->indices;
+	const real* centroid = builder->centroid[split->axis];
+	uint32_t i = range->begin;
+	uint32_t j = range->end;
+	while (i < j) {
+		if (bvh_bin(centroid[indices[i]], split->min, split->scale) < split->bin) {
+			++i;
+		}
+		else {
+			const uint32_t swap = indices[i];
+			indices[i] = indices[--j];
+			indices[j] = swap;
+		}
+	}
+	return i;
+}
+
+//Partial sort around the object median along the largest centroid axis
+static uint32_t
+bvh_partition_median(const bvh_builder_t* builder, const bvh_range_t* range) {
+	uint32_t* indices = builder->bvh->indices;
+	const vector_t extent = vector_sub(range->centroid_bounds.max, range->centroid_bounds.min);
+	const int axis = (vector_x(extent) >= vector_y(extent)) ?
+	                 ((vector_x(extent) >= vector_z(extent)) ? 0 : 2) :
+	                 ((vector_y(extent) >= vector_z(extent)) ? 1 : 2);
+	const real* centroid = builder->centroid[axis];
+	const int64_t mid = (int64_t)range->begin + ((int64_t)(range->end - range->begin) / 2);
+	int64_t lo = range->begin;
+	int64_t hi = (int64_t)range->end - 1;
+	while (lo < hi) {
+		const real pivot = centroid[indices[(lo + hi) / 2]];
+		int64_t i = lo;
+		int64_t j = hi;
+		while (i <= j) {
+			while (centroid[indices[i]] < pivot)
+				++i;
+			while (centroid[indices[j]] > pivot)
+				--j;
+			if (i <= j) {
+				const uint32_t swap = indices[i];
+				indices[i++] = indices[j];
+				indices[j--] = swap;
+			}
+		}
+		if (mid <= j)
+			hi = j;
+		else if (mid >= i)
+			lo = i;
+		else
+			break;
+	}
+	return (uint32_t)mid;
+}
+
+static void
+bvh_split(const bvh_builder_t* builder, bvh_range_t* left, bvh_range_t* right, unsigned int depth) {
+	bvh_split_t split;
+	const bvh_range_t range = *left;
+	uint32_t mid;
+	if ((depth < BVH_MAX_DEPTH) && bvh_find_split(builder, &range, &split))
+		mid = bvh_partition(builder, &range, &split);
+	else
+		mid = bvh_partition_median(builder, &range);
+	left->begin = range.begin;
+	left->end = mid;
+	right->begin = mid;
+	right->end = range.end;
+	bvh_range_update(builder, left);
+	bvh_range_update(builder, right);
+}
+
+static uint32_t
+bvh_build_node(bvh_builder_t* builder, const bvh_range_t* range, uint32_t parent, unsigned int depth) {
+	bvh_t* bvh = builder->bvh;
+	const uint32_t index = (uint32_t)bvh->num_nodes++;
+	bvh_node_t* node = bvh->nodes + index;
+	bvh_range_t child[4];
+	aabb_t child_bounds[4];
+	unsigned int num_children = 1;
+	unsigned int ichild;
+
+	//Split the child with the largest surface area until the node is full
+	child[0] = *range;
+	while (num_children < 4) {
+		real largest_area = -1;
+		int largest = -1;
+		for (ichild = 0; ichild < num_children; ++ichild) {
+			if (child[ichild].end - child[ichild].begin > builder->leaf_size) {
+				const real area = aabb_surface_area(child[ichild].bounds);
+				if (area > largest_area) {
+					largest_area = area;
+					largest = (int)ichild;
+				}
+			}
+		}
+		if (largest < 0)
+			break;
+		bvh_split(builder, child + largest, child + num_children, depth);
+		++num_children;
+	}
+
+	for (ichild = 0; ichild < num_children; ++ichild)
+		child_bounds[ichild] = child[ichild].bounds;
+	aabb_packet_build(&node->bounds, child_bounds, num_children);
+	node->lanes = (1U << num_children) - 1;
+	node->parent = parent;
+
+	for (ichild = 0; ichild < 4; ++ichild) {
+		const uint32_t count = (ichild < num_children) ? child[ichild].end - child[ichild].begin : 0;
+		if (count && (count <= builder->leaf_size)) {
+			node->child[ichild] = child[ichild].begin;
+			node->count[ichild] = (uint16_t)count;
+		}
+		else if (count) {
+			node->count[ichild] = 0;
+			node->child[ichild] = bvh_build_node(builder, child + ichild, index, depth + 1);
+		}
+		else {
+			node->child[ichild] = 0;
+			node->count[ichild] = 0;
+		}
+	}
+	return index;
+}
+
+//Union of the child bounds of a node, unused lanes hold empty boxes
+static aabb_t
+bvh_node_bounds(const bvh_node_t* node) {
+	matrix_t min, max;
+	min.row[0] = node->bounds.min[0];
+	min.row[1] = node->bounds.min[1];
+	min.row[2] = node->bounds.min[2];
+	min.row[3] = vector_zero();
+	max.row[0] = node->bounds.max[0];
+	max.row[1] = node->bounds.max[1];
+	max.row[2] = node->bounds.max[2];
+	max.row[3] = vector_zero();
+	min = matrix_transpose(min);
+	max = matrix_transpose(max);
+	return aabb(vector_min(vector_min(min.row[0], min.row[1]), vector_min(min.row[2], min.row[3])),
+	            vector_max(vector_max(max.row[0], max.row[1]), vector_max(max.row[2], max.row[3])));
+}
+
+void
+bvh_build(bvh_t* bvh, const aabb_t* bounds, size_t count, unsigned int leaf_size) {
+	bvh_builder_t builder;
+	bvh_range_t range;
+	uint32_t i;
+
+	//Every node but a single leaf root has at least two children, so count nodes are enough
+	if (bvh->num_primitives != count) {
+		bvh_finalize(bvh);
+		if (count) {
+			bvh->nodes = memory_allocate(HASH_VECTOR, sizeof(bvh_node_t) * count, 16, MEMORY_PERSISTENT);
+			bvh->indices = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * count, 0, MEMORY_PERSISTENT);
+		}
+	}
+	bvh->num_primitives = count;
+	bvh->num_nodes = 0;
+	bvh->bounds = aabb_empty();
+	if (!count)
+		return;
+
+	builder.bvh = bvh;
+	builder.bounds = bounds;
+	builder.leaf_size = (leaf_size < 1) ? 1 : ((leaf_size > BVH_MAX_LEAF_SIZE) ? BVH_MAX_LEAF_SIZE : leaf_size);
+	builder.centroid[0] = memory_allocate(HASH_VECTOR, sizeof(real) * count * 3, 0, MEMORY_TEMPORARY);
+	builder.centroid[1] = builder.centroid[0] + count;
+	builder.centroid[2] = builder.centroid[1] + count;
+	for (i = 0; i < (uint32_t)count; ++i) {
+		const vector_t center = aabb_center(bounds[i]);
+		builder.centroid[0][i] = vector_x(center);
+		builder.centroid[1][i] = vector_y(center);
+		builder.centroid[2][i] = vector_z(center);
+		bvh->indices[i] = i;
+	}
+
+	range.begin = 0;
+	range.end = (uint32_t)count;
+	bvh_range_update(&builder, &range);
+	bvh_build_node(&builder, &range, 0, 0);
+	bvh->bounds = range.bounds;
+
+	memory_deallocate(builder.centroid[0]);
+}
+
+void
+bvh_refit(bvh_t* bvh, const aabb_t* bounds) {
+	//Children have larger indices than their parent, a reverse pass is bottom up
+	size_t inode = bvh->num_nodes;
+	while (inode--) {
+		bvh_node_t* node = bvh->nodes + inode;
+		aabb_t child_bounds[4];
+		unsigned int num_children = 0;
+		while ((num_children < 4) && (node->lanes & (1U << num_children))) {
+			const uint32_t child = node->child[num_children];
+			const uint32_t count = node->count[num_children];
+			if (count) {
+				aabb_t box = bounds[bvh->indices[child]];
+				uint32_t i;
+				for (i = 1; i < count; ++i)
+					box = aabb_union(box, bounds[bvh->indices[child + i]]);
+				child_bounds[num_children] = box;
+			}
+			else {
+				child_bounds[num_children] = bvh_node_bounds(bvh->nodes + child);
+			}
+			++num_children;
+		}
+		aabb_packet_build(&node->bounds, child_bounds, num_children);
+	}
+	bvh->bounds = bvh->num_nodes ? bvh_node_bounds(bvh->nodes) : aabb_empty();
+}
+
+bool
+bvh_intersect_ray(const bvh_t* bvh, ray_hit_t* hit, const ray_t r, bvh_intersect_fn intersect, void* context) {
+	const ray_slab_t slab = ray_slab(r);
+	bvh_stack_entry_t stack[BVH_STACK_SIZE];
+	size_t depth = 0;
+	bool found = false;
+
+	if (!bvh->num_nodes)
+		return false;
+
+	stack[depth].child = 0;
+	stack[depth].count = 0;
+	stack[depth].tnear = 0;
+	++depth;
+
+	while (depth) {
+		const bvh_stack_entry_t entry = stack[--depth];
+		if (entry.tnear > hit->t)
+			continue;
+		if (entry.count) {
+			uint32_t i;
+			for (i = 0; i < entry.count; ++i) {
+				const uint32_t primitive = bvh->indices[entry.child + i];
+				if (intersect(hit, &r, primitive, context)) {
+					hit->index = primitive;
+					found = true;
+				}
+			}
+		}
+		else {
+			const bvh_node_t* node = bvh->nodes + entry.child;
+			bvh_stack_entry_t push[4];
+			vector_t tnear;
+			unsigned int lanes = ray_intersect_aabb_packet(&tnear, &slab, &node->bounds, vector_uniform(hit->t)) &
+			                     node->lanes;
+			unsigned int num_push = 0;
+			unsigned int ipush;
+			int lane;
+			//Sort hit children far to near, the nearest is popped first
+			for (lane = 0; lanes; ++lane, lanes >>= 1) {
+				if (lanes & 1) {
+					bvh_stack_entry_t child;
+					child.child = node->child[lane];
+					child.count = node->count[lane];
+					child.tnear = vector_component(tnear, lane);
+					for (ipush = num_push; ipush && (push[ipush - 1].tnear < child.tnear); --ipush)
+						push[ipush] = push[ipush - 1];
+					push[ipush] = child;
+					++num_push;
+				}
+			}
+			FOUNDATION_ASSERT(depth + num_push <= BVH_STACK_SIZE);
+			for (ipush = 0; ipush < num_push; ++ipush)
+				stack[depth++] = push[ipush];
+		}
+	}
+	return found;
+}
+
+static bool
+bvh_intersect_triangle(ray_hit_t* hit, const ray_t* r, uint32_t primitive, void* context) {
+	const triangle_t* triangles = context;
+	return ray_intersect_triangle(hit, *r, triangles + primitive);
+}
+
+bool
+bvh_intersect_triangles(const bvh_t* bvh, ray_hit_t* hit, const ray_t r, const triangle_t* triangles) {
+	return bvh_intersect_ray(bvh, hit, r, bvh_intersect_triangle, (void*)(uintptr_t)triangles);
+}
+
+static size_t
+bvh_store_leaf(const bvh_t* bvh, uint32_t* results, size_t capacity, size_t found, uint32_t first, uint32_t count) {
+	uint32_t i;
+	for (i = 0; i < count; ++i, ++found) {
+		if (found < capacity)
+			results[found] = bvh->indices[first + i];
+	}
+	return found;
+}
+
+size_t
+bvh_query_aabb(const bvh_t* bvh, uint32_t* results, size_t capacity, const aabb_t box) {
+	const vector_t min_x = vector_shuffle(box.min, VECTOR_MASK_XXXX);
+	const vector_t min_y = vector_shuffle(box.min, VECTOR_MASK_YYYY);
+	const vector_t min_z = vector_shuffle(box.min, VECTOR_MASK_ZZZZ);
+	const vector_t max_x = vector_shuffle(box.max, VECTOR_MASK_XXXX);
+	const vector_t max_y = vector_shuffle(box.max, VECTOR_MASK_YYYY);
+	const vector_t max_z = vector_shuffle(box.max, VECTOR_MASK_ZZZZ);
+	uint32_t stack[BVH_STACK_SIZE];
+	size_t depth = 0;
+	size_t found = 0;
+
+	if (!bvh->num_nodes)
+		return 0;
+
+	stack[depth++] = 0;
+	while (depth) {
+		const bvh_node_t* node = bvh->nodes + stack[--depth];
+		vector_t overlap = vector_and(vector_cmple(node->bounds.min[0], max_x), vector_cmple(min_x, node->bounds.max[0]));
+		overlap = vector_and(overlap, vector_and(vector_cmple(node->bounds.min[1], max_y),
+		                                         vector_cmple(min_y, node->bounds.max[1])));
+		overlap = vector_and(overlap, vector_and(vector_cmple(node->bounds.min[2], max_z),
+		                                         vector_cmple(min_z, node->bounds.max[2])));
+		unsigned int lanes = vector_movemask(overlap) & node->lanes;
+		int lane;
+		for (lane = 0; lanes; ++lane, lanes >>= 1) {
+			if (!(lanes & 1))
+				continue;
+			if (node->count[lane]) {
+				found = bvh_store_leaf(bvh, results, capacity, found, node->child[lane], node->count[lane]);
+			}
+			else {
+				FOUNDATION_ASSERT(depth < BVH_STACK_SIZE);
+				stack[depth++] = node->child[lane];
+			}
+		}
+	}
+	return found;
+}
+
+size_t
+bvh_query_sphere(const bvh_t* bvh, uint32_t* results, size_t capacity, const vector_t sphere) {
+	const vector_t zero = vector_zero();
+	const vector_t x = vector_shuffle(sphere, VECTOR_MASK_XXXX);
+	const vector_t y = vector_shuffle(sphere, VECTOR_MASK_YYYY);
+	const vector_t z = vector_shuffle(sphere, VECTOR_MASK_ZZZZ);
+	const vector_t radius = vector_shuffle(sphere, VECTOR_MASK_WWWW);
+	const vector_t radius_sqr = vector_mul(radius, radius);
+	//Limit on distance along an axis, keeps the squared distance to empty padding lanes finite
+	const vector_t limit = vector_uniform(REAL_C(1e18));
+	uint32_t stack[BVH_STACK_SIZE];
+	size_t depth = 0;
+	size_t found = 0;
+
+	if (!bvh->num_nodes)
+		return 0;
+
+	stack[depth++] = 0;
+	while (depth) {
+		//Squared distance from center to the closest point in each child box
+		const bvh_node_t* node = bvh->nodes + stack[--depth];
+		const vector_t dx = vector_min(vector_max(vector_max(vector_sub(node->bounds.min[0], x),
+		                                                      vector_sub(x, node->bounds.max[0])), zero), limit);
+		const vector_t dy = vector_min(vector_max(vector_max(vector_sub(node->bounds.min[1], y),
+		                                                      vector_sub(y, node->bounds.max[1])), zero), limit);
+		const vector_t dz = vector_min(vector_max(vector_max(vector_sub(node->bounds.min[2], z),
+		                                                      vector_sub(z, node->bounds.max[2])), zero), limit);
+		const vector_t dist_sqr = vector_muladd(dx, dx, vector_muladd(dy, dy, vector_mul(dz, dz)));
+		unsigned int lanes = vector_movemask(vector_cmple(dist_sqr, radius_sqr)) & node->lanes;
+		int lane;
+		for (lane = 0; lanes; ++lane, lanes >>= 1) {
+			if (!(lanes & 1))
+				continue;
+			if (node->count[lane]) {
+				found = bvh_store_leaf(bvh, results, capacity, found, node->child[lane], node->count[lane]);
+			}
+			else {
+				FOUNDATION_ASSERT(depth < BVH_STACK_SIZE);
+				stack[depth++] = node->child[lane];
+			}
+		}
+	}
+	return found;
+}
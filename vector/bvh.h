@@ -0,0 +1,77 @@
+/* bvh.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file bvh.h
+    Bounding volume hierarchy over arrays of primitive bounds. Nodes are four wide with the
+    child bounds stored as box packets, so each traversal step tests all children of a node
+    with one SIMD evaluation. The hierarchy is built top down with a binned surface area
+    heuristic, splitting the child with the largest surface area until a node has four
+    children. Below a maximum depth the split falls back to the object median, which bounds
+    the traversal stack.
+
+    For animated geometry bvh_refit updates the node bounds to new primitive bounds in one
+    bottom up pass without changing the topology. Rebuild when the refitted hierarchy has
+    degraded too much.
+
+    Queries report primitive indices. Overlap queries test the bounds of the leaves, so the
+    results are candidates to test against the actual primitives, exact for leaf size one. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/aabb.h>
+#include <vector/ray.h>
+
+//! Maximum number of primitives in a leaf
+#define BVH_MAX_LEAF_SIZE 64
+
+//! Initialize empty hierarchy
+VECTOR_API void
+bvh_initialize(bvh_t* bvh);
+
+//! Finalize hierarchy and release memory
+VECTOR_API void
+bvh_finalize(bvh_t* bvh);
+
+/*! Build hierarchy over array of primitive bounds, replacing any previous content. Leaves
+    hold at most leaf_size primitives, clamped to [1, BVH_MAX_LEAF_SIZE] */
+VECTOR_API void
+bvh_build(bvh_t* bvh, const aabb_t* bounds, size_t count, unsigned int leaf_size);
+
+//! Update node bounds to new bounds of the primitives the hierarchy was built on
+VECTOR_API void
+bvh_refit(bvh_t* bvh, const aabb_t* bounds);
+
+/*! Find closest primitive hit by ray within hit->t using the intersection callback. If a
+    primitive is hit the hit is updated with the primitive index and true returned */
+VECTOR_API bool
+bvh_intersect_ray(const bvh_t* bvh, ray_hit_t* hit, const ray_t r, bvh_intersect_fn intersect, void* context);
+
+//! Find closest triangle hit by ray, for a hierarchy built on the bounds of the triangles
+VECTOR_API bool
+bvh_intersect_triangles(const bvh_t* bvh, ray_hit_t* hit, const ray_t r, const triangle_t* triangles);
+
+/*! Find primitives in leaves overlapping box, storing the first capacity indices in results.
+    Returns the total number of primitives found, which can be larger than capacity */
+VECTOR_API size_t
+bvh_query_aabb(const bvh_t* bvh, uint32_t* results, size_t capacity, const aabb_t box);
+
+/*! Find primitives in leaves overlapping sphere [x, y, z, radius], storing the first
+    capacity indices in results. Returns the total number of primitives found, which can be
+    larger than capacity */
+VECTOR_API size_t
+bvh_query_sphere(const bvh_t* bvh, uint32_t* results, size_t capacity, const vector_t sphere);
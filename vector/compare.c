@@ -0,0 +1,52 @@
+/* compare.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+
+static FOUNDATION_FORCEINLINE bool
+compare_element_differs(const vector_t* a, const vector_t* b, size_t width, real epsilon) {
+	unsigned int lanes = VECTOR_LANES_ALL;
+	size_t iv;
+	//No early out, the lane masks of an element are cheaper to combine than to branch on
+	for (iv = 0; iv < width; ++iv)
+		lanes &= vector_equal_abs_lanes(a[iv], b[iv], epsilon);
+	return lanes != VECTOR_LANES_ALL;
+}
+
+size_t
+vector_array_count_differing(const vector_t* a, const vector_t* b, size_t count, size_t width,
+                             real epsilon) {
+	size_t differing = 0;
+	size_t ie;
+	for (ie = 0; ie < count; ++ie, a += width, b += width)
+		differing += compare_element_differs(a, b, width, epsilon) ? 1 : 0;
+	return differing;
+}
+
+size_t
+vector_array_find_differing(size_t* indices, size_t capacity, const vector_t* a, const vector_t* b,
+                            size_t count, size_t width, real epsilon) {
+	size_t differing = 0;
+	size_t ie;
+	for (ie = 0; ie < count; ++ie, a += width, b += width) {
+		if (compare_element_differs(a, b, width, epsilon)) {
+			if (differing < capacity)
+				indices[differing] = ie;
+			++differing;
+		}
+	}
+	return differing;
+}
@@ -0,0 +1,38 @@
+/* compare.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file compare.h
+    Batch comparison of vector arrays for change detection. Arrays are treated as elements
+    of width consecutive vectors (for example 2 for transform_t, 4 for matrix_t), and an
+    element differs if any component of any of its vectors differs by more than epsilon
+    (see vector_equal_abs_lanes, a zero epsilon gives exact comparison). NaN components
+    always differ. */
+
+#include <vector/types.h>
+
+//! Count differing elements in arrays of count elements of width vectors each
+VECTOR_API size_t
+vector_array_count_differing(const vector_t* a, const vector_t* b, size_t count, size_t width,
+                             real epsilon);
+
+/*! Find differing elements in arrays of count elements of width vectors each, storing the
+    indices of the first capacity differing elements in increasing order. Returns the total
+    number of differing elements, which can be larger than capacity */
+VECTOR_API size_t
+vector_array_find_differing(size_t* indices, size_t capacity, const vector_t* a, const vector_t* b,
+                            size_t count, size_t width, real epsilon);
@@ -0,0 +1,233 @@
+/* fpenv.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file fpenv.h
+    Floating point environment control. Denormal handling (FTZ/DAZ) and rounding mode are
+    per-thread processor state, so worker threads and batch kernels should save and restore
+    the state around their work:
+
+        const vector_fpenv_t saved = vector_fpenv_set(VECTOR_FPENV_FLUSH_TO_ZERO |
+                                                      VECTOR_FPENV_DENORMALS_ARE_ZERO,
+                                                      VECTOR_ROUND_DEFAULT);
+        ...
+        vector_fpenv_restore(saved);
+
+    On x86 the SSE control register (MXCSR) is used, on ARM64 the FPCR where flush to zero
+    covers both inputs and outputs. Other architectures only support the rounding mode. */
+
+#include <vector/types.h>
+
+#if FOUNDATION_ARCH_SSE2 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_X86_64
+#  include <xmmintrin.h>
+#  define VECTOR_FPENV_MXCSR 1
+#  define VECTOR_FPENV_FPCR 0
+#elif FOUNDATION_ARCH_ARM_64 && ( FOUNDATION_COMPILER_GCC || FOUNDATION_COMPILER_CLANG )
+#  define VECTOR_FPENV_MXCSR 0
+#  define VECTOR_FPENV_FPCR 1
+#else
+#  include <fenv.h>
+#  define VECTOR_FPENV_MXCSR 0
+#  define VECTOR_FPENV_FPCR 0
+#endif
+
+//! VECTOR_FPENV_* flags which can be controlled on this architecture
+#if VECTOR_FPENV_MXCSR || VECTOR_FPENV_FPCR
+#  define VECTOR_FPENV_SUPPORTED_FLAGS (VECTOR_FPENV_FLUSH_TO_ZERO | VECTOR_FPENV_DENORMALS_ARE_ZERO)
+#else
+#  define VECTOR_FPENV_SUPPORTED_FLAGS 0U
+#endif
+
+//! Get floating point control state of calling thread
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_get(void);
+
+/*! Set denormal handling and rounding mode of calling thread. Flags not given are cleared,
+    VECTOR_ROUND_DEFAULT keeps the current rounding mode. Returns the previous state to
+    pass to vector_fpenv_restore */
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_set(unsigned int flags, vector_rounding_t rounding);
+
+//! Restore floating point control state previously returned by vector_fpenv_get or vector_fpenv_set
+static FOUNDATION_FORCEINLINE void
+vector_fpenv_restore(const vector_fpenv_t env);
+
+//! Get VECTOR_FPENV_* flags enabled in state
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_fpenv_flags(const vector_fpenv_t env);
+
+//! Get rounding mode of state
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_rounding_t
+vector_fpenv_rounding(const vector_fpenv_t env);
+
+/*! Apply the floating point settings given in the module configuration to the calling
+    thread, for worker threads. Returns the previous state to pass to vector_fpenv_restore */
+VECTOR_API vector_fpenv_t
+vector_fpenv_apply_config(void);
+
+#if VECTOR_FPENV_MXCSR
+
+#define VECTOR_MXCSR_FLUSH_TO_ZERO      0x8000U
+#define VECTOR_MXCSR_DENORMALS_ARE_ZERO 0x0040U
+#define VECTOR_MXCSR_ROUND_MASK         0x6000U
+#define VECTOR_MXCSR_ROUND_SHIFT        13
+
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_get(void) {
+	vector_fpenv_t env;
+	env.control = _mm_getcsr();
+	return env;
+}
+
+static FOUNDATION_FORCEINLINE void
+vector_fpenv_restore(const vector_fpenv_t env) {
+	_mm_setcsr((unsigned int)env.control);
+}
+
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_set(unsigned int flags, vector_rounding_t rounding) {
+	//Rounding control field order is nearest, down, up, toward zero
+	const vector_fpenv_t prev = vector_fpenv_get();
+	unsigned int csr = (unsigned int)prev.control & ~(VECTOR_MXCSR_FLUSH_TO_ZERO | VECTOR_MXCSR_DENORMALS_ARE_ZERO);
+	if (flags & VECTOR_FPENV_FLUSH_TO_ZERO)
+		csr |= VECTOR_MXCSR_FLUSH_TO_ZERO;
+	if (flags & VECTOR_FPENV_DENORMALS_ARE_ZERO)
+		csr |= VECTOR_MXCSR_DENORMALS_ARE_ZERO;
+	if (rounding != VECTOR_ROUND_DEFAULT)
+		csr = (csr & ~VECTOR_MXCSR_ROUND_MASK) | ((unsigned int)(rounding - VECTOR_ROUND_NEAREST) << VECTOR_MXCSR_ROUND_SHIFT);
+	_mm_setcsr(csr);
+	return prev;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_fpenv_flags(const vector_fpenv_t env) {
+	return ((env.control & VECTOR_MXCSR_FLUSH_TO_ZERO) ? VECTOR_FPENV_FLUSH_TO_ZERO : 0) |
+	       ((env.control & VECTOR_MXCSR_DENORMALS_ARE_ZERO) ? VECTOR_FPENV_DENORMALS_ARE_ZERO : 0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_rounding_t
+vector_fpenv_rounding(const vector_fpenv_t env) {
+	return (vector_rounding_t)(VECTOR_ROUND_NEAREST + ((env.control & VECTOR_MXCSR_ROUND_MASK) >> VECTOR_MXCSR_ROUND_SHIFT));
+}
+
+#elif VECTOR_FPENV_FPCR
+
+#define VECTOR_FPCR_FLUSH_TO_ZERO 0x01000000U
+#define VECTOR_FPCR_ROUND_MASK    0x00C00000U
+#define VECTOR_FPCR_ROUND_SHIFT   22
+
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_get(void) {
+	vector_fpenv_t env;
+	__asm__ __volatile__("mrs %0, fpcr" : "=r"(env.control));
+	return env;
+}
+
+static FOUNDATION_FORCEINLINE void
+vector_fpenv_restore(const vector_fpenv_t env) {
+	__asm__ __volatile__("msr fpcr, %0" : : "r"(env.control));
+}
+
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_set(unsigned int flags, vector_rounding_t rounding) {
+	//Rounding field order is nearest, up, down, toward zero
+	static const uint64_t rmode[] = { 0, 0, 2, 1, 3 };
+	const vector_fpenv_t prev = vector_fpenv_get();
+	vector_fpenv_t env = prev;
+	if (flags & (VECTOR_FPENV_FLUSH_TO_ZERO | VECTOR_FPENV_DENORMALS_ARE_ZERO))
+		env.control |= VECTOR_FPCR_FLUSH_TO_ZERO;
+	else
+		env.control &= ~(uint64_t)VECTOR_FPCR_FLUSH_TO_ZERO;
+	if (rounding != VECTOR_ROUND_DEFAULT)
+		env.control = (env.control & ~(uint64_t)VECTOR_FPCR_ROUND_MASK) | (rmode[rounding] << VECTOR_FPCR_ROUND_SHIFT);
+	vector_fpenv_restore(env);
+	return prev;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_fpenv_flags(const vector_fpenv_t env) {
+	return (env.control & VECTOR_FPCR_FLUSH_TO_ZERO) ?
+	       (VECTOR_FPENV_FLUSH_TO_ZERO | VECTOR_FPENV_DENORMALS_ARE_ZERO) : 0;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_rounding_t
+vector_fpenv_rounding(const vector_fpenv_t env) {
+	static const vector_rounding_t mode[] = {
+		VECTOR_ROUND_NEAREST, VECTOR_ROUND_UP, VECTOR_ROUND_DOWN, VECTOR_ROUND_TOWARD_ZERO
+	};
+	return mode[(env.control & VECTOR_FPCR_ROUND_MASK) >> VECTOR_FPCR_ROUND_SHIFT];
+}
+
+#else
+
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_get(void) {
+	vector_fpenv_t env;
+	env.control = (uint64_t)(int64_t)fegetround();
+	return env;
+}
+
+static FOUNDATION_FORCEINLINE void
+vector_fpenv_restore(const vector_fpenv_t env) {
+	fesetround((int)(int64_t)env.control);
+}
+
+static FOUNDATION_FORCEINLINE vector_fpenv_t
+vector_fpenv_set(unsigned int flags, vector_rounding_t rounding) {
+	const vector_fpenv_t prev = vector_fpenv_get();
+	FOUNDATION_UNUSED(flags);
+	switch (rounding) {
+	case VECTOR_ROUND_NEAREST: fesetround(FE_TONEAREST); break;
+#ifdef FE_DOWNWARD
+	case VECTOR_ROUND_DOWN: fesetround(FE_DOWNWARD); break;
+#endif
+#ifdef FE_UPWARD
+	case VECTOR_ROUND_UP: fesetround(FE_UPWARD); break;
+#endif
+#ifdef FE_TOWARDZERO
+	case VECTOR_ROUND_TOWARD_ZERO: fesetround(FE_TOWARDZERO); break;
+#endif
+	default: break;
+	}
+	return prev;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_fpenv_flags(const vector_fpenv_t env) {
+	FOUNDATION_UNUSED(env);
+	return 0;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_rounding_t
+vector_fpenv_rounding(const vector_fpenv_t env) {
+	const int mode = (int)(int64_t)env.control;
+#ifdef FE_DOWNWARD
+	if (mode == FE_DOWNWARD)
+		return VECTOR_ROUND_DOWN;
+#endif
+#ifdef FE_UPWARD
+	if (mode == FE_UPWARD)
+		return VECTOR_ROUND_UP;
+#endif
+#ifdef FE_TOWARDZERO
+	if (mode == FE_TOWARDZERO)
+		return VECTOR_ROUND_TOWARD_ZERO;
+#endif
+	return VECTOR_ROUND_NEAREST;
+}
+
+#endif
@@ -0,0 +1,170 @@
+/* frustum.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/frustum.h>
+
+frustum_t
+frustum_from_matrix(const matrix_t view_projection, bool depth_zero_to_one) {
+	//Clip space coordinates are the dot products of the point with the matrix columns,
+	//each plane is the w column plus or minus the column of the clipped coordinate
+	const matrix_t columns = matrix_transpose(view_projection);
+	vector_t plane[6];
+	FOUNDATION_ALIGN(16) float32_t component[4][8];
+	frustum_t frustum;
+	int i;
+
+	plane[0] = vector_add(columns.row[3], columns.row[0]);
+	plane[1] = vector_sub(columns.row[3], columns.row[0]);
+	plane[2] = vector_add(columns.row[3], columns.row[1]);
+	plane[3] = vector_sub(columns.row[3], columns.row[1]);
+	plane[4] = depth_zero_to_one ? columns.row[2] : vector_add(columns.row[3], columns.row[2]);
+	plane[5] = vector_sub(columns.row[3], columns.row[2]);
+
+	for (i = 0; i < 8; ++i) {
+		const vector_t normalized = vector_div(plane[(i < 6) ? i : 5], vector_length3(plane[(i < 6) ? i : 5]));
+		component[0][i] = vector_x(normalized);
+		component[1][i] = vector_y(normalized);
+		component[2][i] = vector_z(normalized);
+		component[3][i] = vector_w(normalized);
+	}
+	for (i = 0; i < 2; ++i) {
+		frustum.x[i] = vector_aligned(component[0] + (i * 4));
+		frustum.y[i] = vector_aligned(component[1] + (i * 4));
+		frustum.z[i] = vector_aligned(component[2] + (i * 4));
+		frustum.d[i] = vector_aligned(component[3] + (i * 4));
+	}
+	return frustum;
+}
+
+plane_t
+frustum_plane(const frustum_t* frustum, unsigned int i) {
+	const int lane = (int)(i & 3);
+	const unsigned int half = (i >> 2) & 1;
+	return vector(vector_component(frustum->x[half], lane), vector_component(frustum->y[half], lane),
+	              vector_component(frustum->z[half], lane), vector_component(frustum->d[half], lane));
+}
+
+//Broadcast each of the six planes in the SoA components to all lanes
+static FOUNDATION_FORCEINLINE void
+frustum_splat(vector_t* splat, const vector_t* soa) {
+	splat[0] = vector_shuffle(soa[0], VECTOR_MASK_XXXX);
+	splat[1] = vector_shuffle(soa[0], VECTOR_MASK_YYYY);
+	splat[2] = vector_shuffle(soa[0], VECTOR_MASK_ZZZZ);
+	splat[3] = vector_shuffle(soa[0], VECTOR_MASK_WWWW);
+	splat[4] = vector_shuffle(soa[1], VECTOR_MASK_XXXX);
+	splat[5] = vector_shuffle(soa[1], VECTOR_MASK_YYYY);
+}
+
+//Append the indices of the set lanes in visible lane mask, branch free
+static FOUNDATION_FORCEINLINE size_t
+frustum_compact(uint32_t* visible, size_t count, unsigned int lanes, uint32_t index) {
+	visible[count] = index;
+	count += lanes & 1;
+	visible[count] = index + 1;
+	count += (lanes >> 1) & 1;
+	visible[count] = index + 2;
+	count += (lanes >> 2) & 1;
+	visible[count] = index + 3;
+	count += (lanes >> 3) & 1;
+	return count;
+}
+
+size_t
+frustum_cull_spheres(uint32_t* visible, const frustum_t* frustum, const vector_t* spheres, size_t count) {
+	vector_t px[6], py[6], pz[6], pd[6];
+	size_t num_visible = 0;
+	size_t i = 0;
+	int ip;
+
+	frustum_splat(px, frustum->x);
+	frustum_splat(py, frustum->y);
+	frustum_splat(pz, frustum->z);
+	frustum_splat(pd, frustum->d);
+
+	for (; i + 4 <= count; i += 4) {
+		matrix_t soa;
+		vector_t radius;
+		vector_t outside = vector_zero();
+		soa.row[0] = spheres[i];
+		soa.row[1] = spheres[i + 1];
+		soa.row[2] = spheres[i + 2];
+		soa.row[3] = spheres[i + 3];
+		soa = matrix_transpose(soa);
+		radius = vector_neg(soa.row[3]);
+		for (ip = 0; ip < 6; ++ip) {
+			vector_t dist = vector_muladd(px[ip], soa.row[0], pd[ip]);
+			dist = vector_muladd(py[ip], soa.row[1], dist);
+			dist = vector_muladd(pz[ip], soa.row[2], dist);
+			outside = vector_or(outside, vector_cmplt(dist, radius));
+		}
+		num_visible = frustum_compact(visible, num_visible, ~vector_movemask(outside) & VECTOR_LANES_ALL, (uint32_t)i);
+	}
+	for (; i < count; ++i) {
+		if (frustum_test_sphere(frustum, spheres[i]))
+			visible[num_visible++] = (uint32_t)i;
+	}
+	return num_visible;
+}
+
+size_t
+frustum_cull_aabbs(uint32_t* visible, const frustum_t* frustum, const aabb_t* boxes, size_t count) {
+	vector_t px[6], py[6], pz[6], pd[6];
+	vector_t ax[6], ay[6], az[6];
+	size_t num_visible = 0;
+	size_t i = 0;
+	int ip;
+
+	frustum_splat(px, frustum->x);
+	frustum_splat(py, frustum->y);
+	frustum_splat(pz, frustum->z);
+	frustum_splat(pd, frustum->d);
+	for (ip = 0; ip < 6; ++ip) {
+		ax[ip] = vector_abs(px[ip]);
+		ay[ip] = vector_abs(py[ip]);
+		az[ip] = vector_abs(pz[ip]);
+	}
+
+	for (; i + 4 <= count; i += 4) {
+		matrix_t center, extent;
+		vector_t outside = vector_zero();
+		center.row[0] = aabb_center(boxes[i]);
+		center.row[1] = aabb_center(boxes[i + 1]);
+		center.row[2] = aabb_center(boxes[i + 2]);
+		center.row[3] = aabb_center(boxes[i + 3]);
+		extent.row[0] = aabb_extent(boxes[i]);
+		extent.row[1] = aabb_extent(boxes[i + 1]);
+		extent.row[2] = aabb_extent(boxes[i + 2]);
+		extent.row[3] = aabb_extent(boxes[i + 3]);
+		center = matrix_transpose(center);
+		extent = matrix_transpose(extent);
+		for (ip = 0; ip < 6; ++ip) {
+			vector_t dist = vector_muladd(px[ip], center.row[0], pd[ip]);
+			vector_t radius = vector_mul(ax[ip], extent.row[0]);
+			dist = vector_muladd(py[ip], center.row[1], dist);
+			radius = vector_muladd(ay[ip], extent.row[1], radius);
+			dist = vector_muladd(pz[ip], center.row[2], dist);
+			radius = vector_muladd(az[ip], extent.row[2], radius);
+			outside = vector_or(outside, vector_cmplt(dist, vector_neg(radius)));
+		}
+		num_visible = frustum_compact(visible, num_visible, ~vector_movemask(outside) & VECTOR_LANES_ALL, (uint32_t)i);
+	}
+	for (; i < count; ++i) {
+		if (frustum_test_aabb(frustum, boxes[i]))
+			visible[num_visible++] = (uint32_t)i;
+	}
+	return num_visible;
+}
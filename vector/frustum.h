@@ -0,0 +1,102 @@
+/* frustum.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file frustum.h
+    View frustum culling. The frustum is extracted from a view-projection matrix (Gribb and
+    Hartmann) and stored with the six planes in SoA form, so a single sphere or box is tested
+    against all planes with two vector evaluations. The array functions test four objects at
+    a time against each plane and write the indices of the visible objects in increasing
+    order to a compacted list.
+
+    Spheres are given as [x, y, z, radius] vectors. Tests are conservative, objects
+    intersecting the frustum are visible, and boxes close to the frustum corners can be
+    reported visible even if outside. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/aabb.h>
+
+/*! Extract frustum from view-projection matrix. Matrix is row-major and transforms row
+    vectors as in matrix_transform. If depth_zero_to_one is set the clip space depth range
+    is [0, w] (Direct3D, Vulkan, Metal), otherwise [-w, w] (OpenGL) */
+VECTOR_API frustum_t
+frustum_from_matrix(const matrix_t view_projection, bool depth_zero_to_one);
+
+//! Get plane i, 0 <= i < 6, as [nx, ny, nz, d]
+VECTOR_API plane_t
+frustum_plane(const frustum_t* frustum, unsigned int i);
+
+//! Check if sphere [x, y, z, radius] is inside or intersecting frustum
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL bool
+frustum_test_sphere(const frustum_t* frustum, const vector_t sphere);
+
+//! Check if box is inside or intersecting frustum
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL bool
+frustum_test_aabb(const frustum_t* frustum, const aabb_t box);
+
+/*! Cull array of spheres [x, y, z, radius], storing indices of visible spheres in visible
+    which must have room for count indices. Returns number of visible spheres */
+VECTOR_API size_t
+frustum_cull_spheres(uint32_t* visible, const frustum_t* frustum, const vector_t* spheres, size_t count);
+
+/*! Cull array of boxes, storing indices of visible boxes in visible which must have room
+    for count indices. Returns number of visible boxes */
+VECTOR_API size_t
+frustum_cull_aabbs(uint32_t* visible, const frustum_t* frustum, const aabb_t* boxes, size_t count);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL bool
+frustum_test_sphere(const frustum_t* frustum, const vector_t sphere) {
+	const vector_t x = vector_shuffle(sphere, VECTOR_MASK_XXXX);
+	const vector_t y = vector_shuffle(sphere, VECTOR_MASK_YYYY);
+	const vector_t z = vector_shuffle(sphere, VECTOR_MASK_ZZZZ);
+	const vector_t radius = vector_neg(vector_shuffle(sphere, VECTOR_MASK_WWWW));
+	vector_t dist0 = vector_muladd(frustum->x[0], x, frustum->d[0]);
+	vector_t dist1 = vector_muladd(frustum->x[1], x, frustum->d[1]);
+	dist0 = vector_muladd(frustum->y[0], y, dist0);
+	dist1 = vector_muladd(frustum->y[1], y, dist1);
+	dist0 = vector_muladd(frustum->z[0], z, dist0);
+	dist1 = vector_muladd(frustum->z[1], z, dist1);
+	return !vector_any(vector_or(vector_cmplt(dist0, radius), vector_cmplt(dist1, radius)));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL bool
+frustum_test_aabb(const frustum_t* frustum, const aabb_t box) {
+	//Distance of center and projected radius of extent on each plane normal
+	const vector_t center = aabb_center(box);
+	const vector_t extent = aabb_extent(box);
+	const vector_t cx = vector_shuffle(center, VECTOR_MASK_XXXX);
+	const vector_t cy = vector_shuffle(center, VECTOR_MASK_YYYY);
+	const vector_t cz = vector_shuffle(center, VECTOR_MASK_ZZZZ);
+	const vector_t ex = vector_shuffle(extent, VECTOR_MASK_XXXX);
+	const vector_t ey = vector_shuffle(extent, VECTOR_MASK_YYYY);
+	const vector_t ez = vector_shuffle(extent, VECTOR_MASK_ZZZZ);
+	vector_t dist0 = vector_muladd(frustum->x[0], cx, frustum->d[0]);
+	vector_t dist1 = vector_muladd(frustum->x[1], cx, frustum->d[1]);
+	vector_t radius0 = vector_mul(vector_abs(frustum->x[0]), ex);
+	vector_t radius1 = vector_mul(vector_abs(frustum->x[1]), ex);
+	dist0 = vector_muladd(frustum->y[0], cy, dist0);
+	dist1 = vector_muladd(frustum->y[1], cy, dist1);
+	radius0 = vector_muladd(vector_abs(frustum->y[0]), ey, radius0);
+	radius1 = vector_muladd(vector_abs(frustum->y[1]), ey, radius1);
+	dist0 = vector_muladd(frustum->z[0], cz, dist0);
+	dist1 = vector_muladd(frustum->z[1], cz, dist1);
+	radius0 = vector_muladd(vector_abs(frustum->z[0]), ez, radius0);
+	radius1 = vector_muladd(vector_abs(frustum->z[1]), ez, radius1);
+	return !vector_any(vector_or(vector_cmplt(dist0, vector_neg(radius0)),
+	                             vector_cmplt(dist1, vector_neg(radius1))));
+}
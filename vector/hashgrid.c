@@ -0,0 +1,209 @@
+/* hashgrid.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/hashgrid.h>
+#include <vector/internal.h>
+
+//Cell coordinates are packed in 21 bits each, wrapping far outside any practical range
+#define HASHGRID_COORD_BITS 21
+#define HASHGRID_COORD_MASK ((1ULL << HASHGRID_COORD_BITS) - 1)
+#define HASHGRID_MIN_BUCKET_BITS 4
+
+void
+hashgrid_initialize(hashgrid_t* grid, real cell_size) {
+	memset(grid, 0, sizeof(hashgrid_t));
+	grid->cell_size = cell_size;
+	grid->inv_cell_size = REAL_C(1.0) / cell_size;
+}
+
+void
+hashgrid_finalize(hashgrid_t* grid) {
+	const real cell_size = grid->cell_size;
+	memory_deallocate(grid->bucket_start);
+	memory_deallocate(grid->indices);
+	memory_deallocate(grid->cells);
+	memory_deallocate(grid->points);
+	memory_deallocate(grid->source_cells);
+	memory_deallocate(grid->histogram);
+	hashgrid_initialize(grid, cell_size);
+}
+
+static FOUNDATION_FORCEINLINE int32_t
+hashgrid_floor(real value) {
+	const int32_t truncated = (int32_t)value;
+	return ((real)truncated > value) ? truncated - 1 : truncated;
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+hashgrid_pack(int32_t x, int32_t y, int32_t z) {
+	return ((uint64_t)(uint32_t)x & HASHGRID_COORD_MASK) |
+	       (((uint64_t)(uint32_t)y & HASHGRID_COORD_MASK) << HASHGRID_COORD_BITS) |
+	       (((uint64_t)(uint32_t)z & HASHGRID_COORD_MASK) << (HASHGRID_COORD_BITS * 2));
+}
+
+static FOUNDATION_FORCEINLINE uint64_t
+hashgrid_cell(const hashgrid_t* grid, const vector_t point) {
+	const vector_t scaled = vector_mul(point, vector_uniform(grid->inv_cell_size));
+	return hashgrid_pack(hashgrid_floor(vector_x(scaled)), hashgrid_floor(vector_y(scaled)),
+	                     hashgrid_floor(vector_z(scaled)));
+}
+
+//Fibonacci hashing, the top bits of the product are well mixed
+static FOUNDATION_FORCEINLINE uint32_t
+hashgrid_bucket(const hashgrid_t* grid, uint64_t cell) {
+	return (uint32_t)((cell * 0x9E3779B97F4A7C15ULL) >> (64 - grid->bucket_bits));
+}
+
+static FOUNDATION_FORCEINLINE void
+hashgrid_task_range(const hashgrid_t* grid, unsigned int task, size_t* begin, size_t* end) {
+	*begin = (grid->num_points * task) / grid->num_tasks;
+	*end = (grid->num_points * (task + 1)) / grid->num_tasks;
+}
+
+void
+hashgrid_build_begin(hashgrid_t* grid, const vector_t* points, size_t count, unsigned int num_tasks) {
+	unsigned int bucket_bits = HASHGRID_MIN_BUCKET_BITS;
+	size_t num_buckets;
+	while (((size_t)1 << bucket_bits) < count)
+		++bucket_bits;
+	num_buckets = (size_t)1 << bucket_bits;
+	num_tasks = (num_tasks < 1) ? 1 : ((num_tasks > HASHGRID_MAX_TASKS) ? HASHGRID_MAX_TASKS : num_tasks);
+
+	if (count > grid->capacity) {
+		memory_deallocate(grid->indices);
+		memory_deallocate(grid->cells);
+		memory_deallocate(grid->points);
+		memory_deallocate(grid->source_cells);
+		grid->indices = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * count, 0, MEMORY_PERSISTENT);
+		grid->cells = memory_allocate(HASH_VECTOR, sizeof(uint64_t) * count, 0, MEMORY_PERSISTENT);
+		grid->points = memory_allocate(HASH_VECTOR, sizeof(vector_t) * count, 16, MEMORY_PERSISTENT);
+		grid->source_cells = memory_allocate(HASH_VECTOR, sizeof(uint64_t) * count, 0, MEMORY_PERSISTENT);
+		grid->capacity = count;
+	}
+	if ((num_buckets > grid->bucket_capacity) || (num_tasks != grid->num_tasks) || !grid->bucket_start) {
+		const size_t bucket_capacity = (num_buckets > grid->bucket_capacity) ? num_buckets : grid->bucket_capacity;
+		memory_deallocate(grid->bucket_start);
+		memory_deallocate(grid->histogram);
+		grid->bucket_start = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * (bucket_capacity + 1), 0,
+		                                     MEMORY_PERSISTENT);
+		grid->histogram = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * bucket_capacity * num_tasks, 0,
+		                                  MEMORY_PERSISTENT);
+		grid->bucket_capacity = bucket_capacity;
+	}
+
+	grid->bucket_bits = bucket_bits;
+	grid->num_buckets = num_buckets;
+	grid->num_tasks = num_tasks;
+	grid->num_points = count;
+	grid->source = points;
+}
+
+void
+hashgrid_build_count(hashgrid_t* grid, unsigned int task) {
+	uint32_t* histogram = grid->histogram + (grid->num_buckets * task);
+	size_t begin, end, i;
+	hashgrid_task_range(grid, task, &begin, &end);
+	memset(histogram, 0, sizeof(uint32_t) * grid->num_buckets);
+	for (i = begin; i < end; ++i) {
+		const uint64_t cell = hashgrid_cell(grid, grid->source[i]);
+		grid->source_cells[i] = cell;
+		++histogram[hashgrid_bucket(grid, cell)];
+	}
+}
+
+void
+hashgrid_build_prefix(hashgrid_t* grid) {
+	//Buckets are ordered by task within each bucket, turning the histograms into offsets
+	const size_t num_buckets = grid->num_buckets;
+	uint32_t offset = 0;
+	size_t bucket;
+	unsigned int task;
+	for (bucket = 0; bucket < num_buckets; ++bucket) {
+		grid->bucket_start[bucket] = offset;
+		for (task = 0; task < grid->num_tasks; ++task) {
+			uint32_t* histogram = grid->histogram + (num_buckets * task) + bucket;
+			const uint32_t count = *histogram;
+			*histogram = offset;
+			offset += count;
+		}
+	}
+	grid->bucket_start[num_buckets] = offset;
+}
+
+void
+hashgrid_build_scatter(hashgrid_t* grid, unsigned int task) {
+	uint32_t* offset = grid->histogram + (grid->num_buckets * task);
+	size_t begin, end, i;
+	hashgrid_task_range(grid, task, &begin, &end);
+	for (i = begin; i < end; ++i) {
+		const uint64_t cell = grid->source_cells[i];
+		const uint32_t slot = offset[hashgrid_bucket(grid, cell)]++;
+		grid->indices[slot] = (uint32_t)i;
+		grid->cells[slot] = cell;
+		grid->points[slot] = grid->source[i];
+	}
+}
+
+void
+hashgrid_build(hashgrid_t* grid, const vector_t* points, size_t count) {
+	hashgrid_build_begin(grid, points, count, 1);
+	hashgrid_build_count(grid, 0);
+	hashgrid_build_prefix(grid);
+	hashgrid_build_scatter(grid, 0);
+}
+
+size_t
+hashgrid_query_radius(const hashgrid_t* grid, uint32_t* results, size_t capacity, const vector_t center,
+                      real radius) {
+	const vector_t scale = vector_uniform(grid->inv_cell_size);
+	const vector_t offset = vector_uniform(radius);
+	const vector_t low = vector_mul(vector_sub(center, offset), scale);
+	const vector_t high = vector_mul(vector_add(center, offset), scale);
+	const int32_t min_x = hashgrid_floor(vector_x(low));
+	const int32_t min_y = hashgrid_floor(vector_y(low));
+	const int32_t min_z = hashgrid_floor(vector_z(low));
+	const int32_t max_x = hashgrid_floor(vector_x(high));
+	const int32_t max_y = hashgrid_floor(vector_y(high));
+	const int32_t max_z = hashgrid_floor(vector_z(high));
+	const real radius_sqr = radius * radius;
+	size_t found = 0;
+	int32_t x, y, z;
+
+	if (!grid->num_points)
+		return 0;
+
+	//Buckets are shared by cells hashing to the same value, the stored cell of each point
+	//selects the points of the visited cell so no point is reported twice
+	for (z = min_z; z <= max_z; ++z) {
+		for (y = min_y; y <= max_y; ++y) {
+			for (x = min_x; x <= max_x; ++x) {
+				const uint64_t cell = hashgrid_pack(x, y, z);
+				const uint32_t bucket = hashgrid_bucket(grid, cell);
+				uint32_t i;
+				for (i = grid->bucket_start[bucket]; i < grid->bucket_start[bucket + 1]; ++i) {
+					if ((grid->cells[i] == cell) &&
+					    (vector_x(vector_length3_sqr(vector_sub(grid->points[i], center))) <= radius_sqr)) {
+						if (found < capacity)
+							results[found] = grid->indices[i];
+						++found;
+					}
+				}
+			}
+		}
+	}
+	return found;
+}
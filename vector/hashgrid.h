@@ -0,0 +1,76 @@
+/* hashgrid.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file hashgrid.h
+    Spatial hash grid for neighbor queries over point sets. Space is divided in cubic cells
+    which are hashed to a table of buckets, and the points are stored in flat arrays sorted
+    by bucket, so a query reads the points of a cell from contiguous memory without any per
+    cell allocations. Query radius should be on the order of the cell size.
+
+    The build is a counting sort and can be split in tasks running on worker threads, each
+    task handling a contiguous range of the points:
+
+        hashgrid_build_begin(&grid, points, count, num_tasks);
+        //Run hashgrid_build_count for each task in parallel and wait for all
+        hashgrid_build_prefix(&grid);
+        //Run hashgrid_build_scatter for each task in parallel and wait for all
+
+    The result does not depend on the number of tasks. The histograms of the build use
+    num_tasks times the number of buckets integers, about the number of points. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+
+//! Maximum number of build tasks
+#define HASHGRID_MAX_TASKS 64
+
+//! Initialize empty grid with given cell size
+VECTOR_API void
+hashgrid_initialize(hashgrid_t* grid, real cell_size);
+
+//! Finalize grid and release memory
+VECTOR_API void
+hashgrid_finalize(hashgrid_t* grid);
+
+//! Build grid over array of points on the calling thread, replacing any previous content
+VECTOR_API void
+hashgrid_build(hashgrid_t* grid, const vector_t* points, size_t count);
+
+/*! Start a build over array of points split in num_tasks tasks, clamped to
+    [1, HASHGRID_MAX_TASKS]. Points must stay valid until the build is finished */
+VECTOR_API void
+hashgrid_build_begin(hashgrid_t* grid, const vector_t* points, size_t count, unsigned int num_tasks);
+
+//! Compute cells and bucket histogram of the points of a task, tasks can run concurrently
+VECTOR_API void
+hashgrid_build_count(hashgrid_t* grid, unsigned int task);
+
+//! Compute bucket ranges after all tasks are counted
+VECTOR_API void
+hashgrid_build_prefix(hashgrid_t* grid);
+
+/*! Store the points of a task in the sorted arrays, tasks can run concurrently. The build
+    is finished when all tasks are stored */
+VECTOR_API void
+hashgrid_build_scatter(hashgrid_t* grid, unsigned int task);
+
+/*! Find points within radius of center, storing the first capacity point indices in
+    results. Returns the total number of points found, which can be larger than capacity */
+VECTOR_API size_t
+hashgrid_query_radius(const hashgrid_t* grid, uint32_t* results, size_t capacity, const vector_t center,
+                      real radius);
@@ -287,3 +287,30 @@
 #define VECTOR_MASK_WWWY VECTOR_MASK(3, 3, 3, 1)
 #define VECTOR_MASK_WWWZ VECTOR_MASK(3, 3, 3, 2)
 #define VECTOR_MASK_WWWW VECTOR_MASK(3, 3, 3, 3)
+
+#define VECTOR_BLEND(x, y, z, w) (((w) << 3) | ((z) << 2) | ((y) << 1) | ((x)))
+
+/* Vector blend masks where the operation performed by
+   v2 = vector_blend(v0, v1, VECTOR_BLEND_abcd)
+   will be equal to
+   v2.x = a ? v1.x : v0.x
+   v2.y = b ? v1.y : v0.y
+   v2.z = c ? v1.z : v0.z
+   v2.w = d ? v1.w : v0.w */
+
+#define VECTOR_BLEND_0000 VECTOR_BLEND(0, 0, 0, 0)
+#define VECTOR_BLEND_0001 VECTOR_BLEND(0, 0, 0, 1)
+#define VECTOR_BLEND_0010 VECTOR_BLEND(0, 0, 1, 0)
+#define VECTOR_BLEND_0011 VECTOR_BLEND(0, 0, 1, 1)
+#define VECTOR_BLEND_0100 VECTOR_BLEND(0, 1, 0, 0)
+#define VECTOR_BLEND_0101 VECTOR_BLEND(0, 1, 0, 1)
+#define VECTOR_BLEND_0110 VECTOR_BLEND(0, 1, 1, 0)
+#define VECTOR_BLEND_0111 VECTOR_BLEND(0, 1, 1, 1)
+#define VECTOR_BLEND_1000 VECTOR_BLEND(1, 0, 0, 0)
+#define VECTOR_BLEND_1001 VECTOR_BLEND(1, 0, 0, 1)
+#define VECTOR_BLEND_1010 VECTOR_BLEND(1, 0, 1, 0)
+#define VECTOR_BLEND_1011 VECTOR_BLEND(1, 0, 1, 1)
+#define VECTOR_BLEND_1100 VECTOR_BLEND(1, 1, 0, 0)
+#define VECTOR_BLEND_1101 VECTOR_BLEND(1, 1, 0, 1)
+#define VECTOR_BLEND_1110 VECTOR_BLEND(1, 1, 1, 0)
+#define VECTOR_BLEND_1111 VECTOR_BLEND(1, 1, 1, 1)
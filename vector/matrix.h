@@ -39,7 +39,7 @@ matrix_unaligned(const float32_t* FOUNDATION_RESTRICT m);
 static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL matrix_t
 matrix_aligned(const float32_aligned128_t* FOUNDATION_RESTRICT m);
 
-static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL matrix_t
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL matrix_t
 matrix_transpose(const matrix_t m);
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL matrix_t
@@ -74,3 +74,7 @@ matrix_transform(const matrix_t m, const vector_t v);
 #  include <vector/matrix_fallback.h>
 #endif
 
+#if VECTOR_VALIDATE
+#  define VECTOR_VALIDATE_MATRIX_COMPLETE 1
+#  include <vector/validate.h>
+#endif
@@ -0,0 +1,306 @@
+/* morton.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/morton.h>
+#include <vector/internal.h>
+
+//Number of bits per radix sort digit, 3 passes for 30 bit codes and 6 for 63 bit codes
+#define MORTON_RADIX_BITS 11
+#define MORTON_RADIX_SIZE (1U << MORTON_RADIX_BITS)
+#define MORTON_RADIX_MASK (MORTON_RADIX_SIZE - 1)
+
+/* Quantization maps the bounds to [0, 2^bits - 1] per axis and truncates. The scalar and
+   SIMD paths use the same sequence of vector operations so the codes match exactly */
+
+static vector_t
+morton_quantize_scale(const aabb_t bounds, unsigned int bits) {
+	const real max_coord = (real)((1U << bits) - 1);
+	const vector_t extent = vector_sub(bounds.max, bounds.min);
+	real scale[4];
+	for (int axis = 0; axis < 3; ++axis) {
+		const real size = vector_component(extent, axis);
+		scale[axis] = (size > 0) ? (max_coord / size) : 0;
+	}
+	return vector(scale[0], scale[1], scale[2], 0);
+}
+
+static FOUNDATION_FORCEINLINE vector_t
+morton_quantize(const vector_t point, const vector_t min, const vector_t scale, const vector_t max_coord) {
+	return vector_min(vector_max(vector_mul(vector_sub(point, min), scale), vector_zero()), max_coord);
+}
+
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+
+//Quantize four points to integer coordinates in SoA form
+static FOUNDATION_FORCEINLINE void
+morton_quantize4(__m128i* coord, const vector_t* FOUNDATION_RESTRICT src, const vector_t min,
+                 const vector_t scale, const vector_t max_coord) {
+	__m128 x = src[0];
+	__m128 y = src[1];
+	__m128 z = src[2];
+	__m128 w = src[3];
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	coord[0] = _mm_cvttps_epi32(morton_quantize(x, _mm_shuffle_ps(min, min, _MM_SHUFFLE(0, 0, 0, 0)),
+	                                            _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(0, 0, 0, 0)), max_coord));
+	coord[1] = _mm_cvttps_epi32(morton_quantize(y, _mm_shuffle_ps(min, min, _MM_SHUFFLE(1, 1, 1, 1)),
+	                                            _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 1, 1, 1)), max_coord));
+	coord[2] = _mm_cvttps_epi32(morton_quantize(z, _mm_shuffle_ps(min, min, _MM_SHUFFLE(2, 2, 2, 2)),
+	                                            _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 2, 2)), max_coord));
+}
+
+static FOUNDATION_FORCEINLINE __m128i
+morton_spread30_4(__m128i v) {
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 16)), _mm_set1_epi32(0x030000FF));
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 8)), _mm_set1_epi32(0x0300F00F));
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 4)), _mm_set1_epi32(0x030C30C3));
+	return _mm_and_si128(_mm_or_si128(v, _mm_slli_epi32(v, 2)), _mm_set1_epi32(0x09249249));
+}
+
+//Spread two 21 bit coordinates in 64 bit lanes
+static FOUNDATION_FORCEINLINE __m128i
+morton_spread63_2(__m128i v) {
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 32)), _mm_set1_epi64x(0x001F00000000FFFFLL));
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 16)), _mm_set1_epi64x(0x001F0000FF0000FFLL));
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 8)), _mm_set1_epi64x(0x100F00F00F00F00FLL));
+	v = _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 4)), _mm_set1_epi64x(0x10C30C30C30C30C3LL));
+	return _mm_and_si128(_mm_or_si128(v, _mm_slli_epi64(v, 2)), _mm_set1_epi64x(0x1249249249249249LL));
+}
+
+static FOUNDATION_FORCEINLINE __m128i
+morton_encode63_2(__m128i x, __m128i y, __m128i z) {
+	return _mm_or_si128(_mm_or_si128(morton_spread63_2(x), _mm_slli_epi64(morton_spread63_2(y), 1)),
+	                    _mm_slli_epi64(morton_spread63_2(z), 2));
+}
+
+#endif
+
+void
+morton_array_encode30(uint32_t* codes, const vector_t* points, size_t count, const aabb_t bounds) {
+	const vector_t scale = morton_quantize_scale(bounds, MORTON_BITS30);
+	const vector_t max_coord = vector_uniform((real)((1U << MORTON_BITS30) - 1));
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4) {
+		__m128i coord[3];
+		morton_quantize4(coord, points + i, bounds.min, scale, max_coord);
+		const __m128i code = _mm_or_si128(_mm_or_si128(morton_spread30_4(coord[0]),
+		                                               _mm_slli_epi32(morton_spread30_4(coord[1]), 1)),
+		                                  _mm_slli_epi32(morton_spread30_4(coord[2]), 2));
+		_mm_storeu_si128((__m128i*)(codes + i), code);
+	}
+#endif
+	for (; i < count; ++i) {
+		const vector_t coord = morton_quantize(points[i], bounds.min, scale, max_coord);
+		codes[i] = morton_encode30((uint32_t)vector_x(coord), (uint32_t)vector_y(coord), (uint32_t)vector_z(coord));
+	}
+}
+
+void
+morton_array_encode63(uint64_t* codes, const vector_t* points, size_t count, const aabb_t bounds) {
+	const vector_t scale = morton_quantize_scale(bounds, MORTON_BITS63);
+	const vector_t max_coord = vector_uniform((real)((1U << MORTON_BITS63) - 1));
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		__m128i coord[3];
+		morton_quantize4(coord, points + i, bounds.min, scale, max_coord);
+		_mm_storeu_si128((__m128i*)(codes + i),
+		                 morton_encode63_2(_mm_unpacklo_epi32(coord[0], zero), _mm_unpacklo_epi32(coord[1], zero),
+		                                   _mm_unpacklo_epi32(coord[2], zero)));
+		_mm_storeu_si128((__m128i*)(codes + i + 2),
+		                 morton_encode63_2(_mm_unpackhi_epi32(coord[0], zero), _mm_unpackhi_epi32(coord[1], zero),
+		                                   _mm_unpackhi_epi32(coord[2], zero)));
+	}
+#endif
+	for (; i < count; ++i) {
+		const vector_t coord = morton_quantize(points[i], bounds.min, scale, max_coord);
+		codes[i] = morton_encode63((uint32_t)vector_x(coord), (uint32_t)vector_y(coord), (uint32_t)vector_z(coord));
+	}
+}
+
+/* LSD radix sort. The digit histograms of all passes are counted in one read of the keys,
+   and a pass is skipped if all keys fall in the same bucket since it would not move any key.
+   Keys and order ping-pong between the input arrays and temporary buffers */
+
+static uint32_t*
+morton_sort_begin(uint32_t* order, size_t count, uint32_t** order_temp) {
+	FOUNDATION_ASSERT_MSG(count <= 0xFFFFFFFFULL, "Too many codes to sort");
+	*order_temp = 0;
+	if (!order)
+		return 0;
+	for (size_t i = 0; i < count; ++i)
+		order[i] = (uint32_t)i;
+	*order_temp = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * count, 0, MEMORY_TEMPORARY);
+	return order;
+}
+
+static void
+morton_sort_prefix(uint32_t* histogram) {
+	uint32_t sum = 0;
+	for (size_t bucket = 0; bucket < MORTON_RADIX_SIZE; ++bucket) {
+		const uint32_t num = histogram[bucket];
+		histogram[bucket] = sum;
+		sum += num;
+	}
+}
+
+void
+morton_sort30(uint32_t* codes, uint32_t* order, size_t count) {
+	const unsigned int passes = 3;
+	if (count < 2) {
+		if (order && count)
+			order[0] = 0;
+		return;
+	}
+
+	uint32_t* order_temp;
+	uint32_t* order_src = morton_sort_begin(order, count, &order_temp);
+	uint32_t* order_dst = order_temp;
+	uint32_t* src = codes;
+	uint32_t* dst = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * count, 0, MEMORY_TEMPORARY);
+	uint32_t* temp = dst;
+	uint32_t* histogram = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * MORTON_RADIX_SIZE * passes, 0,
+	                                      MEMORY_TEMPORARY | MEMORY_ZERO_INITIALIZED);
+
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t code = codes[i];
+		++histogram[code & MORTON_RADIX_MASK];
+		++histogram[MORTON_RADIX_SIZE + ((code >> MORTON_RADIX_BITS) & MORTON_RADIX_MASK)];
+		++histogram[(MORTON_RADIX_SIZE * 2) + ((code >> (MORTON_RADIX_BITS * 2)) & MORTON_RADIX_MASK)];
+	}
+
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		uint32_t* offset = histogram + (MORTON_RADIX_SIZE * pass);
+		const unsigned int shift = MORTON_RADIX_BITS * pass;
+		if (offset[(src[0] >> shift) & MORTON_RADIX_MASK] == count)
+			continue;
+		morton_sort_prefix(offset);
+		if (order_src) {
+			for (size_t i = 0; i < count; ++i) {
+				const uint32_t dst_index = offset[(src[i] >> shift) & MORTON_RADIX_MASK]++;
+				dst[dst_index] = src[i];
+				order_dst[dst_index] = order_src[i];
+			}
+			uint32_t* order_swap = order_src;
+			order_src = order_dst;
+			order_dst = order_swap;
+		}
+		else {
+			for (size_t i = 0; i < count; ++i)
+				dst[offset[(src[i] >> shift) & MORTON_RADIX_MASK]++] = src[i];
+		}
+		uint32_t* swap = src;
+		src = dst;
+		dst = swap;
+	}
+
+	if (src != codes) {
+		memcpy(codes, src, sizeof(uint32_t) * count);
+		if (order_src)
+			memcpy(order, order_src, sizeof(uint32_t) * count);
+	}
+
+	memory_deallocate(histogram);
+	memory_deallocate(temp);
+	memory_deallocate(order_temp);
+}
+
+void
+morton_sort63(uint64_t* codes, uint32_t* order, size_t count) {
+	const unsigned int passes = 6;
+	if (count < 2) {
+		if (order && count)
+			order[0] = 0;
+		return;
+	}
+
+	uint32_t* order_temp;
+	uint32_t* order_src = morton_sort_begin(order, count, &order_temp);
+	uint32_t* order_dst = order_temp;
+	uint64_t* src = codes;
+	uint64_t* dst = memory_allocate(HASH_VECTOR, sizeof(uint64_t) * count, 0, MEMORY_TEMPORARY);
+	uint64_t* temp = dst;
+	uint32_t* histogram = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * MORTON_RADIX_SIZE * passes, 0,
+	                                      MEMORY_TEMPORARY | MEMORY_ZERO_INITIALIZED);
+
+	for (size_t i = 0; i < count; ++i) {
+		const uint64_t code = codes[i];
+		for (unsigned int pass = 0; pass < passes; ++pass)
+			++histogram[(MORTON_RADIX_SIZE * pass) + ((code >> (MORTON_RADIX_BITS * pass)) & MORTON_RADIX_MASK)];
+	}
+
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		uint32_t* offset = histogram + (MORTON_RADIX_SIZE * pass);
+		const unsigned int shift = MORTON_RADIX_BITS * pass;
+		if (offset[(src[0] >> shift) & MORTON_RADIX_MASK] == count)
+			continue;
+		morton_sort_prefix(offset);
+		if (order_src) {
+			for (size_t i = 0; i < count; ++i) {
+				const uint32_t dst_index = offset[(src[i] >> shift) & MORTON_RADIX_MASK]++;
+				dst[dst_index] = src[i];
+				order_dst[dst_index] = order_src[i];
+			}
+			uint32_t* order_swap = order_src;
+			order_src = order_dst;
+			order_dst = order_swap;
+		}
+		else {
+			for (size_t i = 0; i < count; ++i)
+				dst[offset[(src[i] >> shift) & MORTON_RADIX_MASK]++] = src[i];
+		}
+		uint64_t* swap = src;
+		src = dst;
+		dst = swap;
+	}
+
+	if (src != codes) {
+		memcpy(codes, src, sizeof(uint64_t) * count);
+		if (order_src)
+			memcpy(order, order_src, sizeof(uint32_t) * count);
+	}
+
+	memory_deallocate(histogram);
+	memory_deallocate(temp);
+	memory_deallocate(order_temp);
+}
+
+void
+morton_sort_points(vector_t* points, uint32_t* order, size_t count) {
+	if (count < 2) {
+		if (order && count)
+			order[0] = 0;
+		return;
+	}
+
+	uint32_t* codes = memory_allocate(HASH_VECTOR, sizeof(uint32_t) * count, 0, MEMORY_TEMPORARY);
+	uint32_t* index = order ? order : memory_allocate(HASH_VECTOR, sizeof(uint32_t) * count, 0, MEMORY_TEMPORARY);
+	vector_t* copy = memory_allocate(HASH_VECTOR, sizeof(vector_t) * count, 16, MEMORY_TEMPORARY);
+
+	morton_array_encode30(codes, points, count, aabb_from_points(points, count));
+	morton_sort30(codes, index, count);
+
+	memcpy(copy, points, sizeof(vector_t) * count);
+	for (size_t i = 0; i < count; ++i)
+		points[i] = copy[index[i]];
+
+	memory_deallocate(copy);
+	if (index != order)
+		memory_deallocate(index);
+	memory_deallocate(codes);
+}
@@ -0,0 +1,182 @@
+/* morton.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file morton.h
+    Morton (Z-order) codes of points. Positions are quantized to a grid over given bounds,
+    10 bits per axis for 30 bit codes and 21 bits per axis for 63 bit codes, and the bits of
+    the three coordinates are interleaved with x in the lowest bit. Sorting points by code
+    groups points close in space together in memory.
+
+    The array functions quantize and interleave four points at a time with integer SIMD
+    shifts and masks. Single codes use the BMI2 bit deposit and extract instructions when
+    the compiler targets them, and shifts and masks otherwise. The radix sort is a stable
+    LSD sort on 11 bit digits, skipping passes where all codes have the same digit. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/aabb.h>
+
+#if defined(__BMI2__) && (FOUNDATION_ARCH_X86 || FOUNDATION_ARCH_X86_64)
+#  include <immintrin.h>
+#  define VECTOR_MORTON_PDEP 1
+#else
+#  define VECTOR_MORTON_PDEP 0
+#endif
+
+//! Number of bits per axis in 30 bit codes
+#define MORTON_BITS30 10
+//! Number of bits per axis in 63 bit codes
+#define MORTON_BITS63 21
+
+//! Interleave 10 bit coordinates to a 30 bit code
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_encode30(uint32_t x, uint32_t y, uint32_t z);
+
+//! Interleave 21 bit coordinates to a 63 bit code
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint64_t
+morton_encode63(uint32_t x, uint32_t y, uint32_t z);
+
+//! Extract coordinate of 30 bit code, axis 0 to 2
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_decode30(uint32_t code, unsigned int axis);
+
+//! Extract coordinate of 63 bit code, axis 0 to 2
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_decode63(uint64_t code, unsigned int axis);
+
+/*! Quantize array of points to 10 bits per axis over bounds and encode to 30 bit codes.
+    Points outside the bounds are clamped */
+VECTOR_API void
+morton_array_encode30(uint32_t* codes, const vector_t* points, size_t count, const aabb_t bounds);
+
+/*! Quantize array of points to 21 bits per axis over bounds and encode to 63 bit codes.
+    Points outside the bounds are clamped */
+VECTOR_API void
+morton_array_encode63(uint64_t* codes, const vector_t* points, size_t count, const aabb_t bounds);
+
+/*! Sort 30 bit codes in increasing order. If order is not null it receives the original
+    index of each sorted code. Equal codes keep their relative order */
+VECTOR_API void
+morton_sort30(uint32_t* codes, uint32_t* order, size_t count);
+
+/*! Sort 63 bit codes in increasing order. If order is not null it receives the original
+    index of each sorted code. Equal codes keep their relative order */
+VECTOR_API void
+morton_sort63(uint64_t* codes, uint32_t* order, size_t count);
+
+/*! Reorder array of points along the 30 bit Z-order curve over their bounds. If order is not
+    null it receives the original index of each point, to reorder other per point arrays */
+VECTOR_API void
+morton_sort_points(vector_t* points, uint32_t* order, size_t count);
+
+#if VECTOR_MORTON_PDEP
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_encode30(uint32_t x, uint32_t y, uint32_t z) {
+	return _pdep_u32(x, 0x09249249U) | _pdep_u32(y, 0x12492492U) | _pdep_u32(z, 0x24924924U);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_decode30(uint32_t code, unsigned int axis) {
+	return _pext_u32(code, 0x09249249U << axis);
+}
+
+#endif
+
+#if VECTOR_MORTON_PDEP && FOUNDATION_ARCH_X86_64
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint64_t
+morton_encode63(uint32_t x, uint32_t y, uint32_t z) {
+	return _pdep_u64(x, 0x1249249249249249ULL) | _pdep_u64(y, 0x2492492492492492ULL) |
+	       _pdep_u64(z, 0x4924924924924924ULL);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_decode63(uint64_t code, unsigned int axis) {
+	return (uint32_t)_pext_u64(code, 0x1249249249249249ULL << axis);
+}
+
+#endif
+
+#if !VECTOR_MORTON_PDEP
+
+//Spread the low 10 bits to every third bit
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_spread30(uint32_t v) {
+	v &= 0x3FF;
+	v = (v | (v << 16)) & 0x030000FFU;
+	v = (v | (v << 8)) & 0x0300F00FU;
+	v = (v | (v << 4)) & 0x030C30C3U;
+	return (v | (v << 2)) & 0x09249249U;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_compact30(uint32_t v) {
+	v &= 0x09249249U;
+	v = (v | (v >> 2)) & 0x030C30C3U;
+	v = (v | (v >> 4)) & 0x0300F00FU;
+	v = (v | (v >> 8)) & 0x030000FFU;
+	return (v | (v >> 16)) & 0x3FF;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_encode30(uint32_t x, uint32_t y, uint32_t z) {
+	return morton_spread30(x) | (morton_spread30(y) << 1) | (morton_spread30(z) << 2);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_decode30(uint32_t code, unsigned int axis) {
+	return morton_compact30(code >> axis);
+}
+
+#endif
+
+#if !VECTOR_MORTON_PDEP || !FOUNDATION_ARCH_X86_64
+
+//Spread the low 21 bits to every third bit
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint64_t
+morton_spread63(uint64_t v) {
+	v &= 0x1FFFFFULL;
+	v = (v | (v << 32)) & 0x001F00000000FFFFULL;
+	v = (v | (v << 16)) & 0x001F0000FF0000FFULL;
+	v = (v | (v << 8)) & 0x100F00F00F00F00FULL;
+	v = (v | (v << 4)) & 0x10C30C30C30C30C3ULL;
+	return (v | (v << 2)) & 0x1249249249249249ULL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_compact63(uint64_t v) {
+	v &= 0x1249249249249249ULL;
+	v = (v | (v >> 2)) & 0x10C30C30C30C30C3ULL;
+	v = (v | (v >> 4)) & 0x100F00F00F00F00FULL;
+	v = (v | (v >> 8)) & 0x001F0000FF0000FFULL;
+	v = (v | (v >> 16)) & 0x001F00000000FFFFULL;
+	return (uint32_t)((v | (v >> 32)) & 0x1FFFFFULL);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint64_t
+morton_encode63(uint32_t x, uint32_t y, uint32_t z) {
+	return morton_spread63(x) | (morton_spread63(y) << 1) | (morton_spread63(z) << 2);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+morton_decode63(uint64_t code, unsigned int axis) {
+	return morton_compact63(code >> axis);
+}
+
+#endif
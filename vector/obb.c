@@ -0,0 +1,154 @@
+/* obb.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/obb.h>
+
+#define OBB_JACOBI_SWEEPS 32
+
+/* Eigenvectors of symmetric 3x3 matrix by cyclic Jacobi rotations, returned as the columns
+   of v. The matrix is destroyed */
+static void
+obb_eigenvectors(real a[3][3], real v[3][3]) {
+	int sweep, p, q, k;
+	for (p = 0; p < 3; ++p) {
+		for (q = 0; q < 3; ++q)
+			v[p][q] = (p == q) ? REAL_C(1.0) : REAL_C(0.0);
+	}
+	for (sweep = 0; sweep < OBB_JACOBI_SWEEPS; ++sweep) {
+		const real off = (a[0][1] * a[0][1]) + (a[0][2] * a[0][2]) + (a[1][2] * a[1][2]);
+		const real diag = (a[0][0] * a[0][0]) + (a[1][1] * a[1][1]) + (a[2][2] * a[2][2]);
+		if (off <= diag * REAL_C(1e-12))
+			break;
+		for (p = 0; p < 2; ++p) {
+			for (q = p + 1; q < 3; ++q) {
+				real theta, t, c, s;
+				if (math_abs(a[p][q]) <= REAL_C(1e-30))
+					continue;
+				//Rotation zeroing a[p][q], tangent of the smaller rotation angle
+				theta = (a[q][q] - a[p][p]) / (REAL_C(2.0) * a[p][q]);
+				t = REAL_C(1.0) / (math_abs(theta) + math_sqrt((theta * theta) + REAL_C(1.0)));
+				if (theta < 0)
+					t = -t;
+				c = REAL_C(1.0) / math_sqrt((t * t) + REAL_C(1.0));
+				s = t * c;
+				for (k = 0; k < 3; ++k) {
+					const real akp = a[k][p];
+					const real akq = a[k][q];
+					a[k][p] = (c * akp) - (s * akq);
+					a[k][q] = (s * akp) + (c * akq);
+				}
+				for (k = 0; k < 3; ++k) {
+					const real apk = a[p][k];
+					const real aqk = a[q][k];
+					a[p][k] = (c * apk) - (s * aqk);
+					a[q][k] = (s * apk) + (c * aqk);
+				}
+				for (k = 0; k < 3; ++k) {
+					const real vkp = v[k][p];
+					const real vkq = v[k][q];
+					v[k][p] = (c * vkp) - (s * vkq);
+					v[k][q] = (s * vkp) + (c * vkq);
+				}
+			}
+		}
+	}
+}
+
+obb_t
+obb_from_points(const vector_t* points, size_t count) {
+	vector_t mean = vector_zero();
+	vector_t sum_xx = vector_zero();
+	vector_t sum_yz = vector_zero();
+	vector_t scale;
+	vector_t min, max, local;
+	real covariance[3][3];
+	real eigen[3][3];
+	matrix_t axes, project;
+	obb_t box;
+	size_t i;
+
+	if (!count) {
+		box.center = vector_zero();
+		box.extent = vector_zero();
+		box.axis[0] = vector(1, 0, 0, 0);
+		box.axis[1] = vector(0, 1, 0, 0);
+		box.axis[2] = vector(0, 0, 1, 0);
+		return box;
+	}
+
+	for (i = 0; i < count; ++i)
+		mean = vector_add(mean, points[i]);
+	mean = vector_div(mean, vector_uniform((real)count));
+
+	//Covariance diagonal and off diagonal terms, [xx, yy, zz] and [yz, zx, xy]
+	for (i = 0; i < count; ++i) {
+		const vector_t d = vector_sub(points[i], mean);
+		sum_xx = vector_muladd(d, d, sum_xx);
+		sum_yz = vector_muladd(vector_shuffle(d, VECTOR_MASK_YZXW), vector_shuffle(d, VECTOR_MASK_ZXYW), sum_yz);
+	}
+	scale = vector_uniform(REAL_C(1.0) / (real)count);
+	sum_xx = vector_mul(sum_xx, scale);
+	sum_yz = vector_mul(sum_yz, scale);
+	covariance[0][0] = vector_x(sum_xx);
+	covariance[1][1] = vector_y(sum_xx);
+	covariance[2][2] = vector_z(sum_xx);
+	covariance[1][2] = covariance[2][1] = vector_x(sum_yz);
+	covariance[0][2] = covariance[2][0] = vector_y(sum_yz);
+	covariance[0][1] = covariance[1][0] = vector_z(sum_yz);
+	obb_eigenvectors(covariance, eigen);
+
+	//Right handed orthonormal axes, the third recomputed from the first two
+	axes.row[0] = vector(eigen[0][0], eigen[1][0], eigen[2][0], 0);
+	axes.row[0] = vector_div(axes.row[0], vector_length3(axes.row[0]));
+	axes.row[1] = vector(eigen[0][1], eigen[1][1], eigen[2][1], 0);
+	axes.row[1] = vector_sub(axes.row[1], vector_mul(axes.row[0], vector_dot3(axes.row[0], axes.row[1])));
+	axes.row[1] = vector_div(axes.row[1], vector_length3(axes.row[1]));
+	axes.row[2] = vector_cross3(axes.row[0], axes.row[1]);
+	axes.row[0] = vector_blend(axes.row[0], vector_zero(), VECTOR_BLEND_0001);
+	axes.row[1] = vector_blend(axes.row[1], vector_zero(), VECTOR_BLEND_0001);
+	axes.row[2] = vector_blend(axes.row[2], vector_zero(), VECTOR_BLEND_0001);
+	axes.row[3] = vector_zero();
+
+	//Extent of points along the axes
+	project = matrix_transpose(axes);
+	min = max = matrix_rotate(project, points[0]);
+	for (i = 1; i < count; ++i) {
+		local = matrix_rotate(project, points[i]);
+		min = vector_min(min, local);
+		max = vector_max(max, local);
+	}
+	local = vector_blend(vector_mul(vector_add(min, max), vector_half()), vector_zero(), VECTOR_BLEND_0001);
+
+	box.center = vector_blend(matrix_rotate(axes, local), vector_one(), VECTOR_BLEND_0001);
+	box.extent = vector_blend(vector_mul(vector_sub(max, min), vector_half()), vector_zero(), VECTOR_BLEND_0001);
+	box.axis[0] = axes.row[0];
+	box.axis[1] = axes.row[1];
+	box.axis[2] = axes.row[2];
+	return box;
+}
+
+size_t
+obb_array_overlap(uint32_t* overlapping, const obb_t* a, const obb_t* b, size_t count) {
+	size_t num_overlapping = 0;
+	size_t i;
+	//Branch free compaction, the test itself has no data dependent branches
+	for (i = 0; i < count; ++i) {
+		overlapping[num_overlapping] = (uint32_t)i;
+		num_overlapping += obb_overlap(a[i], b[i]) ? 1 : 0;
+	}
+	return num_overlapping;
+}
@@ -0,0 +1,198 @@
+/* obb.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file obb.h
+    Oriented bounding boxes. A box is given by its center, the half size along each of its
+    axes and the axes as unit length rows, the w components are ignored. Keeping the axes as
+    rows rather than a quaternion makes the overlap test free of rotation conversions.
+
+    obb_overlap evaluates all 15 separating axes of the separating axis test (Gottschalk)
+    branch free, three axes per vector compare, and checks the combined lane mask once at
+    the end. A small epsilon is added to the rotation terms so nearly parallel edge pairs,
+    whose cross product axes are degenerate, do not report false separations. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/quaternion.h>
+#include <vector/matrix.h>
+#include <vector/aabb.h>
+
+//! Construct box from center, half size along each axis and rotation of the axes
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL obb_t
+obb(const vector_t center, const vector_t extent, const quaternion_t rotation);
+
+//! Construct box from axis-aligned box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL obb_t
+obb_from_aabb(const aabb_t box);
+
+/*! Transform box, rotation and uniform scale in the w component of the translation are
+    applied before the translation */
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL obb_t
+obb_transform(const obb_t box, const transform_t transform);
+
+//! Axis-aligned bounds of box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+obb_aabb(const obb_t box);
+
+//! Check if point is inside or on the boundary of box
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+obb_contains_point(const obb_t box, const vector_t point);
+
+//! Check if boxes overlap, touching boxes overlap
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+obb_overlap(const obb_t a, const obb_t b);
+
+/*! Box fitted to array of points, with axes along the principal axes of the point
+    covariance. Degenerate box at origin if count is zero */
+VECTOR_API obb_t
+obb_from_points(const vector_t* points, size_t count);
+
+/*! Test pairs of boxes a[i] and b[i], writing the indices of the overlapping pairs in
+    increasing order. Returns the number of overlapping pairs */
+VECTOR_API size_t
+obb_array_overlap(uint32_t* overlapping, const obb_t* a, const obb_t* b, size_t count);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL obb_t
+obb(const vector_t center, const vector_t extent, const quaternion_t rotation) {
+	obb_t box;
+	box.center = center;
+	box.extent = extent;
+	box.axis[0] = quaternion_rotate(rotation, vector(1, 0, 0, 0));
+	box.axis[1] = quaternion_rotate(rotation, vector(0, 1, 0, 0));
+	box.axis[2] = quaternion_rotate(rotation, vector(0, 0, 1, 0));
+	return box;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL obb_t
+obb_from_aabb(const aabb_t box) {
+	return obb(aabb_center(box), aabb_extent(box), quaternion_identity());
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL obb_t
+obb_transform(const obb_t box, const transform_t transform) {
+	const vector_t scale = vector_shuffle(transform.translation, VECTOR_MASK_WWWW);
+	obb_t result;
+	result.center = vector_add(quaternion_rotate(transform.rotation, vector_mul(box.center, scale)),
+	                           transform.translation);
+	result.extent = vector_mul(box.extent, vector_abs(scale));
+	result.axis[0] = quaternion_rotate(transform.rotation, box.axis[0]);
+	result.axis[1] = quaternion_rotate(transform.rotation, box.axis[1]);
+	result.axis[2] = quaternion_rotate(transform.rotation, box.axis[2]);
+	return result;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL aabb_t
+obb_aabb(const obb_t box) {
+	//Half size along each world axis is the sum of the absolute scaled box axes
+	vector_t extent = vector_mul(vector_abs(box.axis[0]), vector_shuffle(box.extent, VECTOR_MASK_XXXX));
+	extent = vector_muladd(vector_abs(box.axis[1]), vector_shuffle(box.extent, VECTOR_MASK_YYYY), extent);
+	extent = vector_muladd(vector_abs(box.axis[2]), vector_shuffle(box.extent, VECTOR_MASK_ZZZZ), extent);
+	return aabb_from_center(box.center, extent);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+obb_contains_point(const obb_t box, const vector_t point) {
+	//Project offset on the axes as rows of the transposed axis matrix
+	matrix_t axes;
+	vector_t local;
+	axes.row[0] = box.axis[0];
+	axes.row[1] = box.axis[1];
+	axes.row[2] = box.axis[2];
+	axes.row[3] = vector_zero();
+	axes = matrix_transpose(axes);
+	local = matrix_rotate(axes, vector_sub(point, box.center));
+	return (vector_movemask(vector_cmpgt(vector_abs(local), box.extent)) & VECTOR_LANES_XYZ) == 0;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+obb_overlap(const obb_t a, const obb_t b) {
+	const vector_t epsilon = vector_uniform(REAL_C(1e-6));
+	const vector_t offset = vector_sub(b.center, a.center);
+	matrix_t at, bt, r, absr, absrt;
+	vector_t t, tb, separated;
+	vector_t ax, ay, az, bx, by, bz;
+	vector_t b_yzx, b_zxy;
+	vector_t lhs, rhs;
+
+	//Rotation of b in the frame of a, row i is the dot products of axis i of a with the
+	//axes of b, so the lanes of row i are over the axes of b
+	bt.row[0] = b.axis[0];
+	bt.row[1] = b.axis[1];
+	bt.row[2] = b.axis[2];
+	bt.row[3] = vector_zero();
+	bt = matrix_transpose(bt);
+	r.row[0] = matrix_rotate(bt, a.axis[0]);
+	r.row[1] = matrix_rotate(bt, a.axis[1]);
+	r.row[2] = matrix_rotate(bt, a.axis[2]);
+	r.row[3] = vector_zero();
+	absr.row[0] = vector_add(vector_abs(r.row[0]), epsilon);
+	absr.row[1] = vector_add(vector_abs(r.row[1]), epsilon);
+	absr.row[2] = vector_add(vector_abs(r.row[2]), epsilon);
+	absr.row[3] = vector_zero();
+	absrt = matrix_transpose(absr);
+
+	//Center offset in the frames of a and b
+	at.row[0] = a.axis[0];
+	at.row[1] = a.axis[1];
+	at.row[2] = a.axis[2];
+	at.row[3] = vector_zero();
+	at = matrix_transpose(at);
+	t = matrix_rotate(at, offset);
+	tb = matrix_rotate(bt, offset);
+
+	ax = vector_shuffle(a.extent, VECTOR_MASK_XXXX);
+	ay = vector_shuffle(a.extent, VECTOR_MASK_YYYY);
+	az = vector_shuffle(a.extent, VECTOR_MASK_ZZZZ);
+	bx = vector_shuffle(b.extent, VECTOR_MASK_XXXX);
+	by = vector_shuffle(b.extent, VECTOR_MASK_YYYY);
+	bz = vector_shuffle(b.extent, VECTOR_MASK_ZZZZ);
+	b_yzx = vector_shuffle(b.extent, VECTOR_MASK_YZXW);
+	b_zxy = vector_shuffle(b.extent, VECTOR_MASK_ZXYW);
+
+	//Axes of a, lane i
+	rhs = vector_muladd(absrt.row[0], bx, vector_muladd(absrt.row[1], by, vector_muladd(absrt.row[2], bz, a.extent)));
+	separated = vector_cmpgt(vector_abs(t), rhs);
+
+	//Axes of b, lane j
+	rhs = vector_muladd(absr.row[0], ax, vector_muladd(absr.row[1], ay, vector_muladd(absr.row[2], az, b.extent)));
+	separated = vector_or(separated, vector_cmpgt(vector_abs(tb), rhs));
+
+	//Cross products of axis i of a with axis j of b, one vector per axis of a with lane j
+	lhs = vector_sub(vector_mul(vector_shuffle(t, VECTOR_MASK_ZZZZ), r.row[1]),
+	                 vector_mul(vector_shuffle(t, VECTOR_MASK_YYYY), r.row[2]));
+	rhs = vector_muladd(ay, absr.row[2], vector_mul(az, absr.row[1]));
+	rhs = vector_muladd(b_yzx, vector_shuffle(absr.row[0], VECTOR_MASK_ZXYW), rhs);
+	rhs = vector_muladd(b_zxy, vector_shuffle(absr.row[0], VECTOR_MASK_YZXW), rhs);
+	separated = vector_or(separated, vector_cmpgt(vector_abs(lhs), rhs));
+
+	lhs = vector_sub(vector_mul(vector_shuffle(t, VECTOR_MASK_XXXX), r.row[2]),
+	                 vector_mul(vector_shuffle(t, VECTOR_MASK_ZZZZ), r.row[0]));
+	rhs = vector_muladd(az, absr.row[0], vector_mul(ax, absr.row[2]));
+	rhs = vector_muladd(b_yzx, vector_shuffle(absr.row[1], VECTOR_MASK_ZXYW), rhs);
+	rhs = vector_muladd(b_zxy, vector_shuffle(absr.row[1], VECTOR_MASK_YZXW), rhs);
+	separated = vector_or(separated, vector_cmpgt(vector_abs(lhs), rhs));
+
+	lhs = vector_sub(vector_mul(vector_shuffle(t, VECTOR_MASK_YYYY), r.row[0]),
+	                 vector_mul(vector_shuffle(t, VECTOR_MASK_XXXX), r.row[1]));
+	rhs = vector_muladd(ax, absr.row[1], vector_mul(ay, absr.row[0]));
+	rhs = vector_muladd(b_yzx, vector_shuffle(absr.row[2], VECTOR_MASK_ZXYW), rhs);
+	rhs = vector_muladd(b_zxy, vector_shuffle(absr.row[2], VECTOR_MASK_YZXW), rhs);
+	separated = vector_or(separated, vector_cmpgt(vector_abs(lhs), rhs));
+
+	return (vector_movemask(separated) & VECTOR_LANES_XYZ) == 0;
+}
@@ -0,0 +1,233 @@
+/* octahedral.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+
+#if FOUNDATION_ARCH_SSE4
+#  include <smmintrin.h>
+#endif
+
+static FOUNDATION_FORCEINLINE uint32_t
+octahedral_quantize(real v, real scale) {
+	const real unorm = math_clamp(v * REAL_C(0.5) + REAL_C(0.5), 0, REAL_C(1.0));
+	return (uint32_t)(unorm * scale + REAL_C(0.5));
+}
+
+static FOUNDATION_FORCEINLINE real
+octahedral_dequantize(uint32_t q, real scale) {
+	return ((real)q / scale) * REAL_C(2.0) - REAL_C(1.0);
+}
+
+static FOUNDATION_FORCEINLINE uint32_t
+octahedral_encode_bits(const vector_t v, unsigned int bits) {
+	const real scale = (real)((1U << bits) - 1);
+	const vector_t e = vector_octahedral_encode(v);
+	return octahedral_quantize(vector_x(e), scale) | (octahedral_quantize(vector_y(e), scale) << bits);
+}
+
+static FOUNDATION_FORCEINLINE vector_t
+octahedral_decode_bits(uint32_t packed, unsigned int bits) {
+	const uint32_t mask = (1U << bits) - 1;
+	const real scale = (real)mask;
+	return vector_octahedral_decode(vector(octahedral_dequantize(packed & mask, scale),
+	                                       octahedral_dequantize((packed >> bits) & mask, scale), 0, 0));
+}
+
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+
+/* Kernels work on four directions at a time in SoA form. Sign handling uses the
+   same bit masks as vector_abs, folding the lower hemisphere with a select on the
+   z < 0 comparison mask */
+
+static FOUNDATION_FORCEINLINE __m128i
+octahedral_encode4(const vector_t* FOUNDATION_RESTRICT src, unsigned int bits) {
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 scale = _mm_set1_ps((float)((1U << bits) - 1));
+
+	__m128 x = src[0];
+	__m128 y = src[1];
+	__m128 z = src[2];
+	__m128 w = src[3];
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	const __m128 ax = _mm_and_ps(x, abs_mask);
+	const __m128 ay = _mm_and_ps(y, abs_mask);
+	const __m128 az = _mm_and_ps(z, abs_mask);
+	const __m128 len = _mm_max_ps(_mm_add_ps(_mm_add_ps(ax, ay), az), _mm_set1_ps(REAL_MIN));
+	const __m128 inv_len = _mm_div_ps(one, len);
+	const __m128 u = _mm_mul_ps(x, inv_len);
+	const __m128 v = _mm_mul_ps(y, inv_len);
+
+	//Fold: (1 - |v|, 1 - |u|) is non-negative, so or:ing in the sign bit applies the sign
+	const __m128 fold_u = _mm_or_ps(_mm_sub_ps(one, _mm_and_ps(v, abs_mask)), _mm_and_ps(u, sign_mask));
+	const __m128 fold_v = _mm_or_ps(_mm_sub_ps(one, _mm_and_ps(u, abs_mask)), _mm_and_ps(v, sign_mask));
+	const __m128 lower = vector_cmplt(z, _mm_setzero_ps());
+	const __m128 eu = vector_select(lower, fold_u, u);
+	const __m128 ev = vector_select(lower, fold_v, v);
+
+	//Map [-1, 1] to [0, scale], round to nearest
+	const __m128 qu = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(eu, half), half), _mm_setzero_ps()), one);
+	const __m128 qv = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(ev, half), half), _mm_setzero_ps()), one);
+	const __m128i iu = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(qu, scale), half));
+	const __m128i iv = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(qv, scale), half));
+	return _mm_or_si128(iu, _mm_slli_epi32(iv, (int)bits));
+}
+
+static FOUNDATION_FORCEINLINE void
+octahedral_decode4(vector_t* FOUNDATION_RESTRICT dst, const __m128i packed, unsigned int bits) {
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128i mask = _mm_set1_epi32((int)((1U << bits) - 1));
+	const __m128 scale = _mm_set1_ps(2.0f / (float)((1U << bits) - 1));
+
+	__m128 x = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, mask)), scale), one);
+	__m128 y = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, (int)bits), mask)),
+	                                 scale), one);
+	__m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_and_ps(x, abs_mask)), _mm_and_ps(y, abs_mask));
+
+	//Unfold: fold amount is non-negative, give it the sign of the coordinate and subtract
+	const __m128 fold = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+	x = _mm_sub_ps(x, _mm_or_ps(fold, _mm_and_ps(x, sign_mask)));
+	y = _mm_sub_ps(y, _mm_or_ps(fold, _mm_and_ps(y, sign_mask)));
+
+	const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+	const __m128 inv_len = _mm_div_ps(one, len);
+	x = _mm_mul_ps(x, inv_len);
+	y = _mm_mul_ps(y, inv_len);
+	z = _mm_mul_ps(z, inv_len);
+	__m128 w = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	dst[0] = x;
+	dst[1] = y;
+	dst[2] = z;
+	dst[3] = w;
+}
+
+#endif
+
+void
+vector_octahedral_encode16(uint16_t* FOUNDATION_RESTRICT dst, const vector_t* FOUNDATION_RESTRICT src,
+                           size_t count) {
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4) {
+		const __m128i packed = octahedral_encode4(src + i, 8);
+#if FOUNDATION_ARCH_SSE4
+		_mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi32(packed, packed));
+#else
+		//No unsigned 32->16 pack in SSE2, bias to signed range and back
+		const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+		const __m128i biased = _mm_sub_epi32(packed, _mm_set1_epi32(0x8000));
+		_mm_storel_epi64((__m128i*)(dst + i), _mm_xor_si128(_mm_packs_epi32(biased, biased), bias16));
+#endif
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = (uint16_t)octahedral_encode_bits(src[i], 8);
+}
+
+void
+vector_octahedral_encode24(uint8_t* FOUNDATION_RESTRICT dst, const vector_t* FOUNDATION_RESTRICT src,
+                           size_t count) {
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4) {
+		FOUNDATION_ALIGN(16) uint32_t packed[4];
+		_mm_store_si128((__m128i*)packed, octahedral_encode4(src + i, 12));
+		for (int j = 0; j < 4; ++j) {
+			uint8_t* out = dst + ((i + (size_t)j) * 3);
+			out[0] = (uint8_t)(packed[j] & 0xFF);
+			out[1] = (uint8_t)((packed[j] >> 8) & 0xFF);
+			out[2] = (uint8_t)((packed[j] >> 16) & 0xFF);
+		}
+	}
+#endif
+	for (; i < count; ++i) {
+		const uint32_t packed = octahedral_encode_bits(src[i], 12);
+		uint8_t* out = dst + (i * 3);
+		out[0] = (uint8_t)(packed & 0xFF);
+		out[1] = (uint8_t)((packed >> 8) & 0xFF);
+		out[2] = (uint8_t)((packed >> 16) & 0xFF);
+	}
+}
+
+void
+vector_octahedral_encode32(uint32_t* FOUNDATION_RESTRICT dst, const vector_t* FOUNDATION_RESTRICT src,
+                           size_t count) {
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_si128((__m128i*)(dst + i), octahedral_encode4(src + i, 16));
+#endif
+	for (; i < count; ++i)
+		dst[i] = octahedral_encode_bits(src[i], 16);
+}
+
+void
+vector_octahedral_decode16(vector_t* FOUNDATION_RESTRICT dst, const uint16_t* FOUNDATION_RESTRICT src,
+                           size_t count) {
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4) {
+		const __m128i packed = _mm_loadl_epi64((const __m128i*)(src + i));
+#if FOUNDATION_ARCH_SSE4
+		octahedral_decode4(dst + i, _mm_cvtepu16_epi32(packed), 8);
+#else
+		octahedral_decode4(dst + i, _mm_unpacklo_epi16(packed, _mm_setzero_si128()), 8);
+#endif
+	}
+#endif
+	for (; i < count; ++i)
+		dst[i] = octahedral_decode_bits(src[i], 8);
+}
+
+void
+vector_octahedral_decode24(vector_t* FOUNDATION_RESTRICT dst, const uint8_t* FOUNDATION_RESTRICT src,
+                           size_t count) {
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4) {
+		const uint8_t* in = src + (i * 3);
+		const __m128i packed = _mm_setr_epi32(
+		                           (int)((uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16)),
+		                           (int)((uint32_t)in[3] | ((uint32_t)in[4] << 8) | ((uint32_t)in[5] << 16)),
+		                           (int)((uint32_t)in[6] | ((uint32_t)in[7] << 8) | ((uint32_t)in[8] << 16)),
+		                           (int)((uint32_t)in[9] | ((uint32_t)in[10] << 8) | ((uint32_t)in[11] << 16)));
+		octahedral_decode4(dst + i, packed, 12);
+	}
+#endif
+	for (; i < count; ++i) {
+		const uint8_t* in = src + (i * 3);
+		dst[i] = octahedral_decode_bits((uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16), 12);
+	}
+}
+
+void
+vector_octahedral_decode32(vector_t* FOUNDATION_RESTRICT dst, const uint32_t* FOUNDATION_RESTRICT src,
+                           size_t count) {
+	size_t i = 0;
+#if FOUNDATION_ARCH_SSE4 || FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE2
+	for (; i + 4 <= count; i += 4)
+		octahedral_decode4(dst + i, _mm_loadu_si128((const __m128i*)(src + i)), 16);
+#endif
+	for (; i < count; ++i)
+		dst[i] = octahedral_decode_bits(src[i], 16);
+}
@@ -0,0 +1,96 @@
+/* octahedral.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file octahedral.h
+    Octahedral encoding of unit direction vectors. The direction is projected on the
+    octahedron |x| + |y| + |z| = 1 and the lower hemisphere is folded out over the
+    diagonals, giving two coordinates in [-1, 1] which are quantized to 8, 12 or 16 bits
+    each for the 16, 24 and 32 bit packed formats. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+
+//! Encode direction [x, y, z, -] to octahedral coordinates [u, v, 0, 0] in [-1, 1]
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_octahedral_encode(const vector_t v);
+
+//! Decode octahedral coordinates [u, v, -, -] to unit direction [x, y, z, 0]
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_octahedral_decode(const vector_t e);
+
+//! Encode array of directions to 16 bit packed form, 8 bits per coordinate
+VECTOR_API void
+vector_octahedral_encode16(uint16_t* FOUNDATION_RESTRICT dst, const vector_t* FOUNDATION_RESTRICT src,
+                           size_t count);
+
+//! Encode array of directions to 24 bit packed form, 12 bits per coordinate,
+//  stored as three consecutive bytes per direction (dst must hold 3 * count bytes)
+VECTOR_API void
+vector_octahedral_encode24(uint8_t* FOUNDATION_RESTRICT dst, const vector_t* FOUNDATION_RESTRICT src,
+                           size_t count);
+
+//! Encode array of directions to 32 bit packed form, 16 bits per coordinate
+VECTOR_API void
+vector_octahedral_encode32(uint32_t* FOUNDATION_RESTRICT dst, const vector_t* FOUNDATION_RESTRICT src,
+                           size_t count);
+
+//! Decode array of 16 bit packed directions to unit vectors [x, y, z, 0]
+VECTOR_API void
+vector_octahedral_decode16(vector_t* FOUNDATION_RESTRICT dst, const uint16_t* FOUNDATION_RESTRICT src,
+                           size_t count);
+
+//! Decode array of 24 bit packed directions to unit vectors [x, y, z, 0]
+VECTOR_API void
+vector_octahedral_decode24(vector_t* FOUNDATION_RESTRICT dst, const uint8_t* FOUNDATION_RESTRICT src,
+                           size_t count);
+
+//! Decode array of 32 bit packed directions to unit vectors [x, y, z, 0]
+VECTOR_API void
+vector_octahedral_decode32(vector_t* FOUNDATION_RESTRICT dst, const uint32_t* FOUNDATION_RESTRICT src,
+                           size_t count);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_octahedral_encode(const vector_t v) {
+	const real x = vector_x(v);
+	const real y = vector_y(v);
+	const real z = vector_z(v);
+	const real len = math_abs(x) + math_abs(y) + math_abs(z);
+	const real inv_len = (len > 0) ? REAL_C(1.0) / len : 0;
+	real u = x * inv_len;
+	real w = y * inv_len;
+	if (z < 0) {
+		const real fold_u = (REAL_C(1.0) - math_abs(w)) * ((u >= 0) ? REAL_C(1.0) : REAL_C(-1.0));
+		const real fold_w = (REAL_C(1.0) - math_abs(u)) * ((w >= 0) ? REAL_C(1.0) : REAL_C(-1.0));
+		u = fold_u;
+		w = fold_w;
+	}
+	return vector(u, w, 0, 0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_octahedral_decode(const vector_t e) {
+	real x = vector_x(e);
+	real y = vector_y(e);
+	const real z = REAL_C(1.0) - math_abs(x) - math_abs(y);
+	const real fold = (z < 0) ? -z : 0;
+	x += (x >= 0) ? -fold : fold;
+	y += (y >= 0) ? -fold : fold;
+	//Full precision normalization, the rsqrt estimate would dominate the 16 bit quantization error
+	const vector_t d = vector(x, y, z, 0);
+	return vector_div(d, vector_length3(d));
+}
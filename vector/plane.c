@@ -0,0 +1,101 @@
+/* plane.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/plane.h>
+
+//Broadcast plane components to all lanes
+static FOUNDATION_FORCEINLINE void
+plane_splat(vector_t* splat, const plane_t p) {
+	splat[0] = vector_shuffle(p, VECTOR_MASK_XXXX);
+	splat[1] = vector_shuffle(p, VECTOR_MASK_YYYY);
+	splat[2] = vector_shuffle(p, VECTOR_MASK_ZZZZ);
+	splat[3] = vector_shuffle(p, VECTOR_MASK_WWWW);
+}
+
+/* Signed distances of up to four points, one per lane. The last group of an array is
+   padded with the origin so all points use the same evaluation order, and a point gets
+   the same distance and classification regardless of its position in the array */
+static FOUNDATION_FORCEINLINE vector_t
+plane_distance_lanes(const vector_t* splat, const vector_t* points, size_t num) {
+	matrix_t soa;
+	vector_t dist;
+	soa.row[0] = points[0];
+	soa.row[1] = (num > 1) ? points[1] : vector_zero();
+	soa.row[2] = (num > 2) ? points[2] : vector_zero();
+	soa.row[3] = (num > 3) ? points[3] : vector_zero();
+	soa = matrix_transpose(soa);
+	dist = vector_muladd(splat[0], soa.row[0], splat[3]);
+	dist = vector_muladd(splat[1], soa.row[1], dist);
+	return vector_muladd(splat[2], soa.row[2], dist);
+}
+
+static FOUNDATION_FORCEINLINE void
+plane_store_lanes(real* distance, const vector_t dist, size_t num) {
+	if (num == 4) {
+		memcpy(distance, &dist, sizeof(vector_t));
+	}
+	else {
+		int lane;
+		for (lane = 0; lane < (int)num; ++lane)
+			distance[lane] = vector_component(dist, lane);
+	}
+}
+
+void
+plane_array_distance(real* distance, const plane_t p, const vector_t* points, size_t count) {
+	vector_t splat[4];
+	size_t i;
+	plane_splat(splat, p);
+	for (i = 0; i < count; i += 4) {
+		const size_t num = (count - i < 4) ? count - i : 4;
+		plane_store_lanes(distance + i, plane_distance_lanes(splat, points + i, num), num);
+	}
+}
+
+unsigned int
+plane_array_classify(uint32_t* front, uint32_t* back, real* distance, const plane_t p, const vector_t* points,
+                     size_t count, const real epsilon) {
+	const vector_t front_limit = vector_uniform(epsilon);
+	const vector_t back_limit = vector_uniform(-epsilon);
+	vector_t splat[4];
+	uint32_t front_bits = 0;
+	uint32_t back_bits = 0;
+	uint32_t any_front = 0;
+	uint32_t any_back = 0;
+	size_t i;
+
+	plane_splat(splat, p);
+	for (i = 0; i < count; i += 4) {
+		const size_t num = (count - i < 4) ? count - i : 4;
+		const unsigned int lanes = (1U << num) - 1;
+		const unsigned int shift = (unsigned int)(i & 31);
+		const vector_t dist = plane_distance_lanes(splat, points + i, num);
+		if (distance)
+			plane_store_lanes(distance + i, dist, num);
+		front_bits |= (uint32_t)(vector_movemask(vector_cmpgt(dist, front_limit)) & lanes) << shift;
+		back_bits |= (uint32_t)(vector_movemask(vector_cmplt(dist, back_limit)) & lanes) << shift;
+		if ((shift == 28) || (i + 4 >= count)) {
+			front[i >> 5] = front_bits;
+			back[i >> 5] = back_bits;
+			any_front |= front_bits;
+			any_back |= back_bits;
+			front_bits = 0;
+			back_bits = 0;
+		}
+	}
+	return (any_front ? PLANE_FRONT : 0) | (any_back ? PLANE_BACK : 0);
+}
@@ -0,0 +1,133 @@
+/* plane.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file plane.h
+    Planes stored as [nx, ny, nz, d] in a single vector, the signed distance of a point p
+    is dot(n, p) + d, positive on the front side the normal points to. Distances are in
+    world units for planes with unit length normals, see plane_normalize.
+
+    The array functions evaluate four points at a time in SoA form and write packed
+    distances and front/back bit masks, one bit per point with point i in bit (i % 32)
+    of word i / 32. Points within epsilon of the plane are on the plane and set neither
+    bit, so clipping and splitting code can treat them as shared by both sides. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/matrix.h>
+
+//! Point is in front of the plane
+#define PLANE_FRONT 1U
+//! Point is behind the plane
+#define PLANE_BACK 2U
+//! Points on both sides of the plane
+#define PLANE_SPANNING (PLANE_FRONT | PLANE_BACK)
+
+//! Construct plane from normal and distance term, dot(normal, p) + d is zero on the plane
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane(const vector_t normal, const real d);
+
+//! Construct plane through point with given normal
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_from_point_normal(const vector_t point, const vector_t normal);
+
+/*! Construct plane through three points with unit length normal, the front side is the
+    side the points are seen in counter-clockwise order from. Points must not be colinear */
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_from_points(const vector_t p0, const vector_t p1, const vector_t p2);
+
+//! Scale plane to unit length normal
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_normalize(const plane_t p);
+
+//! Plane with the front and back sides swapped
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_flip(const plane_t p);
+
+//! Normal of plane as [nx, ny, nz, 0]
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+plane_normal(const plane_t p);
+
+//! Signed distance from plane to point, w component of point is ignored
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
+plane_distance(const plane_t p, const vector_t point);
+
+//! Closest point on plane, plane must be normalized
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+plane_project(const plane_t p, const vector_t point);
+
+//! Classify point as PLANE_FRONT, PLANE_BACK or zero if within epsilon of the plane
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+plane_classify(const plane_t p, const vector_t point, const real epsilon);
+
+//! Signed distances from plane to array of points
+VECTOR_API void
+plane_array_distance(real* distance, const plane_t p, const vector_t* points, size_t count);
+
+/*! Classify array of points, writing front and back bit masks of (count + 31) / 32 words
+    and, if distance is not null, the signed distances. Returns the union of the point
+    classes, PLANE_SPANNING if the points must be split and zero if all are on the plane */
+VECTOR_API unsigned int
+plane_array_classify(uint32_t* front, uint32_t* back, real* distance, const plane_t p, const vector_t* points,
+                     size_t count, const real epsilon);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane(const vector_t normal, const real d) {
+	return vector_blend(normal, vector_uniform(d), VECTOR_BLEND_0001);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_from_point_normal(const vector_t point, const vector_t normal) {
+	return vector_blend(normal, vector_neg(vector_dot3(normal, point)), VECTOR_BLEND_0001);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_from_points(const vector_t p0, const vector_t p1, const vector_t p2) {
+	const vector_t normal = vector_cross3(vector_sub(p1, p0), vector_sub(p2, p0));
+	return plane_normalize(plane_from_point_normal(p0, normal));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_normalize(const plane_t p) {
+	return vector_div(p, vector_length3(p));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL plane_t
+plane_flip(const plane_t p) {
+	return vector_neg(p);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+plane_normal(const plane_t p) {
+	return vector_blend(p, vector_zero(), VECTOR_BLEND_0001);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
+plane_distance(const plane_t p, const vector_t point) {
+	return vector_x(vector_dot(p, vector_blend(point, vector_one(), VECTOR_BLEND_0001)));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+plane_project(const plane_t p, const vector_t point) {
+	return vector_sub(point, vector_scale(plane_normal(p), plane_distance(p, point)));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+plane_classify(const plane_t p, const vector_t point, const real epsilon) {
+	const real distance = plane_distance(p, point);
+	return (distance > epsilon) ? PLANE_FRONT : ((distance < -epsilon) ? PLANE_BACK : 0);
+}
@@ -83,3 +83,7 @@ quaternion_rotate(const quaternion_t q, const vector_t v);
 #  include <vector/quaternion_fallback.h>
 #endif
 
+#if VECTOR_VALIDATE
+#  define VECTOR_VALIDATE_QUATERNION_COMPLETE 1
+#  include <vector/validate.h>
+#endif
@@ -66,7 +66,8 @@ quaternion_conjugate(const quaternion_t q) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL quaternion_t
 quaternion_inverse(const quaternion_t q) {
-	return vector_div(q, vector_mul(vector_length_sqr(q), vector_aligned(_inverse_quat)));
+	const vector_t inv_norm = vector_div(vector_one(), vector_length_sqr(q));
+	return vector_mul(q, vector_mul(inv_norm, vector_aligned(_inverse_quat)));
 }
 
 #endif
@@ -93,11 +94,13 @@ quaternion_normalize(const quaternion_t q) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL quaternion_t
 quaternion_mul(const quaternion_t q0, const quaternion_t q1) {
+	const real q0x = vector_x(q0), q0y = vector_y(q0), q0z = vector_z(q0), q0w = vector_w(q0);
+	const real q1x = vector_x(q1), q1y = vector_y(q1), q1z = vector_z(q1), q1w = vector_w(q1);
 	return vector(
-	           q1.w * q0.x + q1.x * q0.w + q1.y * q0.z - q1.z * q0.y,
-	           q1.w * q0.y - q1.x * q0.z + q1.y * q0.w + q1.z * q0.x,
-	           q1.w * q0.z + q1.x * q0.y - q1.y * q0.x + q1.z * q0.w,
-	           q1.w * q0.w - q1.x * q0.x - q1.y * q0.y - q1.z * q0.z);
+	           q1w * q0x + q1x * q0w + q1y * q0z - q1z * q0y,
+	           q1w * q0y - q1x * q0z + q1y * q0w + q1z * q0x,
+	           q1w * q0z + q1x * q0y - q1y * q0x + q1z * q0w,
+	           q1w * q0w - q1x * q0x - q1y * q0y - q1z * q0z);
 }
 
 #endif
@@ -184,23 +187,13 @@ quaternion_rotate(const quaternion_t q, const vector_t v) {
 	//t = 2 * cross(q.xyz, v)
 	//v' = v + q.w * t + cross(q.xyz, t)
 
-	vector_t v1 = vector_cross3(q, v);
+	const vector_t qw = vector_shuffle(q, VECTOR_MASK_WWWW);
+	const vector_t v1 = vector_muladd(v, qw, vector_cross3(q, v));
+	const vector_t v2 = vector_cross3(v1, q);
+	const vector_t dot = vector_dot3(q, v);
+	const vector_t r = vector_sub(vector_muladd(v1, qw, vector_mul(q, dot)), v2);
 
-	v1.x += v.x * q.w;
-	v1.y += v.y * q.w;
-	v1.z += v.z * q.w;
-
-	vector_t v2 = vector_cross3(v1, q);
-	float32_t dot = (q.x * v.x + q.y * v.y + q.z * v.z);
-
-	vector_t r = {
-		q.x* dot + v1.x* q.w - v2.x,
-		q.y* dot + v1.y* q.w - v2.y,
-		q.z* dot + v1.z* q.w - v2.z,
-		v.w
-	};
-
-	return r;
+	return vector(vector_x(r), vector_y(r), vector_z(r), vector_w(v));
 }
 
 #endif
@@ -14,52 +14,54 @@
  *
  */
 
-#ifndef VECTOR_HAVE_QUATERNION_MUL
+//Deterministic mode uses the generic versions to match the fallback summation order
+#if !defined( VECTOR_HAVE_QUATERNION_MUL ) && !VECTOR_DETERMINISTIC
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL quaternion_t
 quaternion_mul(const quaternion_t q0, const quaternion_t q1) {
 	//From http://momchil-velikov.blogspot.de/2013/10/fast-sse-quternion-multiplication.html
-	const vector_t q0_wwww = vector_shuffle(q0, VECTOR_MASK_WWWW);
-	const vector_t q1_yxwz = vector_shuffle(q1, VECTOR_MASK_YXWZ);
-	const vector_t q0_xxxx = vector_shuffle(q0, VECTOR_MASK_XXXX);
-	const vector_t q1_zwxy = vector_shuffle(q1, VECTOR_MASK_ZWXY);
-	const vector_t q0_yyyy = vector_shuffle(q0, VECTOR_MASK_YYYY);
-	const vector_t q1_ywxz = vector_shuffle(q1, VECTOR_MASK_YWXZ);
+	//computing the Hamilton product q1 * q0 to match the generic version, q0 is applied first
+	const vector_t q1_wwww = vector_shuffle(q1, VECTOR_MASK_WWWW);
+	const vector_t q0_yxwz = vector_shuffle(q0, VECTOR_MASK_YXWZ);
+	const vector_t q1_xxxx = vector_shuffle(q1, VECTOR_MASK_XXXX);
+	const vector_t q0_zwxy = vector_shuffle(q0, VECTOR_MASK_ZWXY);
+	const vector_t q1_yyyy = vector_shuffle(q1, VECTOR_MASK_YYYY);
+	const vector_t q0_ywxz = vector_shuffle(q0, VECTOR_MASK_YWXZ);
 
-	/* q0.w * q1.yxwz */
-	const vector_t q0w_q1yxzw = _mm_mul_ps(q0_wwww, q1_yxwz);
+	/* q1.w * q0.yxwz */
+	const vector_t q1w_q0yxzw = _mm_mul_ps(q1_wwww, q0_yxwz);
 
-	/* q0.x * q1.zwxy */
-	const vector_t q0x_q1zwxy = _mm_mul_ps(q0_xxxx, q1_zwxy);
+	/* q1.x * q0.zwxy */
+	const vector_t q1x_q0zwxy = _mm_mul_ps(q1_xxxx, q0_zwxy);
 
-	/* q0.y * q1.ywxz */
-	const vector_t q0y_q1ywxz = _mm_mul_ps(q0_yyyy, q1_ywxz);
+	/* q1.y * q0.ywxz */
+	const vector_t q1y_q0ywxz = _mm_mul_ps(q1_yyyy, q0_ywxz);
 
-	/* q0.z * q1.yxzw */
-	const vector_t q0_zzzz = vector_shuffle(q0, VECTOR_MASK_ZZZZ);
-	const vector_t q1_yxzw = vector_shuffle(q1, VECTOR_MASK_YXZW);
-	const vector_t q0z_q1yxzw = _mm_mul_ps(q0_zzzz, q1_yxzw);
+	/* q1.z * q0.yxzw */
+	const vector_t q1_zzzz = vector_shuffle(q1, VECTOR_MASK_ZZZZ);
+	const vector_t q0_yxzw = vector_shuffle(q0, VECTOR_MASK_YXZW);
+	const vector_t q1z_q0yxzw = _mm_mul_ps(q1_zzzz, q0_yxzw);
 
 #if FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE4
-	vector_t e = _mm_addsub_ps(q0w_q1yxzw, q0x_q1zwxy);
+	vector_t e = _mm_addsub_ps(q1w_q0yxzw, q1x_q0zwxy);
 #else
 	static const FOUNDATION_ALIGN(16) float32_t signs[] = {-1, 1, -1, 1};
 	const vector_t signshuffle = vector_aligned(signs);
-	vector_t e = _mm_add_ps(q0w_q1yxzw, _mm_mul_ps(q0x_q1zwxy, signshuffle));
+	vector_t e = _mm_add_ps(q1w_q0yxzw, _mm_mul_ps(q1x_q0zwxy, signshuffle));
 #endif
 	e = vector_shuffle(e, VECTOR_MASK_ZXWY);
 
 #if FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE4
-	e = _mm_addsub_ps(e, q0y_q1ywxz);
+	e = _mm_addsub_ps(e, q1y_q0ywxz);
 #else
-	e = _mm_add_ps(e, _mm_mul_ps(q0y_q1ywxz, signshuffle));
+	e = _mm_add_ps(e, _mm_mul_ps(q1y_q0ywxz, signshuffle));
 #endif
 	e = vector_shuffle(e, VECTOR_MASK_WYXZ);
 
 #if FOUNDATION_ARCH_SSE3 || FOUNDATION_ARCH_SSE4
-	e = _mm_addsub_ps(e, q0z_q1yxzw);
+	e = _mm_addsub_ps(e, q1z_q0yxzw);
 #else
-	e = _mm_add_ps(e, _mm_mul_ps(q0z_q1yxzw, signshuffle));
+	e = _mm_add_ps(e, _mm_mul_ps(q1z_q0yxzw, signshuffle));
 #endif
 	return vector_shuffle(e, VECTOR_MASK_XYWZ);
 }
@@ -67,7 +69,7 @@ quaternion_mul(const quaternion_t q0, const quaternion_t q1) {
 
 #endif
 
-#ifndef VECTOR_HAVE_QUATERNION_ROTATE
+#if !defined( VECTOR_HAVE_QUATERNION_ROTATE ) && !VECTOR_DETERMINISTIC
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 quaternion_rotate(const quaternion_t q, const vector_t v) {
@@ -75,7 +77,7 @@ quaternion_rotate(const quaternion_t q, const vector_t v) {
 	const vector_t qw = vector_shuffle(q, VECTOR_MASK_WWWW);
 	const vector_t v2 = vector_muladd(v, qw, v1);
 	const vector_t v3 = vector_cross3(v2, q);
-	const vector_t dot = vector_dot(q, v);
+	const vector_t dot = vector_dot3(q, v);
 	const vector_t v4 = vector_muladd(v2, qw, vector_neg(v3));
 	const vector_t r = vector_muladd(q, dot, v4);
 	return r;
@@ -0,0 +1,196 @@
+/* ray.c  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#include <vector/vector.h>
+#include <vector/ray.h>
+
+/* Moller-Trumbore on four lanes, each argument is the x, y, z component vectors of the
+   lanes. Used with broadcast ray components for one ray against four triangles and with
+   broadcast triangle components for four rays against one triangle. Returns the mask of
+   lanes hit in [0, tmax] with distance and barycentric coordinates in t, u, v */
+static FOUNDATION_FORCEINLINE vector_t
+ray_intersect_lanes(const vector_t* origin, const vector_t* direction, const vector_t* v0, const vector_t* edge1,
+                    const vector_t* edge2, const vector_t tmax, vector_t* t, vector_t* u, vector_t* v) {
+	const vector_t zero = vector_zero();
+	const vector_t one = vector_one();
+
+	const vector_t px = vector_sub(vector_mul(direction[1], edge2[2]), vector_mul(direction[2], edge2[1]));
+	const vector_t py = vector_sub(vector_mul(direction[2], edge2[0]), vector_mul(direction[0], edge2[2]));
+	const vector_t pz = vector_sub(vector_mul(direction[0], edge2[1]), vector_mul(direction[1], edge2[0]));
+	const vector_t det = vector_muladd(edge1[0], px, vector_muladd(edge1[1], py, vector_mul(edge1[2], pz)));
+	//Degenerate and parallel lanes divide by one, keeping the padding lanes of packets finite
+	const vector_t nonzero = vector_cmpneq(det, zero);
+	const vector_t inv_det = vector_div(one, vector_select(nonzero, det, one));
+
+	const vector_t tx = vector_sub(origin[0], v0[0]);
+	const vector_t ty = vector_sub(origin[1], v0[1]);
+	const vector_t tz = vector_sub(origin[2], v0[2]);
+	*u = vector_mul(vector_muladd(tx, px, vector_muladd(ty, py, vector_mul(tz, pz))), inv_det);
+
+	const vector_t qx = vector_sub(vector_mul(ty, edge1[2]), vector_mul(tz, edge1[1]));
+	const vector_t qy = vector_sub(vector_mul(tz, edge1[0]), vector_mul(tx, edge1[2]));
+	const vector_t qz = vector_sub(vector_mul(tx, edge1[1]), vector_mul(ty, edge1[0]));
+	*v = vector_mul(vector_muladd(direction[0], qx, vector_muladd(direction[1], qy, vector_mul(direction[2], qz))),
+	                inv_det);
+	*t = vector_mul(vector_muladd(edge2[0], qx, vector_muladd(edge2[1], qy, vector_mul(edge2[2], qz))), inv_det);
+
+	//Degenerate and parallel lanes are masked out by the determinant test, not by NaN compares
+	vector_t mask = vector_and(nonzero, vector_cmpge(*u, zero));
+	mask = vector_and(mask, vector_cmpge(*v, zero));
+	mask = vector_and(mask, vector_cmple(vector_add(*u, *v), one));
+	mask = vector_and(mask, vector_cmpge(*t, zero));
+	return vector_and(mask, vector_cmple(*t, tmax));
+}
+
+size_t
+ray_intersect_aabbs(uint32_t* hits, const ray_t r, const aabb_packet_t* packets, size_t count, real tmax) {
+	const ray_slab_t slab = ray_slab(r);
+	const vector_t limit = vector_uniform(tmax);
+	size_t num_hits = 0;
+	size_t i = 0;
+	vector_t tnear;
+	unsigned int lanes;
+	for (; i + 4 <= count; i += 4, ++packets) {
+		//Branch free compaction as in frustum culling
+		lanes = ray_intersect_aabb_packet(&tnear, &slab, packets, limit);
+		hits[num_hits] = (uint32_t)i;
+		num_hits += lanes & 1;
+		hits[num_hits] = (uint32_t)i + 1;
+		num_hits += (lanes >> 1) & 1;
+		hits[num_hits] = (uint32_t)i + 2;
+		num_hits += (lanes >> 2) & 1;
+		hits[num_hits] = (uint32_t)i + 3;
+		num_hits += (lanes >> 3) & 1;
+	}
+	if (i < count) {
+		//Mask the empty boxes padding the last packet
+		lanes = ray_intersect_aabb_packet(&tnear, &slab, packets, limit) & ((1U << (count - i)) - 1);
+		for (; lanes; lanes >>= 1, ++i) {
+			if (lanes & 1)
+				hits[num_hits++] = (uint32_t)i;
+		}
+	}
+	return num_hits;
+}
+
+void
+triangle_packet_build(triangle_packet_t* packets, const triangle_t* triangles, size_t count) {
+	size_t i;
+	for (i = 0; i < count; i += 4) {
+		matrix_t v0, edge1, edge2;
+		int lane;
+		for (lane = 0; lane < 4; ++lane) {
+			if (i + (size_t)lane < count) {
+				const triangle_t* triangle = triangles + i + lane;
+				v0.row[lane] = triangle->v[0];
+				edge1.row[lane] = vector_sub(triangle->v[1], triangle->v[0]);
+				edge2.row[lane] = vector_sub(triangle->v[2], triangle->v[0]);
+			}
+			else {
+				v0.row[lane] = vector_zero();
+				edge1.row[lane] = vector_zero();
+				edge2.row[lane] = vector_zero();
+			}
+		}
+		v0 = matrix_transpose(v0);
+		edge1 = matrix_transpose(edge1);
+		edge2 = matrix_transpose(edge2);
+		for (lane = 0; lane < 3; ++lane) {
+			packets->v0[lane] = v0.row[lane];
+			packets->edge1[lane] = edge1.row[lane];
+			packets->edge2[lane] = edge2.row[lane];
+		}
+		++packets;
+	}
+}
+
+bool
+ray_intersect_triangles(ray_hit_t* hit, const ray_t r, const triangle_packet_t* packets, size_t count) {
+	vector_t origin[3], direction[3];
+	vector_t tmax = vector_uniform(hit->t);
+	size_t num_packets = (count + 3) / 4;
+	size_t ipacket;
+	bool found = false;
+
+	origin[0] = vector_shuffle(r.origin, VECTOR_MASK_XXXX);
+	origin[1] = vector_shuffle(r.origin, VECTOR_MASK_YYYY);
+	origin[2] = vector_shuffle(r.origin, VECTOR_MASK_ZZZZ);
+	direction[0] = vector_shuffle(r.direction, VECTOR_MASK_XXXX);
+	direction[1] = vector_shuffle(r.direction, VECTOR_MASK_YYYY);
+	direction[2] = vector_shuffle(r.direction, VECTOR_MASK_ZZZZ);
+
+	for (ipacket = 0; ipacket < num_packets; ++ipacket) {
+		const triangle_packet_t* packet = packets + ipacket;
+		vector_t t, u, v;
+		const unsigned int lanes = vector_movemask(ray_intersect_lanes(origin, direction, packet->v0, packet->edge1,
+		                                                               packet->edge2, tmax, &t, &u, &v));
+		//Hits are rare compared to tests, resolve the closest lane in scalar code
+		if (lanes) {
+			int lane;
+			for (lane = 0; lane < 4; ++lane) {
+				if ((lanes & (1U << lane)) && (vector_component(t, lane) <= hit->t)) {
+					hit->t = vector_component(t, lane);
+					hit->u = vector_component(u, lane);
+					hit->v = vector_component(v, lane);
+					hit->index = (uint32_t)((ipacket * 4) + (size_t)lane);
+					found = true;
+				}
+			}
+			tmax = vector_uniform(hit->t);
+		}
+	}
+	return found;
+}
+
+unsigned int
+ray_packet_intersect_triangles(ray_packet_hit_t* hit, const ray_packet_t* rays, const triangle_t* triangles,
+                               size_t count) {
+	unsigned int updated = 0;
+	size_t itri;
+	for (itri = 0; itri < count; ++itri) {
+		const triangle_t* triangle = triangles + itri;
+		const vector_t edge1 = vector_sub(triangle->v[1], triangle->v[0]);
+		const vector_t edge2 = vector_sub(triangle->v[2], triangle->v[0]);
+		vector_t v0[3], e1[3], e2[3];
+		vector_t t, u, v, mask;
+		unsigned int lanes;
+		int lane;
+
+		v0[0] = vector_shuffle(triangle->v[0], VECTOR_MASK_XXXX);
+		v0[1] = vector_shuffle(triangle->v[0], VECTOR_MASK_YYYY);
+		v0[2] = vector_shuffle(triangle->v[0], VECTOR_MASK_ZZZZ);
+		e1[0] = vector_shuffle(edge1, VECTOR_MASK_XXXX);
+		e1[1] = vector_shuffle(edge1, VECTOR_MASK_YYYY);
+		e1[2] = vector_shuffle(edge1, VECTOR_MASK_ZZZZ);
+		e2[0] = vector_shuffle(edge2, VECTOR_MASK_XXXX);
+		e2[1] = vector_shuffle(edge2, VECTOR_MASK_YYYY);
+		e2[2] = vector_shuffle(edge2, VECTOR_MASK_ZZZZ);
+
+		mask = ray_intersect_lanes(rays->origin, rays->direction, v0, e1, e2, hit->t, &t, &u, &v);
+		lanes = vector_movemask(mask);
+		if (!lanes)
+			continue;
+		hit->t = vector_select(mask, t, hit->t);
+		hit->u = vector_select(mask, u, hit->u);
+		hit->v = vector_select(mask, v, hit->v);
+		for (lane = 0; lane < 4; ++lane) {
+			if (lanes & (1U << lane))
+				hit->index[lane] = (uint32_t)itri;
+		}
+		updated |= lanes;
+	}
+	return updated;
+}
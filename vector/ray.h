@@ -0,0 +1,253 @@
+/* ray.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+#pragma once
+
+/*! \file ray.h
+    Ray intersection. Triangle tests use the Moller-Trumbore algorithm and are two-sided,
+    hits are reported for distances in [0, t] where t is the distance of the closest hit so
+    far, so initialize the hit distance to the maximum ray length before the first query.
+    Barycentric coordinates u, v weight the second and third vertex, the hit point is
+    v0 + u * (v1 - v0) + v * (v2 - v0).
+
+    The array functions evaluate four triangles or four rays at a time in SoA form. Arrays
+    of triangles tested against single rays should be converted once to triangle packets
+    with triangle_packet_build.
+
+    Box tests use the slab method on the reciprocal ray direction, with vector_min and
+    vector_max ordering the entry and exit distances of each slab. Direction components
+    close to zero are replaced by a tiny value of the same sign, keeping distances finite
+    also in fast math builds. Boxes must not be empty, the inverted slabs of an empty box
+    are not detected, so the array functions mask the padding lanes of the last packet. */
+
+#include <vector/types.h>
+#include <vector/vector.h>
+#include <vector/matrix.h>
+
+//! Construct ray from origin and direction
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL ray_t
+ray(const vector_t origin, const vector_t direction);
+
+//! Point at distance t along ray
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+ray_point(const ray_t r, const real t);
+
+//! Convert four rays to SoA form
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL ray_packet_t
+ray_packet(const ray_t* rays);
+
+//! Reciprocal of ray direction for box tests, components close to zero give large finite values
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+ray_inverse_direction(const vector_t direction);
+
+//! Prepare one ray for box tests, broadcast to all lanes
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL ray_slab_t
+ray_slab(const ray_t r);
+
+//! Prepare four rays for box tests, one ray per lane
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL ray_slab_t
+ray_packet_slab(const ray_packet_t* rays);
+
+/*! Intersect ray with box, returns true if the ray enters the box at a distance in [0, tmax]
+    and stores the entry distance in tnear, zero if the origin is inside the box */
+static FOUNDATION_FORCEINLINE bool
+ray_intersect_aabb(real* tnear, const ray_t r, const aabb_t box, const real tmax);
+
+/*! Intersect one ray prepared with ray_slab with four boxes, returns the lane mask of boxes
+    entered at a distance in [0, tmax] and stores the entry distances in tnear */
+static FOUNDATION_FORCEINLINE unsigned int
+ray_intersect_aabb_packet(vector_t* tnear, const ray_slab_t* slab, const aabb_packet_t* boxes, const vector_t tmax);
+
+/*! Intersect four rays prepared with ray_packet_slab with one box, returns the lane mask of
+    rays entering the box at a distance in [0, tmax] and stores the entry distances in tnear */
+static FOUNDATION_FORCEINLINE unsigned int
+ray_packet_intersect_aabb(vector_t* tnear, const ray_slab_t* slab, const aabb_t box, const vector_t tmax);
+
+/*! Intersect ray with count boxes stored in packets, storing indices of boxes entered at a
+    distance in [0, tmax] in increasing order in hits which must have room for count indices.
+    Returns number of boxes hit */
+VECTOR_API size_t
+ray_intersect_aabbs(uint32_t* hits, const ray_t r, const aabb_packet_t* packets, size_t count, real tmax);
+
+/*! Intersect ray with triangle, if the triangle is hit closer than hit->t the distance and
+    barycentric coordinates in hit are updated and true returned. Hit index is not changed */
+static FOUNDATION_FORCEINLINE bool
+ray_intersect_triangle(ray_hit_t* hit, const ray_t r, const triangle_t* triangle);
+
+/*! Convert array of triangles to packets of four triangles. Packets must have room for
+    (count + 3) / 4 packets, unused lanes in the last packet are degenerate and never hit */
+VECTOR_API void
+triangle_packet_build(triangle_packet_t* packets, const triangle_t* triangles, size_t count);
+
+/*! Find closest intersection of ray with count triangles stored in packets. If a triangle is
+    hit closer than hit->t the hit is updated with the triangle index and true returned */
+VECTOR_API bool
+ray_intersect_triangles(ray_hit_t* hit, const ray_t r, const triangle_packet_t* packets, size_t count);
+
+/*! Find closest intersections of four rays with array of triangles. Lanes of hit where a
+    triangle is hit closer than the lane distance are updated with the triangle index,
+    returns the lane mask of updated rays */
+VECTOR_API unsigned int
+ray_packet_intersect_triangles(ray_packet_hit_t* hit, const ray_packet_t* rays, const triangle_t* triangles,
+                               size_t count);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL ray_t
+ray(const vector_t origin, const vector_t direction) {
+	ray_t r;
+	r.origin = origin;
+	r.direction = direction;
+	return r;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+ray_point(const ray_t r, const real t) {
+	return vector_muladd(r.direction, vector_uniform(t), r.origin);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL ray_packet_t
+ray_packet(const ray_t* rays) {
+	ray_packet_t packet;
+	matrix_t soa;
+	soa.row[0] = rays[0].origin;
+	soa.row[1] = rays[1].origin;
+	soa.row[2] = rays[2].origin;
+	soa.row[3] = rays[3].origin;
+	soa = matrix_transpose(soa);
+	packet.origin[0] = soa.row[0];
+	packet.origin[1] = soa.row[1];
+	packet.origin[2] = soa.row[2];
+	soa.row[0] = rays[0].direction;
+	soa.row[1] = rays[1].direction;
+	soa.row[2] = rays[2].direction;
+	soa.row[3] = rays[3].direction;
+	soa = matrix_transpose(soa);
+	packet.direction[0] = soa.row[0];
+	packet.direction[1] = soa.row[1];
+	packet.direction[2] = soa.row[2];
+	return packet;
+}
+
+static FOUNDATION_FORCEINLINE bool
+ray_intersect_triangle(ray_hit_t* hit, const ray_t r, const triangle_t* triangle) {
+	const vector_t edge1 = vector_sub(triangle->v[1], triangle->v[0]);
+	const vector_t edge2 = vector_sub(triangle->v[2], triangle->v[0]);
+	const vector_t pvec = vector_cross3(r.direction, edge2);
+	const real det = vector_x(vector_dot3(edge1, pvec));
+	if (det == 0)
+		return false;
+	const real inv_det = REAL_C(1.0) / det;
+	const vector_t tvec = vector_sub(r.origin, triangle->v[0]);
+	const real u = vector_x(vector_dot3(tvec, pvec)) * inv_det;
+	if ((u < 0) || (u > REAL_C(1.0)))
+		return false;
+	const vector_t qvec = vector_cross3(tvec, edge1);
+	const real v = vector_x(vector_dot3(r.direction, qvec)) * inv_det;
+	if ((v < 0) || (u + v > REAL_C(1.0)))
+		return false;
+	const real t = vector_x(vector_dot3(edge2, qvec)) * inv_det;
+	if ((t < 0) || (t > hit->t))
+		return false;
+	hit->t = t;
+	hit->u = u;
+	hit->v = v;
+	return true;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+ray_inverse_direction(const vector_t direction) {
+	const vector_t tiny = vector_uniform(REAL_C(1e-20));
+	const vector_t degenerate = vector_cmplt(vector_abs(direction), tiny);
+	const vector_t replaced = vector_select(vector_cmplt(direction, vector_zero()), vector_neg(tiny), tiny);
+	return vector_div(vector_one(), vector_select(degenerate, replaced, direction));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL ray_slab_t
+ray_slab(const ray_t r) {
+	const vector_t inv_direction = ray_inverse_direction(r.direction);
+	ray_slab_t slab;
+	slab.origin[0] = vector_shuffle(r.origin, VECTOR_MASK_XXXX);
+	slab.origin[1] = vector_shuffle(r.origin, VECTOR_MASK_YYYY);
+	slab.origin[2] = vector_shuffle(r.origin, VECTOR_MASK_ZZZZ);
+	slab.inv_direction[0] = vector_shuffle(inv_direction, VECTOR_MASK_XXXX);
+	slab.inv_direction[1] = vector_shuffle(inv_direction, VECTOR_MASK_YYYY);
+	slab.inv_direction[2] = vector_shuffle(inv_direction, VECTOR_MASK_ZZZZ);
+	return slab;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_PURECALL ray_slab_t
+ray_packet_slab(const ray_packet_t* rays) {
+	ray_slab_t slab;
+	slab.origin[0] = rays->origin[0];
+	slab.origin[1] = rays->origin[1];
+	slab.origin[2] = rays->origin[2];
+	slab.inv_direction[0] = ray_inverse_direction(rays->direction[0]);
+	slab.inv_direction[1] = ray_inverse_direction(rays->direction[1]);
+	slab.inv_direction[2] = ray_inverse_direction(rays->direction[2]);
+	return slab;
+}
+
+//Slab test on four lanes of box min and max component vectors
+static FOUNDATION_FORCEINLINE unsigned int
+ray_intersect_slab_lanes(vector_t* tnear, const ray_slab_t* slab, const vector_t* min, const vector_t* max,
+                         const vector_t tmax) {
+	const vector_t t0x = vector_mul(vector_sub(min[0], slab->origin[0]), slab->inv_direction[0]);
+	const vector_t t1x = vector_mul(vector_sub(max[0], slab->origin[0]), slab->inv_direction[0]);
+	const vector_t t0y = vector_mul(vector_sub(min[1], slab->origin[1]), slab->inv_direction[1]);
+	const vector_t t1y = vector_mul(vector_sub(max[1], slab->origin[1]), slab->inv_direction[1]);
+	const vector_t t0z = vector_mul(vector_sub(min[2], slab->origin[2]), slab->inv_direction[2]);
+	const vector_t t1z = vector_mul(vector_sub(max[2], slab->origin[2]), slab->inv_direction[2]);
+	const vector_t entry = vector_max(vector_max(vector_min(t0x, t1x), vector_min(t0y, t1y)),
+	                                  vector_max(vector_min(t0z, t1z), vector_zero()));
+	const vector_t exit = vector_min(vector_min(vector_max(t0x, t1x), vector_max(t0y, t1y)),
+	                                 vector_min(vector_max(t0z, t1z), tmax));
+	*tnear = entry;
+	return vector_movemask(vector_cmple(entry, exit));
+}
+
+static FOUNDATION_FORCEINLINE bool
+ray_intersect_aabb(real* tnear, const ray_t r, const aabb_t box, const real tmax) {
+	const vector_t inv_direction = ray_inverse_direction(r.direction);
+	const vector_t t0 = vector_mul(vector_sub(box.min, r.origin), inv_direction);
+	const vector_t t1 = vector_mul(vector_sub(box.max, r.origin), inv_direction);
+	const vector_t entry = vector_min(t0, t1);
+	const vector_t exit = vector_max(t0, t1);
+	//Not named near and far, windows.h defines both as empty macros
+	const vector_t entry_max = vector_max(vector_max(vector_shuffle(entry, VECTOR_MASK_XXXX),
+	                                                 vector_shuffle(entry, VECTOR_MASK_YYYY)),
+	                                      vector_max(vector_shuffle(entry, VECTOR_MASK_ZZZZ), vector_zero()));
+	const vector_t exit_min = vector_min(vector_min(vector_shuffle(exit, VECTOR_MASK_XXXX),
+	                                                vector_shuffle(exit, VECTOR_MASK_YYYY)),
+	                                     vector_min(vector_shuffle(exit, VECTOR_MASK_ZZZZ), vector_uniform(tmax)));
+	*tnear = vector_x(entry_max);
+	return vector_x(entry_max) <= vector_x(exit_min);
+}
+
+static FOUNDATION_FORCEINLINE unsigned int
+ray_intersect_aabb_packet(vector_t* tnear, const ray_slab_t* slab, const aabb_packet_t* boxes, const vector_t tmax) {
+	return ray_intersect_slab_lanes(tnear, slab, boxes->min, boxes->max, tmax);
+}
+
+static FOUNDATION_FORCEINLINE unsigned int
+ray_packet_intersect_aabb(vector_t* tnear, const ray_slab_t* slab, const aabb_t box, const vector_t tmax) {
+	vector_t min[3], max[3];
+	min[0] = vector_shuffle(box.min, VECTOR_MASK_XXXX);
+	min[1] = vector_shuffle(box.min, VECTOR_MASK_YYYY);
+	min[2] = vector_shuffle(box.min, VECTOR_MASK_ZZZZ);
+	max[0] = vector_shuffle(box.max, VECTOR_MASK_XXXX);
+	max[1] = vector_shuffle(box.max, VECTOR_MASK_YYYY);
+	max[2] = vector_shuffle(box.max, VECTOR_MASK_ZZZZ);
+	return ray_intersect_slab_lanes(tnear, slab, min, max, tmax);
+}
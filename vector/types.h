@@ -42,6 +42,13 @@ typedef VECTOR_ALIGN __m128 vector_t;
 #include <pmmintrin.h>
 #endif
 
+//Precision of the rsqrt estimate differs between CPU vendors, deterministic mode uses a full divide
+#if VECTOR_DETERMINISTIC
+#define VECTOR_RSQRT_PS(v) _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(v))
+#else
+#define VECTOR_RSQRT_PS(v) _mm_rsqrt_ps(v)
+#endif
+
 #else
 
 #define VECTOR_ALIGN
@@ -74,10 +81,27 @@ union matrix_t {
 };
 
 typedef vector_t quaternion_t;
+typedef vector_t plane_t;
 
 typedef struct dual_quaternion_t dual_quaternion_t;
 typedef struct transform_t transform_t;
 typedef struct euler_angles_t euler_angles_t;
+typedef struct aabb_t aabb_t;
+typedef struct aabb_packet_t aabb_packet_t;
+typedef struct obb_t obb_t;
+typedef struct frustum_t frustum_t;
+typedef struct ray_t ray_t;
+typedef struct ray_hit_t ray_hit_t;
+typedef struct ray_packet_t ray_packet_t;
+typedef struct ray_packet_hit_t ray_packet_hit_t;
+typedef struct ray_slab_t ray_slab_t;
+typedef struct triangle_t triangle_t;
+typedef struct triangle_packet_t triangle_packet_t;
+typedef struct bvh_node_t bvh_node_t;
+typedef struct bvh_t bvh_t;
+typedef struct broadphase_pair_t broadphase_pair_t;
+typedef struct broadphase_t broadphase_t;
+typedef struct hashgrid_t hashgrid_t;
 typedef struct vector_config_t vector_config_t;
 
 VECTOR_ALIGNED_STRUCT(dual_quaternion_t) {
@@ -89,6 +113,155 @@ VECTOR_ALIGNED_STRUCT(transform_t) {
 	vector_t     translation;  //Scale in w component
 };
 
+//! Axis-aligned bounding box, w components are ignored
+VECTOR_ALIGNED_STRUCT(aabb_t) {
+	vector_t min;
+	vector_t max;
+};
+
+//! Oriented bounding box, center, half size along each axis and unit length axes as rows
+VECTOR_ALIGNED_STRUCT(obb_t) {
+	vector_t center;
+	vector_t extent;
+	vector_t axis[3];
+};
+
+//! Four axis-aligned bounding boxes in SoA form, component vectors of min and max corners
+VECTOR_ALIGNED_STRUCT(aabb_packet_t) {
+	vector_t min[3];
+	vector_t max[3];
+};
+
+/*! View frustum planes in SoA form, lane i of the x, y, z and d vectors holding plane i in
+    order left, right, bottom, top, near, far. Lanes 6 and 7 repeat the far plane. Planes
+    are normalized with normals pointing into the frustum */
+VECTOR_ALIGNED_STRUCT(frustum_t) {
+	vector_t x[2];
+	vector_t y[2];
+	vector_t z[2];
+	vector_t d[2];
+};
+
+//! Ray with origin and direction, w components are ignored. Direction need not be unit length
+VECTOR_ALIGNED_STRUCT(ray_t) {
+	vector_t origin;
+	vector_t direction;
+};
+
+/*! Closest hit of a ray, distance t along the ray direction and barycentric coordinates u, v
+    of the hit point relative to the second and third triangle vertex */
+struct ray_hit_t {
+	real t;
+	real u;
+	real v;
+	uint32_t index;
+};
+
+/*! Ray intersection callback for primitive index, returns true and updates hit distance
+    and barycentric coordinates if the primitive is hit closer than hit->t */
+typedef bool (*bvh_intersect_fn)(ray_hit_t* hit, const ray_t* r, uint32_t primitive, void* context);
+
+//! Four rays in SoA form, component vectors of origin and direction
+VECTOR_ALIGNED_STRUCT(ray_packet_t) {
+	vector_t origin[3];
+	vector_t direction[3];
+};
+
+//! Closest hits of four rays in SoA form, see ray_hit_t
+VECTOR_ALIGNED_STRUCT(ray_packet_hit_t) {
+	vector_t t;
+	vector_t u;
+	vector_t v;
+	uint32_t index[4];
+};
+
+/*! Ray origin and reciprocal direction components prepared for slab tests against boxes,
+    either one ray broadcast to all lanes or four rays in SoA form */
+VECTOR_ALIGNED_STRUCT(ray_slab_t) {
+	vector_t origin[3];
+	vector_t inv_direction[3];
+};
+
+//! Triangle vertices, w components are ignored
+VECTOR_ALIGNED_STRUCT(triangle_t) {
+	vector_t v[3];
+};
+
+//! Four triangles in SoA form, component vectors of first vertex and the two edges from it
+VECTOR_ALIGNED_STRUCT(triangle_packet_t) {
+	vector_t v0[3];
+	vector_t edge1[3];
+	vector_t edge2[3];
+};
+
+/*! Node of four-wide bounding volume hierarchy. Child i is a leaf referencing count[i]
+    primitive indices starting at child[i] in the index array if count[i] is nonzero,
+    otherwise the node at index child[i], which is always larger than the parent index */
+VECTOR_ALIGNED_STRUCT(bvh_node_t) {
+	aabb_packet_t bounds;
+	uint32_t child[4];
+	uint16_t count[4];
+	//! Lane mask of used children
+	uint32_t lanes;
+	uint32_t parent;
+};
+
+//! Bounding volume hierarchy over primitive bounds, root node at index 0
+struct bvh_t {
+	bvh_node_t* nodes;
+	uint32_t* indices;
+	size_t num_nodes;
+	size_t num_primitives;
+	aabb_t bounds;
+};
+
+//! Pair of overlapping objects, a less than b
+struct broadphase_pair_t {
+	uint32_t a;
+	uint32_t b;
+};
+
+/*! Sweep and prune broadphase. Objects are kept sorted on the x axis of their bounds with
+    the bounds in SoA arrays in sorted order, padded with empty bounds for four wide loads */
+struct broadphase_t {
+	uint32_t* order;
+	real* min_x;
+	real* max_x;
+	real* min_y;
+	real* max_y;
+	real* min_z;
+	real* max_z;
+	size_t num_objects;
+	size_t capacity;
+};
+
+/*! Uniform grid hashed to a power of two number of buckets. Points are stored sorted by
+    bucket with their packed cell coordinates, the points of bucket i are in the range
+    [bucket_start[i], bucket_start[i + 1]) */
+struct hashgrid_t {
+	real cell_size;
+	real inv_cell_size;
+	unsigned int bucket_bits;
+	unsigned int num_tasks;
+	size_t num_points;
+	size_t num_buckets;
+	size_t capacity;
+	size_t bucket_capacity;
+	uint32_t* bucket_start;
+	uint32_t* indices;
+	uint64_t* cells;
+	vector_t* points;
+	//! Build state, cell of each source point and bucket histogram per task
+	const vector_t* source;
+	uint64_t* source_cells;
+	uint32_t* histogram;
+};
+
+//! Lane mask with all four component bits set, see vector_equal_exact_lanes
+#define VECTOR_LANES_ALL 0xFU
+//! Lane mask with the x, y and z component bits set
+#define VECTOR_LANES_XYZ 0x7U
+
 #define VECTOR_MATH_GETEULERORDER( i, p, r, f ) ( ( ( ( ( ( i << 1 ) + p ) << 1 ) + r ) << 1 ) + f )
 
 #define VECTOR_MATH_EULER_STATICFRAME    0
@@ -147,7 +320,36 @@ FOUNDATION_STATIC_ASSERT(sizeof(vector_t) == sizeof(float32_t)*4, "vector size"
 FOUNDATION_STATIC_ASSERT(sizeof(matrix_t) == sizeof(float32_t)*16, "matrix size" );
 FOUNDATION_STATIC_ASSERT(sizeof(transform_t) == sizeof(float32_t)*8, "transform size" );
 FOUNDATION_STATIC_ASSERT(sizeof(euler_angles_t) == sizeof(float32_t)*4, "euler angles size" );
+FOUNDATION_STATIC_ASSERT(sizeof(aabb_t) == sizeof(float32_t)*8, "aabb size" );
+FOUNDATION_STATIC_ASSERT(sizeof(obb_t) == sizeof(float32_t)*20, "obb size" );
+FOUNDATION_STATIC_ASSERT(sizeof(ray_t) == sizeof(float32_t)*8, "ray size" );
+FOUNDATION_STATIC_ASSERT(sizeof(bvh_node_t) == 128, "bvh node size" );
+
+/*! Rounding mode for vector_config_t and vector_fpenv_set. VECTOR_ROUND_DEFAULT leaves
+    the current rounding mode of the thread unchanged */
+typedef enum vector_rounding_t {
+	VECTOR_ROUND_DEFAULT = 0,
+	VECTOR_ROUND_NEAREST,
+	VECTOR_ROUND_DOWN,
+	VECTOR_ROUND_UP,
+	VECTOR_ROUND_TOWARD_ZERO
+} vector_rounding_t;
+
+//! Flush denormal results to zero (FTZ)
+#define VECTOR_FPENV_FLUSH_TO_ZERO      (1U << 0)
+//! Treat denormal inputs as zero (DAZ)
+#define VECTOR_FPENV_DENORMALS_ARE_ZERO (1U << 1)
+
+typedef struct vector_fpenv_t vector_fpenv_t;
+
+//! Saved floating point control state of a thread, see vector_fpenv_get
+struct vector_fpenv_t {
+	uint64_t control;
+};
 
 struct vector_config_t {
-	int __unused_field;
+	//! Combination of VECTOR_FPENV_* flags to enable on the thread initializing the module
+	unsigned int fpenv_flags;
+	//! Rounding mode to set on the thread initializing the module
+	vector_rounding_t rounding;
 };
@@ -0,0 +1,227 @@
+/* validate.h  -  Vector library  -  Public Domain  -  2013 Mattias Jansson / Rampant Pixels
+ *
+ * This library provides a cross-platform vector math library in C11 providing basic support data types and
+ * functions to write applications and games in a platform-independent fashion. The latest source code is
+ * always available at
+ *
+ * https://github.com/rampantpixels/vector_lib
+ *
+ * This library is built on top of the foundation library available at
+ *
+ * https://github.com/rampantpixels/foundation_lib
+ *
+ * This library is put in the public domain; you can redistribute it and/or modify it without any restrictions.
+ *
+ */
+
+/*! \file validate.h
+    Debug validation of the inline functions, enabled by VECTOR_VALIDATE (see build.h). Each
+    validated function is wrapped by a macro of the same name which checks arguments and result
+    for NaN or infinite components, that quaternions passed to quaternion_slerp are unit length
+    and that pointers passed to the aligned load functions are 16 byte aligned. Failures are
+    reported through the foundation assert handler with the file and line of the call, and
+    misaligned pointers are then loaded with the unaligned load functions.
+
+    The wrapping macros are defined once vector.h, matrix.h and quaternion.h are all complete,
+    so calls between library functions inside the headers are not validated. Comparison masks
+    and bitwise operations are not validated since masks are NaN bit patterns. Without
+    VECTOR_VALIDATE this header is empty. */
+
+#if VECTOR_VALIDATE
+
+#ifndef VECTOR_VALIDATE_HELPERS
+#define VECTOR_VALIDATE_HELPERS 1
+
+#include <foundation/assert.h>
+#include <foundation/exception.h>
+#include <foundation/string.h>
+
+#include <vector/types.h>
+#include <vector/hashstrings.h>
+
+//! Tolerance of the squared length of quaternions required to be unit length
+#ifndef VECTOR_VALIDATE_UNIT_EPSILON
+#  define VECTOR_VALIDATE_UNIT_EPSILON REAL_C(0.001)
+#endif
+
+static FOUNDATION_NOINLINE void
+vector_validate_report(const char* function, const char* file, unsigned int line, const char* message) {
+	if (assert_report(HASH_VECTOR, function, string_length(function), file, string_length(file), line,
+	                  message, string_length(message)))
+		exception_raise_debug_break();
+}
+
+//Bit test, fast math builds may fold isnan and isinf to false
+static FOUNDATION_FORCEINLINE bool
+vector_validate_is_finite(const float32_t* component, size_t count) {
+	uint32_t bits;
+	size_t i;
+	for (i = 0; i < count; ++i) {
+		memcpy(&bits, component + i, sizeof(bits));
+		if ((bits & 0x7F800000U) == 0x7F800000U)
+			return false;
+	}
+	return true;
+}
+
+static FOUNDATION_FORCEINLINE vector_t
+vector_validate_vector(const vector_t v, const char* function, const char* file, unsigned int line,
+                       const char* message) {
+	float32_t component[4];
+	memcpy(component, &v, sizeof(component));
+	if (!vector_validate_is_finite(component, 4))
+		vector_validate_report(function, file, line, message);
+	return v;
+}
+
+static FOUNDATION_FORCEINLINE matrix_t
+vector_validate_matrix(const matrix_t m, const char* function, const char* file, unsigned int line,
+                       const char* message) {
+	if (!vector_validate_is_finite(m.arr, 16))
+		vector_validate_report(function, file, line, message);
+	return m;
+}
+
+static FOUNDATION_FORCEINLINE real
+vector_validate_real(const real value, const char* function, const char* file, unsigned int line,
+                     const char* message) {
+	const float32_t component = (float32_t)value;
+	if (!vector_validate_is_finite(&component, 1))
+		vector_validate_report(function, file, line, message);
+	return value;
+}
+
+static FOUNDATION_FORCEINLINE quaternion_t
+vector_validate_unit(const quaternion_t q, const char* function, const char* file, unsigned int line) {
+	float32_t component[4];
+	real length_sqr;
+	memcpy(component, &q, sizeof(component));
+	length_sqr = (component[0] * component[0]) + (component[1] * component[1]) +
+	             (component[2] * component[2]) + (component[3] * component[3]);
+	if (!vector_validate_is_finite(component, 4))
+		vector_validate_report(function, file, line, "Argument is NaN or infinite");
+	else if (math_abs(length_sqr - REAL_C(1.0)) > VECTOR_VALIDATE_UNIT_EPSILON)
+		vector_validate_report(function, file, line, "Quaternions must be unit length");
+	return q;
+}
+
+static FOUNDATION_FORCEINLINE bool
+vector_validate_aligned(const float32_aligned128_t* pointer, const char* function, const char* file,
+                        unsigned int line) {
+	if (!((uintptr_t)pointer & 15))
+		return true;
+	vector_validate_report(function, file, line, "Pointer must be 16 byte aligned");
+	return false;
+}
+
+#define VECTOR_VALIDATE_ARG(function, v) \
+	vector_validate_vector((v), #function, __FILE__, __LINE__, "Argument is NaN or infinite")
+#define VECTOR_VALIDATE_REAL(function, value) \
+	vector_validate_real((value), #function, __FILE__, __LINE__, "Argument is NaN or infinite")
+#define VECTOR_VALIDATE_MATRIX(function, m) \
+	vector_validate_matrix((m), #function, __FILE__, __LINE__, "Argument is NaN or infinite")
+#define VECTOR_VALIDATE_UNIT(function, q) \
+	vector_validate_unit((q), #function, __FILE__, __LINE__)
+#define VECTOR_VALIDATE_RESULT(function, v) \
+	vector_validate_vector((v), #function, __FILE__, __LINE__, "Result is NaN or infinite")
+#define VECTOR_VALIDATE_MATRIX_RESULT(function, m) \
+	vector_validate_matrix((m), #function, __FILE__, __LINE__, "Result is NaN or infinite")
+#define VECTOR_VALIDATE_ALIGNED(function, pointer) \
+	vector_validate_##function((pointer), __FILE__, __LINE__)
+
+//The parenthesized function name calls the function and not the wrapping macro
+#define VECTOR_VALIDATE_V(function, v) \
+	VECTOR_VALIDATE_RESULT(function, (function)(VECTOR_VALIDATE_ARG(function, v)))
+#define VECTOR_VALIDATE_VV(function, v0, v1) \
+	VECTOR_VALIDATE_RESULT(function, (function)(VECTOR_VALIDATE_ARG(function, v0), VECTOR_VALIDATE_ARG(function, v1)))
+#define VECTOR_VALIDATE_VVV(function, v0, v1, v2) \
+	VECTOR_VALIDATE_RESULT(function, (function)(VECTOR_VALIDATE_ARG(function, v0), VECTOR_VALIDATE_ARG(function, v1), \
+	                                            VECTOR_VALIDATE_ARG(function, v2)))
+#define VECTOR_VALIDATE_VR(function, v, value) \
+	VECTOR_VALIDATE_RESULT(function, (function)(VECTOR_VALIDATE_ARG(function, v), VECTOR_VALIDATE_REAL(function, value)))
+#define VECTOR_VALIDATE_VVR(function, v0, v1, value) \
+	VECTOR_VALIDATE_RESULT(function, (function)(VECTOR_VALIDATE_ARG(function, v0), VECTOR_VALIDATE_ARG(function, v1), \
+	                                            VECTOR_VALIDATE_REAL(function, value)))
+#define VECTOR_VALIDATE_MV(function, m, v) \
+	VECTOR_VALIDATE_RESULT(function, (function)(VECTOR_VALIDATE_MATRIX(function, m), VECTOR_VALIDATE_ARG(function, v)))
+#define VECTOR_VALIDATE_MM(function, m0, m1) \
+	VECTOR_VALIDATE_MATRIX_RESULT(function, (function)(VECTOR_VALIDATE_MATRIX(function, m0), \
+	                                                   VECTOR_VALIDATE_MATRIX(function, m1)))
+
+#endif
+
+#if defined( VECTOR_VALIDATE_VECTOR_COMPLETE ) && defined( VECTOR_VALIDATE_MATRIX_COMPLETE ) && \
+    defined( VECTOR_VALIDATE_QUATERNION_COMPLETE ) && !defined( VECTOR_VALIDATE_WRAPPERS )
+#define VECTOR_VALIDATE_WRAPPERS 1
+
+//Misaligned pointers are reported and then loaded with the unaligned load, so the call completes
+static FOUNDATION_FORCEINLINE vector_t
+vector_validate_vector_aligned(const float32_aligned128_t* pointer, const char* file, unsigned int line) {
+	if (!vector_validate_aligned(pointer, "vector_aligned", file, line))
+		return vector_unaligned((const float32_t*)pointer);
+	return vector_aligned(pointer);
+}
+
+static FOUNDATION_FORCEINLINE matrix_t
+vector_validate_matrix_aligned(const float32_aligned128_t* pointer, const char* file, unsigned int line) {
+	if (!vector_validate_aligned(pointer, "matrix_aligned", file, line))
+		return matrix_unaligned((const float32_t*)pointer);
+	return matrix_aligned(pointer);
+}
+
+static FOUNDATION_FORCEINLINE quaternion_t
+vector_validate_quaternion_aligned(const float32_aligned128_t* pointer, const char* file, unsigned int line) {
+	if (!vector_validate_aligned(pointer, "quaternion_aligned", file, line))
+		return quaternion_unaligned((const float32_t*)pointer);
+	return quaternion_aligned(pointer);
+}
+
+#define vector_aligned(v) VECTOR_VALIDATE_ALIGNED(vector_aligned, v)
+#define vector_add(v0, v1) VECTOR_VALIDATE_VV(vector_add, v0, v1)
+#define vector_sub(v0, v1) VECTOR_VALIDATE_VV(vector_sub, v0, v1)
+#define vector_mul(v0, v1) VECTOR_VALIDATE_VV(vector_mul, v0, v1)
+#define vector_div(v0, v1) VECTOR_VALIDATE_VV(vector_div, v0, v1)
+#define vector_neg(v) VECTOR_VALIDATE_V(vector_neg, v)
+#define vector_muladd(v0, v1, v2) VECTOR_VALIDATE_VVV(vector_muladd, v0, v1, v2)
+#define vector_scale(v, s) VECTOR_VALIDATE_VR(vector_scale, v, s)
+#define vector_lerp(from, to, factor) VECTOR_VALIDATE_VVR(vector_lerp, from, to, factor)
+#define vector_dot(v0, v1) VECTOR_VALIDATE_VV(vector_dot, v0, v1)
+#define vector_dot3(v0, v1) VECTOR_VALIDATE_VV(vector_dot3, v0, v1)
+#define vector_cross3(v0, v1) VECTOR_VALIDATE_VV(vector_cross3, v0, v1)
+#define vector_normalize(v) VECTOR_VALIDATE_V(vector_normalize, v)
+#define vector_normalize3(v) VECTOR_VALIDATE_V(vector_normalize3, v)
+#define vector_length(v) VECTOR_VALIDATE_V(vector_length, v)
+#define vector_length_fast(v) VECTOR_VALIDATE_V(vector_length_fast, v)
+#define vector_length_sqr(v) VECTOR_VALIDATE_V(vector_length_sqr, v)
+#define vector_length3(v) VECTOR_VALIDATE_V(vector_length3, v)
+#define vector_length3_fast(v) VECTOR_VALIDATE_V(vector_length3_fast, v)
+#define vector_length3_sqr(v) VECTOR_VALIDATE_V(vector_length3_sqr, v)
+#define vector_project(v, at) VECTOR_VALIDATE_VV(vector_project, v, at)
+#define vector_reflect(v, at) VECTOR_VALIDATE_VV(vector_reflect, v, at)
+#define vector_project3(v, at) VECTOR_VALIDATE_VV(vector_project3, v, at)
+#define vector_reflect3(v, at) VECTOR_VALIDATE_VV(vector_reflect3, v, at)
+#define vector_min(v0, v1) VECTOR_VALIDATE_VV(vector_min, v0, v1)
+#define vector_max(v0, v1) VECTOR_VALIDATE_VV(vector_max, v0, v1)
+#define vector_abs(v) VECTOR_VALIDATE_V(vector_abs, v)
+
+#define matrix_aligned(m) VECTOR_VALIDATE_ALIGNED(matrix_aligned, m)
+#define matrix_mul(m0, m1) VECTOR_VALIDATE_MM(matrix_mul, m0, m1)
+#define matrix_add(m0, m1) VECTOR_VALIDATE_MM(matrix_add, m0, m1)
+#define matrix_sub(m0, m1) VECTOR_VALIDATE_MM(matrix_sub, m0, m1)
+#define matrix_rotate(m, v) VECTOR_VALIDATE_MV(matrix_rotate, m, v)
+#define matrix_transform(m, v) VECTOR_VALIDATE_MV(matrix_transform, m, v)
+
+#define quaternion_aligned(q) VECTOR_VALIDATE_ALIGNED(quaternion_aligned, q)
+#define quaternion_inverse(q) VECTOR_VALIDATE_V(quaternion_inverse, q)
+#define quaternion_normalize(q) VECTOR_VALIDATE_V(quaternion_normalize, q)
+#define quaternion_mul(q0, q1) VECTOR_VALIDATE_VV(quaternion_mul, q0, q1)
+#define quaternion_add(q0, q1) VECTOR_VALIDATE_VV(quaternion_add, q0, q1)
+#define quaternion_sub(q0, q1) VECTOR_VALIDATE_VV(quaternion_sub, q0, q1)
+#define quaternion_slerp(q0, q1, factor) \
+	VECTOR_VALIDATE_RESULT(quaternion_slerp, (quaternion_slerp)(VECTOR_VALIDATE_UNIT(quaternion_slerp, q0), \
+	                       VECTOR_VALIDATE_UNIT(quaternion_slerp, q1), VECTOR_VALIDATE_REAL(quaternion_slerp, factor)))
+#define quaternion_rotate(q, v) VECTOR_VALIDATE_VV(quaternion_rotate, q, v)
+
+#endif
+
+#endif
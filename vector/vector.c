@@ -17,13 +17,23 @@
 #include <vector/vector.h>
 
 static bool _vector_initialized = false;
+static vector_config_t _vector_config;
+static vector_fpenv_t _vector_fpenv_saved;
+
+static bool
+vector_config_has_fpenv(void) {
+	return _vector_config.fpenv_flags || (_vector_config.rounding != VECTOR_ROUND_DEFAULT);
+}
 
 int
 vector_module_initialize(const vector_config_t config) {
-	FOUNDATION_UNUSED(config);
 	if (_vector_initialized)
 		return 0;
 
+	_vector_config = config;
+	if (vector_config_has_fpenv())
+		_vector_fpenv_saved = vector_fpenv_set(config.fpenv_flags, config.rounding);
+
 	_vector_initialized = true;
 
 	return 0;
@@ -31,9 +41,19 @@ vector_module_initialize(const vector_config_t config) {
 
 void
 vector_module_finalize(void) {
+	if (_vector_initialized && vector_config_has_fpenv())
+		vector_fpenv_restore(_vector_fpenv_saved);
+	memset(&_vector_config, 0, sizeof(_vector_config));
 	_vector_initialized = false;
 }
 
+vector_fpenv_t
+vector_fpenv_apply_config(void) {
+	if (!vector_config_has_fpenv())
+		return vector_fpenv_get();
+	return vector_fpenv_set(_vector_config.fpenv_flags, _vector_config.rounding);
+}
+
 bool
 vector_module_is_initialized(void) {
 	return _vector_initialized;
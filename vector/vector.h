@@ -154,6 +154,10 @@ vector_min(const vector_t v0, const vector_t v1);
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 vector_max(const vector_t v0, const vector_t v1);
 
+//! Absolute value of each component (clears sign bits)
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_abs(const vector_t v);
+
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
 vector_x(const vector_t v);
 
@@ -169,9 +173,101 @@ vector_w(const vector_t v);
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
 vector_component(const vector_t v, int c);
 
+//! Components within 100 ulps of each other, same as vector_equal_ulps(v0, v1, 100)
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
 vector_equal(const vector_t v0, const vector_t v1);
 
+/*! Lane mask functions return a bit per component (bit 0 for x through bit 3 for w) set if
+    the components compare equal, VECTOR_LANES_ALL if all do. NaN does not compare equal, but
+    only the ulps compare is guaranteed to detect it when building with fast math flags */
+
+//! Lane mask of components comparing exactly equal (0 and -0 are equal)
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_exact_lanes(const vector_t v0, const vector_t v1);
+
+//! Lane mask of components with absolute difference less than or equal to epsilon
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_abs_lanes(const vector_t v0, const vector_t v1, const real epsilon);
+
+/*! Lane mask of components with absolute difference less than or equal to tolerance
+    scaled by the larger of the absolute component values */
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_rel_lanes(const vector_t v0, const vector_t v1, const real tolerance);
+
+/*! Lane mask of components at most the given number of representable values (units in the
+    last place) apart. Values of different sign count the distance across zero */
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_ulps_lanes(const vector_t v0, const vector_t v1, int ulps);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_exact(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_abs(const vector_t v0, const vector_t v1, const real epsilon);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_rel(const vector_t v0, const vector_t v1, const real tolerance);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_ulps(const vector_t v0, const vector_t v1, int ulps);
+
+/*! Comparison masks have all bits set in components where the comparison holds and all bits
+    clear where it does not, for use with vector_select and the bitwise functions. Ordered
+    compares are false and vector_cmpneq true for NaN components */
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmplt(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmple(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpeq(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpneq(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpgt(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpge(const vector_t v0, const vector_t v1);
+
+//! Bitwise operations on component bit patterns
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_and(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_or(const vector_t v0, const vector_t v1);
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_xor(const vector_t v0, const vector_t v1);
+
+//! Bitwise v0 and not v1
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_andnot(const vector_t v0, const vector_t v1);
+
+//! Select components from v0 where the comparison mask is set and from v1 where it is clear
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_select(const vector_t mask, const vector_t v0, const vector_t v1);
+
+/*! Blend components from v0 and v1 with a constant integer VECTOR_BLEND_* mask, taking
+    the component from v1 where the mask bit is set (see mask.h) */
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_blend(const vector_t v0, const vector_t v1, const unsigned int mask);
+
+//! Lane mask of component sign bits, the set components of a comparison mask
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_movemask(const vector_t v);
+
+//! Any component of comparison mask set
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_any(const vector_t mask);
+
+//! All components of comparison mask set
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_all(const vector_t mask);
+
 VECTOR_API string_t
 string_from_vector(char* buffer, size_t capacity, const vector_t v);
 
@@ -209,3 +305,20 @@ string_from_vector_static(const vector_t v);
 
 #include <vector/quaternion.h>
 #include <vector/matrix.h>
+#include <vector/octahedral.h>
+#include <vector/aabb.h>
+#include <vector/plane.h>
+#include <vector/obb.h>
+#include <vector/frustum.h>
+#include <vector/ray.h>
+#include <vector/bvh.h>
+#include <vector/broadphase.h>
+#include <vector/hashgrid.h>
+#include <vector/morton.h>
+#include <vector/fpenv.h>
+#include <vector/compare.h>
+
+#if VECTOR_VALIDATE
+#  define VECTOR_VALIDATE_VECTOR_COMPLETE 1
+#  include <vector/validate.h>
+#endif
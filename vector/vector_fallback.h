@@ -77,7 +77,11 @@ vector_zaxis(void) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
 vector_normalize(const vector_t v) {
+#if VECTOR_DETERMINISTIC
+	float32_t inv_length = REAL_C(1.0) / math_sqrt((v.x * v.x + v.y * v.y) + (v.z * v.z + v.w * v.w));
+#else
 	float32_t inv_length = math_rsqrt(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+#endif
 	vector_t rv = v;
 	rv.x *= inv_length;
 	rv.y *= inv_length;
@@ -88,7 +92,11 @@ vector_normalize(const vector_t v) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
 vector_normalize3(const vector_t v) {
+#if VECTOR_DETERMINISTIC
+	float32_t inv_length = REAL_C(1.0) / math_sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+#else
 	float32_t inv_length = math_rsqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+#endif
 	vector_t rv = v;
 	rv.x *= inv_length;
 	rv.y *= inv_length;
@@ -98,7 +106,8 @@ vector_normalize3(const vector_t v) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
 vector_dot(const vector_t v0, const vector_t v1) {
-	return vector_uniform(v0.x * v1.x + v0.y * v1.y + v0.z * v1.z + v0.w * v1.w);
+	//Pairwise sum, same order as the SIMD backends
+	return vector_uniform((v0.x * v1.x + v0.y * v1.y) + (v0.z * v1.z + v0.w * v1.w));
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
@@ -159,12 +168,22 @@ vector_scale(const vector_t v, const real s) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
 vector_lerp(const vector_t from, const vector_t to, const real factor) {
+#if VECTOR_DETERMINISTIC
+	//Same formulation as the SIMD backends
+	return (vector_t){
+		factor * to.x + (from.x - factor * from.x),
+		factor * to.y + (from.y - factor * from.y),
+		factor * to.z + (from.z - factor * from.z),
+		factor * to.w + (from.w - factor * from.w)
+	};
+#else
 	return (vector_t){
 		from.x + (to.x - from.x)* factor,
 		from.y + (to.y - from.y)* factor,
 		from.z + (to.z - from.z)* factor,
 		from.w + (to.w - from.w)* factor
 	};
+#endif
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
@@ -222,12 +241,12 @@ vector_length_fast(const vector_t v) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
 vector_length(const vector_t v) {
-	return vector_uniform(math_sqrt(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w));
+	return vector_uniform(math_sqrt((v.x * v.x + v.y * v.y) + (v.z * v.z + v.w * v.w)));
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
 vector_length_sqr(const vector_t v) {
-	return vector_uniform(v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w);
+	return vector_uniform((v.x * v.x + v.y * v.y) + (v.z * v.z + v.w * v.w));
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t 
@@ -255,6 +274,11 @@ vector_max(const vector_t v0, const vector_t v1) {
 	return (vector_t){(v0.x > v1.x) ? v0.x : v1.x, (v0.y > v1.y) ? v0.y : v1.y, (v0.z > v1.z) ? v0.z : v1.z, (v0.w > v1.w) ? v0.w : v1.w};
 }
 
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_abs(const vector_t v) {
+	return (vector_t){math_abs(v.x), math_abs(v.y), math_abs(v.z), math_abs(v.w)};
+}
+
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real 
 vector_x(const vector_t v) {
 	return v.x;
@@ -281,8 +305,197 @@ vector_component(const vector_t v, int c) {
 	return *((const float32_t*)&v + c);
 }
 
-static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool 
+//Bit pattern access for ulps compare and mask components, masks have all bits set for true
+//like the SSE comparisons
+typedef union {
+	float32_t fval;
+	uint32_t uival;
+} vector_lane_cast_t;
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL uint32_t
+vector_lane_bits(const float32_t r) {
+	vector_lane_cast_t cast;
+	cast.fval = r;
+	return cast.uival;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL float32_t
+vector_lane_from_bits(const uint32_t bits) {
+	vector_lane_cast_t cast;
+	cast.uival = bits;
+	return cast.fval;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL float32_t
+vector_lane_mask(const bool set) {
+	return vector_lane_from_bits(set ? 0xFFFFFFFFU : 0);
+}
+
+//Integer with the same ordering as the value (negative values mirrored below zero)
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL int32_t
+vector_ulps_ordered(const real r) {
+	const uint32_t bits = vector_lane_bits(r);
+	return (bits & 0x80000000U) ? -(int32_t)(bits & 0x7FFFFFFFU) : (int32_t)bits;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_ulps_near(const real r0, const real r1, int ulps) {
+	const int32_t ord0 = vector_ulps_ordered(r0);
+	const int32_t ord1 = vector_ulps_ordered(r1);
+	const uint32_t dist = (ord0 > ord1) ? ((uint32_t)ord0 - (uint32_t)ord1) : ((uint32_t)ord1 - (uint32_t)ord0);
+	//NaN from bits, not affected by fast math compiler flags
+	const int32_t mag0 = (ord0 < 0) ? -ord0 : ord0;
+	const int32_t mag1 = (ord1 < 0) ? -ord1 : ord1;
+	return (dist <= (uint32_t)ulps) && (mag0 <= 0x7F800000) && (mag1 <= 0x7F800000);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_exact_lanes(const vector_t v0, const vector_t v1) {
+	return (v0.x == v1.x ? 1U : 0) | (v0.y == v1.y ? 2U : 0) |
+	       (v0.z == v1.z ? 4U : 0) | (v0.w == v1.w ? 8U : 0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_abs_lanes(const vector_t v0, const vector_t v1, const real epsilon) {
+	//Exact compare keeps equal infinities equal
+	return ((v0.x == v1.x) || (math_abs(v0.x - v1.x) <= epsilon) ? 1U : 0) |
+	       ((v0.y == v1.y) || (math_abs(v0.y - v1.y) <= epsilon) ? 2U : 0) |
+	       ((v0.z == v1.z) || (math_abs(v0.z - v1.z) <= epsilon) ? 4U : 0) |
+	       ((v0.w == v1.w) || (math_abs(v0.w - v1.w) <= epsilon) ? 8U : 0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_rel_lanes(const vector_t v0, const vector_t v1, const real tolerance) {
+	const vector_t diff = vector_abs(vector_sub(v0, v1));
+	const vector_t scale = vector_max(vector_abs(v0), vector_abs(v1));
+	return ((v0.x == v1.x) || (diff.x <= scale.x * tolerance) ? 1U : 0) |
+	       ((v0.y == v1.y) || (diff.y <= scale.y * tolerance) ? 2U : 0) |
+	       ((v0.z == v1.z) || (diff.z <= scale.z * tolerance) ? 4U : 0) |
+	       ((v0.w == v1.w) || (diff.w <= scale.w * tolerance) ? 8U : 0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_ulps_lanes(const vector_t v0, const vector_t v1, int ulps) {
+	return (vector_ulps_near(v0.x, v1.x, ulps) ? 1U : 0) | (vector_ulps_near(v0.y, v1.y, ulps) ? 2U : 0) |
+	       (vector_ulps_near(v0.z, v1.z, ulps) ? 4U : 0) | (vector_ulps_near(v0.w, v1.w, ulps) ? 8U : 0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_exact(const vector_t v0, const vector_t v1) {
+	return vector_equal_exact_lanes(v0, v1) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_abs(const vector_t v0, const vector_t v1, const real epsilon) {
+	return vector_equal_abs_lanes(v0, v1, epsilon) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_rel(const vector_t v0, const vector_t v1, const real tolerance) {
+	return vector_equal_rel_lanes(v0, v1, tolerance) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_ulps(const vector_t v0, const vector_t v1, int ulps) {
+	return vector_equal_ulps_lanes(v0, v1, ulps) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
 vector_equal(const vector_t v0, const vector_t v1) {
-	return math_real_eq(v0.x, v1.x, 100) && math_real_eq(v0.y, v1.y, 100) &&
-	       math_real_eq(v0.z, v1.z, 100) && math_real_eq(v0.w, v1.w, 100);
+	return vector_equal_ulps_lanes(v0, v1, 100) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmplt(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_mask(v0.x < v1.x), vector_lane_mask(v0.y < v1.y),
+	                  vector_lane_mask(v0.z < v1.z), vector_lane_mask(v0.w < v1.w)};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmple(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_mask(v0.x <= v1.x), vector_lane_mask(v0.y <= v1.y),
+	                  vector_lane_mask(v0.z <= v1.z), vector_lane_mask(v0.w <= v1.w)};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpeq(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_mask(v0.x == v1.x), vector_lane_mask(v0.y == v1.y),
+	                  vector_lane_mask(v0.z == v1.z), vector_lane_mask(v0.w == v1.w)};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpneq(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_mask(v0.x != v1.x), vector_lane_mask(v0.y != v1.y),
+	                  vector_lane_mask(v0.z != v1.z), vector_lane_mask(v0.w != v1.w)};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpgt(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_mask(v0.x > v1.x), vector_lane_mask(v0.y > v1.y),
+	                  vector_lane_mask(v0.z > v1.z), vector_lane_mask(v0.w > v1.w)};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpge(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_mask(v0.x >= v1.x), vector_lane_mask(v0.y >= v1.y),
+	                  vector_lane_mask(v0.z >= v1.z), vector_lane_mask(v0.w >= v1.w)};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_and(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_from_bits(vector_lane_bits(v0.x) & vector_lane_bits(v1.x)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.y) & vector_lane_bits(v1.y)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.z) & vector_lane_bits(v1.z)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.w) & vector_lane_bits(v1.w))};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_or(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_from_bits(vector_lane_bits(v0.x) | vector_lane_bits(v1.x)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.y) | vector_lane_bits(v1.y)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.z) | vector_lane_bits(v1.z)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.w) | vector_lane_bits(v1.w))};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_xor(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_from_bits(vector_lane_bits(v0.x) ^ vector_lane_bits(v1.x)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.y) ^ vector_lane_bits(v1.y)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.z) ^ vector_lane_bits(v1.z)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.w) ^ vector_lane_bits(v1.w))};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_andnot(const vector_t v0, const vector_t v1) {
+	return (vector_t){vector_lane_from_bits(vector_lane_bits(v0.x) & ~vector_lane_bits(v1.x)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.y) & ~vector_lane_bits(v1.y)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.z) & ~vector_lane_bits(v1.z)),
+	                  vector_lane_from_bits(vector_lane_bits(v0.w) & ~vector_lane_bits(v1.w))};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_select(const vector_t mask, const vector_t v0, const vector_t v1) {
+	return vector_or(vector_and(mask, v0), vector_andnot(v1, mask));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_blend(const vector_t v0, const vector_t v1, const unsigned int mask) {
+	return (vector_t){(mask & 1) ? v1.x : v0.x, (mask & 2) ? v1.y : v0.y,
+	                  (mask & 4) ? v1.z : v0.z, (mask & 8) ? v1.w : v0.w};
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_movemask(const vector_t v) {
+	return (vector_lane_bits(v.x) >> 31) | ((vector_lane_bits(v.y) >> 31) << 1) |
+	       ((vector_lane_bits(v.z) >> 31) << 2) | ((vector_lane_bits(v.w) >> 31) << 3);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_any(const vector_t mask) {
+	return vector_movemask(mask) != 0;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_all(const vector_t mask) {
+	return vector_movemask(mask) == VECTOR_LANES_ALL;
 }
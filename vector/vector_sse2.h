@@ -91,13 +91,13 @@ vector_zaxis(void) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 vector_normalize(const vector_t v) {
-	return _mm_mul_ps(v, _mm_rsqrt_ps(vector_dot(v, v)));
+	return _mm_mul_ps(v, VECTOR_RSQRT_PS(vector_dot(v, v)));
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 vector_normalize3(const vector_t v) {
 	//Shuffle to preserve w component of input vector
-	const vector_t norm = vector_mul(v, _mm_rsqrt_ps(vector_dot3(v, v)));
+	const vector_t norm = vector_mul(v, VECTOR_RSQRT_PS(vector_dot3(v, v)));
 	const vector_t splice = _mm_shuffle_ps(norm, v, VECTOR_MASK_ZZWW);
 	return _mm_shuffle_ps(norm, splice, VECTOR_MASK_XYXW);
 }
@@ -113,6 +113,12 @@ vector_dot(const vector_t v0, const vector_t v1) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 vector_dot3(const vector_t v0, const vector_t v1) {
+#if VECTOR_DETERMINISTIC
+	//Masked sum turns a negative zero z product into positive zero, sum components in order instead
+	const vector_t r = _mm_mul_ps(v0, v1);
+	return _mm_add_ps(_mm_add_ps(vector_shuffle(r, VECTOR_MASK_XXXX), vector_shuffle(r, VECTOR_MASK_YYYY)),
+	                  vector_shuffle(r, VECTOR_MASK_ZZZZ));
+#else
 	__m128i one = _mm_setzero_si128();
 	one = _mm_cmpeq_epi32(one, one);
 	vector_t mask = _mm_move_ss(_mm_castsi128_ps(one), vector_zero());
@@ -122,6 +128,7 @@ vector_dot3(const vector_t v0, const vector_t v1) {
 	r = _mm_add_ps(r, rp);
 	rp = _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3));
 	return _mm_add_ps(r, rp);
+#endif
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
@@ -155,7 +162,8 @@ vector_sub(const vector_t v0, const vector_t v1) {
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 vector_neg(const vector_t v) {
-	return _mm_sub_ps(_mm_setzero_ps(), v);
+	//Flip sign bits, 0 - v maps positive zero to positive zero instead of negative zero
+	return _mm_xor_ps(v, _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000)));
 }
 
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
@@ -191,7 +199,7 @@ vector_reflect(const vector_t v, const vector_t at) {
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
 vector_project3(const vector_t v, const vector_t at) {
 	//Shuffle to preserve w component of input vector
-	const vector_t normal = vector_mul(at, _mm_rsqrt_ps(vector_dot3(at, at)));
+	const vector_t normal = vector_mul(at, VECTOR_RSQRT_PS(vector_dot3(at, at)));
 	const vector_t result = vector_mul(normal, vector_dot3(normal, v));
 	const vector_t splice = _mm_shuffle_ps(result, v, VECTOR_MASK_ZZWW);
 	return _mm_shuffle_ps(result, splice, VECTOR_MASK_XYXW);
@@ -252,6 +260,11 @@ vector_max(const vector_t v0, const vector_t v1) {
 	return _mm_max_ps(v0, v1);
 }
 
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_abs(const vector_t v) {
+	return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+}
+
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL real
 vector_x(const vector_t v) {
 	return *(const float32_t*)&v;
@@ -278,11 +291,149 @@ vector_component(const vector_t v, int c) {
 	return *((const float32_t*)&v + c);
 }
 
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_exact_lanes(const vector_t v0, const vector_t v1) {
+	return (unsigned int)_mm_movemask_ps(_mm_cmpeq_ps(v0, v1));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_abs_lanes(const vector_t v0, const vector_t v1, const real epsilon) {
+	//Exact compare keeps equal infinities equal
+	const vector_t diff = vector_abs(_mm_sub_ps(v0, v1));
+	return (unsigned int)_mm_movemask_ps(_mm_or_ps(_mm_cmpeq_ps(v0, v1),
+	                                               _mm_cmple_ps(diff, _mm_set1_ps(epsilon))));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_rel_lanes(const vector_t v0, const vector_t v1, const real tolerance) {
+	const vector_t diff = vector_abs(_mm_sub_ps(v0, v1));
+	const vector_t scale = _mm_max_ps(vector_abs(v0), vector_abs(v1));
+	return (unsigned int)_mm_movemask_ps(_mm_or_ps(_mm_cmpeq_ps(v0, v1),
+	                                               _mm_cmple_ps(diff, _mm_mul_ps(scale, _mm_set1_ps(tolerance)))));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_equal_ulps_lanes(const vector_t v0, const vector_t v1, int ulps) {
+	//Map bit patterns to integers ordered like the values (negative values mirrored below zero),
+	//take the distance as an unsigned value and compare with the sign bias trick. All integer
+	//operations, so NaN is detected from the bits and not affected by fast math compiler flags
+	const __m128i sign = _mm_set1_epi32((int)0x80000000);
+	const __m128i exponent = _mm_set1_epi32(0x7F800000);
+	const __m128i i0 = _mm_castps_si128(v0);
+	const __m128i i1 = _mm_castps_si128(v1);
+	const __m128i mag0 = _mm_andnot_si128(sign, i0);
+	const __m128i mag1 = _mm_andnot_si128(sign, i1);
+	const __m128i neg0 = _mm_srai_epi32(i0, 31);
+	const __m128i neg1 = _mm_srai_epi32(i1, 31);
+	const __m128i ord0 = _mm_sub_epi32(_mm_xor_si128(mag0, neg0), neg0);
+	const __m128i ord1 = _mm_sub_epi32(_mm_xor_si128(mag1, neg1), neg1);
+	const __m128i swap = _mm_cmpgt_epi32(ord1, ord0);
+	const __m128i dist = _mm_sub_epi32(_mm_xor_si128(_mm_sub_epi32(ord0, ord1), swap), swap);
+	const __m128i apart = _mm_cmpgt_epi32(_mm_xor_si128(dist, sign), _mm_set1_epi32(ulps ^ (int)0x80000000));
+	const __m128i nan = _mm_or_si128(_mm_cmpgt_epi32(mag0, exponent), _mm_cmpgt_epi32(mag1, exponent));
+	return (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(apart, nan))) ^ VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_exact(const vector_t v0, const vector_t v1) {
+	return vector_equal_exact_lanes(v0, v1) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_abs(const vector_t v0, const vector_t v1, const real epsilon) {
+	return vector_equal_abs_lanes(v0, v1, epsilon) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_rel(const vector_t v0, const vector_t v1, const real tolerance) {
+	return vector_equal_rel_lanes(v0, v1, tolerance) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_equal_ulps(const vector_t v0, const vector_t v1, int ulps) {
+	return vector_equal_ulps_lanes(v0, v1, ulps) == VECTOR_LANES_ALL;
+}
+
 static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
 vector_equal(const vector_t v0, const vector_t v1) {
-	return math_real_eq(*(const float32_t*)&v0, *(const float32_t*)&v1, 100) &&
-	       math_real_eq(*((const float32_t*)&v0 + 1), *((const float32_t*)&v1 + 1), 100) &&
-	       math_real_eq(*((const float32_t*)&v0 + 2), *((const float32_t*)&v1 + 2), 100) &&
-	       math_real_eq(*((const float32_t*)&v0 + 3), *((const float32_t*)&v1 + 3), 100);
+	return vector_equal_ulps_lanes(v0, v1, 100) == VECTOR_LANES_ALL;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmplt(const vector_t v0, const vector_t v1) {
+	return _mm_cmplt_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmple(const vector_t v0, const vector_t v1) {
+	return _mm_cmple_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpeq(const vector_t v0, const vector_t v1) {
+	return _mm_cmpeq_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpneq(const vector_t v0, const vector_t v1) {
+	return _mm_cmpneq_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpgt(const vector_t v0, const vector_t v1) {
+	return _mm_cmpgt_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_cmpge(const vector_t v0, const vector_t v1) {
+	return _mm_cmpge_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_and(const vector_t v0, const vector_t v1) {
+	return _mm_and_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_or(const vector_t v0, const vector_t v1) {
+	return _mm_or_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_xor(const vector_t v0, const vector_t v1) {
+	return _mm_xor_ps(v0, v1);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_andnot(const vector_t v0, const vector_t v1) {
+	return _mm_andnot_ps(v1, v0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_select(const vector_t mask, const vector_t v0, const vector_t v1) {
+	return _mm_or_ps(_mm_and_ps(mask, v0), _mm_andnot_ps(mask, v1));
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL vector_t
+vector_blend(const vector_t v0, const vector_t v1, const unsigned int mask) {
+	//Constant mask folds to a constant selection vector
+	const __m128i lanes = _mm_setr_epi32(-(int)(mask & 1), -(int)((mask >> 1) & 1),
+	                                     -(int)((mask >> 2) & 1), -(int)((mask >> 3) & 1));
+	return vector_select(_mm_castsi128_ps(lanes), v1, v0);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL unsigned int
+vector_movemask(const vector_t v) {
+	return (unsigned int)_mm_movemask_ps(v);
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_any(const vector_t mask) {
+	return _mm_movemask_ps(mask) != 0;
+}
+
+static FOUNDATION_FORCEINLINE FOUNDATION_CONSTCALL bool
+vector_all(const vector_t mask) {
+	return (unsigned int)_mm_movemask_ps(mask) == VECTOR_LANES_ALL;
 }
 
@@ -16,6 +16,9 @@
 
 
 #include <smmintrin.h>
+#if FOUNDATION_ARCH_SSE4_FMA3
+#include <immintrin.h>
+#endif
 
 //Index for shuffle must be constant integer - hide function with a define
 vector_t vector_shuffle( const vector_t v, unsigned int mask ) {
@@ -26,6 +29,15 @@ vector_t vector_shuffle( const vector_t v, unsigned int mask ) {
 }
 #define vector_shuffle( v, mask ) _mm_shuffle_ps( v, v, mask )
 
+//Blend mask must be constant integer - hide function with a define
+vector_t vector_blend( const vector_t v0, const vector_t v1, unsigned int mask ) {
+	FOUNDATION_ASSERT_FAIL("Unreachable code");
+	FOUNDATION_UNUSED(v1);
+	FOUNDATION_UNUSED(mask);
+	return v0;
+}
+#define vector_blend( v0, v1, mask ) _mm_blend_ps( v0, v1, mask )
+
 vector_t vector( real x, real y, real z, real w ) {
 	return _mm_setr_ps( x, y, z, w );
 }
@@ -76,7 +88,7 @@ vector_t vector_two( void )
 
 vector_t vector_origo( void )
 {
-	static const float32_t ALIGN(16) origo[] = { 0, 0, 0, 1 };
+	static const float32_t VECTOR_ALIGN origo[] = { 0, 0, 0, 1 };
 	return vector_aligned( origo );
 }
 
@@ -104,25 +116,39 @@ vector_t vector_zaxis( void )
 
 vector_t vector_normalize( const vector_t v )
 {
-	return vector_mul( v, _mm_rsqrt_ps( _mm_dp_ps( v, v, 0xFF ) ) );
+	return vector_mul( v, VECTOR_RSQRT_PS( vector_dot( v, v ) ) );
 }
 
 
 vector_t vector_normalize3( const vector_t v )
 {
-	return vector_mul( v, _mm_rsqrt_ps( _mm_dp_ps( v, v, 0x77 ) ) );
+	//Blend to preserve w component of input vector
+	const vector_t norm = vector_mul( v, VECTOR_RSQRT_PS( vector_dot3( v, v ) ) );
+	return _mm_blend_ps( norm, v, 8 );
 }
 
 
 vector_t vector_dot( const vector_t v0, const vector_t v1 )
 {
+#if VECTOR_DETERMINISTIC
+	//Internal rounding of dpps is not specified, use the same summation order as the other backends
+	const vector_t r = _mm_mul_ps( v0, v1 );
+	const vector_t rp = _mm_hadd_ps( r, r );
+	return _mm_hadd_ps( rp, rp );
+#else
 	return _mm_dp_ps( v0, v1, 0xFF );
+#endif
 }
 
 
 vector_t vector_dot3( const vector_t v0, const vector_t v1 )
 {
-	return _mm_dp_ps( v0, v1, 0x77 );
+#if VECTOR_DETERMINISTIC
+	const vector_t r = _mm_mul_ps( v0, v1 );
+	return _mm_add_ps( _mm_add_ps( vector_shuffle( r, VECTOR_MASK_XXXX ), vector_shuffle( r, VECTOR_MASK_YYYY ) ), vector_shuffle( r, VECTOR_MASK_ZZZZ ) );
+#else
+	return _mm_dp_ps( v0, v1, 0x7F );
+#endif
 }
 
 
@@ -132,7 +158,7 @@ vector_t vector_cross3( const vector_t v0, const vector_t v1 )
 	vector_t v1yzx = vector_shuffle( v1, VECTOR_MASK_YZXW );
 	vector_t v0zxy = vector_shuffle( v0, VECTOR_MASK_ZXYW );
 	vector_t v1zxy = vector_shuffle( v1, VECTOR_MASK_ZXYW );
-#if FOUNDATION_ARCH_SSE4_FMA3
+#if FOUNDATION_ARCH_SSE4_FMA3 && !VECTOR_DETERMINISTIC
 	vector_t interm = vector_mul( v0yzx, v1zxy );
 	return _mm_fnmadd_ps( v0zxy, v1yzx, interm );
 #else
@@ -167,13 +193,13 @@ vector_t vector_sub( const vector_t v0, const vector_t v1 )
 
 vector_t vector_neg( const vector_t v )
 {
-	return _mm_sub_ps( _mm_setzero_ps(), v );
+	return _mm_xor_ps( v, _mm_castsi128_ps( _mm_set1_epi32( (int)0x80000000 ) ) );
 }
 
 
 vector_t vector_muladd( const vector_t v0, const vector_t v1, const vector_t v2 )
 {
-#if FOUNDATION_ARCH_SSE4_FMA3
+#if FOUNDATION_ARCH_SSE4_FMA3 && !VECTOR_DETERMINISTIC
 	return _mm_fmadd_ps( v0, v1, v2);
 #else
 	return vector_add( vector_mul( v0, v1 ), v2 );
@@ -190,7 +216,7 @@ vector_t vector_scale( const vector_t v, const real s )
 vector_t vector_lerp( const vector_t from, const vector_t to, const real factor )
 {
 	vector_t s = _mm_set1_ps( factor );
-#if FOUNDATION_ARCH_SSE4_FMA3
+#if FOUNDATION_ARCH_SSE4_FMA3 && !VECTOR_DETERMINISTIC
 	return _mm_fmadd_ps( to, s, _mm_fnmadd_ps( from, s, from ) );
 #else
 	return _mm_add_ps( _mm_mul_ps( s, to ), _mm_sub_ps( from, _mm_mul_ps( s, from ) ) );
@@ -216,7 +242,7 @@ vector_t vector_reflect( const vector_t v, const vector_t at )
 
 vector_t vector_project3( const vector_t v, const vector_t at )
 {
-	const vector_t normal = vector_mul( at, _mm_rsqrt_ps( vector_dot3( at, at ) ) );
+	const vector_t normal = vector_mul( at, VECTOR_RSQRT_PS( vector_dot3( at, at ) ) );
 	const vector_t result = vector_mul( normal, vector_dot3( normal, v ) );
 	return _mm_blend_ps( result, v, 8 );
 }
@@ -234,14 +260,14 @@ vector_t vector_reflect3( const vector_t v, const vector_t at )
 
 vector_t vector_length( const vector_t v )
 {
-	const vector_t vsqrt = _mm_sqrt_ss( _mm_dp_ps( v, v, 0xFF ) );
+	const vector_t vsqrt = _mm_sqrt_ss( vector_dot( v, v ) );
 	return vector_shuffle( vsqrt, VECTOR_MASK_XXXX );
 }
 
 
 vector_t vector_length_fast( const vector_t v )
 {
-	const vector_t vsqrt = _mm_sqrt_ss( _mm_dp_ps( v, v, 0xFF ) );
+	const vector_t vsqrt = _mm_sqrt_ss( vector_dot( v, v ) );
 	return vector_shuffle( vsqrt, VECTOR_MASK_XXXX );
 }
 
@@ -254,14 +280,14 @@ vector_t vector_length_sqr( const vector_t v )
 
 vector_t vector_length3( const vector_t v )
 {
-	const vector_t vsqrt = _mm_sqrt_ss( _mm_dp_ps( v, v, 0x77 ) );
+	const vector_t vsqrt = _mm_sqrt_ss( vector_dot3( v, v ) );
 	return vector_shuffle( vsqrt, VECTOR_MASK_XXXX );
 }
 
 
 vector_t vector_length3_fast( const vector_t v )
 {
-	const vector_t vsqrt = _mm_sqrt_ss( _mm_dp_ps( v, v, 0x77 ) );
+	const vector_t vsqrt = _mm_sqrt_ss( vector_dot3( v, v ) );
 	return vector_shuffle( vsqrt, VECTOR_MASK_XXXX );
 }
 
@@ -284,6 +310,12 @@ vector_t vector_max( const vector_t v0, const vector_t v1 )
 }
 
 
+vector_t vector_abs( const vector_t v )
+{
+	return _mm_and_ps( v, _mm_castsi128_ps( _mm_set1_epi32( 0x7FFFFFFF ) ) );
+}
+
+
 real vector_x( const vector_t v )
 {
 	return *(const float32_t*)&v;
@@ -311,7 +343,158 @@ real vector_component( const vector_t v, int c )
 }
 
 
+unsigned int vector_equal_exact_lanes( const vector_t v0, const vector_t v1 )
+{
+	return (unsigned int)_mm_movemask_ps( _mm_cmpeq_ps( v0, v1 ) );
+}
+
+
+unsigned int vector_equal_abs_lanes( const vector_t v0, const vector_t v1, const real epsilon )
+{
+	//Exact compare keeps equal infinities equal
+	const vector_t diff = vector_abs( _mm_sub_ps( v0, v1 ) );
+	return (unsigned int)_mm_movemask_ps( _mm_or_ps( _mm_cmpeq_ps( v0, v1 ), _mm_cmple_ps( diff, _mm_set1_ps( epsilon ) ) ) );
+}
+
+
+unsigned int vector_equal_rel_lanes( const vector_t v0, const vector_t v1, const real tolerance )
+{
+	const vector_t diff = vector_abs( _mm_sub_ps( v0, v1 ) );
+	const vector_t scale = _mm_max_ps( vector_abs( v0 ), vector_abs( v1 ) );
+	return (unsigned int)_mm_movemask_ps( _mm_or_ps( _mm_cmpeq_ps( v0, v1 ), _mm_cmple_ps( diff, _mm_mul_ps( scale, _mm_set1_ps( tolerance ) ) ) ) );
+}
+
+
+unsigned int vector_equal_ulps_lanes( const vector_t v0, const vector_t v1, int ulps )
+{
+	//Map bit patterns to integers ordered like the values (negative values mirrored below zero)
+	//and take the distance as an unsigned value. SSE4.1 unsigned max gives the unsigned compare,
+	//NaN is detected from the bits and not affected by fast math compiler flags
+	const __m128i sign = _mm_set1_epi32( (int)0x80000000 );
+	const __m128i exponent = _mm_set1_epi32( 0x7F800000 );
+	const __m128i limit = _mm_set1_epi32( ulps );
+	const __m128i i0 = _mm_castps_si128( v0 );
+	const __m128i i1 = _mm_castps_si128( v1 );
+	const __m128i mag0 = _mm_andnot_si128( sign, i0 );
+	const __m128i mag1 = _mm_andnot_si128( sign, i1 );
+	const __m128i ord0 = _mm_sign_epi32( mag0, _mm_or_si128( i0, _mm_set1_epi32( 1 ) ) );
+	const __m128i ord1 = _mm_sign_epi32( mag1, _mm_or_si128( i1, _mm_set1_epi32( 1 ) ) );
+	const __m128i dist = _mm_sub_epi32( _mm_max_epi32( ord0, ord1 ), _mm_min_epi32( ord0, ord1 ) );
+	const __m128i within = _mm_cmpeq_epi32( _mm_max_epu32( dist, limit ), limit );
+	const __m128i nan = _mm_or_si128( _mm_cmpgt_epi32( mag0, exponent ), _mm_cmpgt_epi32( mag1, exponent ) );
+	return (unsigned int)_mm_movemask_ps( _mm_castsi128_ps( _mm_andnot_si128( nan, within ) ) );
+}
+
+
+bool vector_equal_exact( const vector_t v0, const vector_t v1 )
+{
+	return vector_equal_exact_lanes( v0, v1 ) == VECTOR_LANES_ALL;
+}
+
+
+bool vector_equal_abs( const vector_t v0, const vector_t v1, const real epsilon )
+{
+	return vector_equal_abs_lanes( v0, v1, epsilon ) == VECTOR_LANES_ALL;
+}
+
+
+bool vector_equal_rel( const vector_t v0, const vector_t v1, const real tolerance )
+{
+	return vector_equal_rel_lanes( v0, v1, tolerance ) == VECTOR_LANES_ALL;
+}
+
+
+bool vector_equal_ulps( const vector_t v0, const vector_t v1, int ulps )
+{
+	return vector_equal_ulps_lanes( v0, v1, ulps ) == VECTOR_LANES_ALL;
+}
+
+
 bool vector_equal( const vector_t v0, const vector_t v1 )
 {
-	return math_realeq( *(const float32_t*)&v0, *(const float32_t*)&v1, 100 ) && math_realeq( *((const float32_t*)&v0 + 1), *((const float32_t*)&v1 + 1), 100 ) && math_realeq( *((const float32_t*)&v0 + 2), *((const float32_t*)&v1 + 2), 100 ) && math_realeq( *((const float32_t*)&v0 + 3), *((const float32_t*)&v1 + 3), 100 );
+	return vector_equal_ulps_lanes( v0, v1, 100 ) == VECTOR_LANES_ALL;
+}
+
+
+vector_t vector_cmplt( const vector_t v0, const vector_t v1 )
+{
+	return _mm_cmplt_ps( v0, v1 );
+}
+
+
+vector_t vector_cmple( const vector_t v0, const vector_t v1 )
+{
+	return _mm_cmple_ps( v0, v1 );
+}
+
+
+vector_t vector_cmpeq( const vector_t v0, const vector_t v1 )
+{
+	return _mm_cmpeq_ps( v0, v1 );
+}
+
+
+vector_t vector_cmpneq( const vector_t v0, const vector_t v1 )
+{
+	return _mm_cmpneq_ps( v0, v1 );
+}
+
+
+vector_t vector_cmpgt( const vector_t v0, const vector_t v1 )
+{
+	return _mm_cmpgt_ps( v0, v1 );
+}
+
+
+vector_t vector_cmpge( const vector_t v0, const vector_t v1 )
+{
+	return _mm_cmpge_ps( v0, v1 );
+}
+
+
+vector_t vector_and( const vector_t v0, const vector_t v1 )
+{
+	return _mm_and_ps( v0, v1 );
+}
+
+
+vector_t vector_or( const vector_t v0, const vector_t v1 )
+{
+	return _mm_or_ps( v0, v1 );
+}
+
+
+vector_t vector_xor( const vector_t v0, const vector_t v1 )
+{
+	return _mm_xor_ps( v0, v1 );
+}
+
+
+vector_t vector_andnot( const vector_t v0, const vector_t v1 )
+{
+	return _mm_andnot_ps( v1, v0 );
+}
+
+
+vector_t vector_select( const vector_t mask, const vector_t v0, const vector_t v1 )
+{
+	return _mm_blendv_ps( v1, v0, mask );
+}
+
+
+unsigned int vector_movemask( const vector_t v )
+{
+	return (unsigned int)_mm_movemask_ps( v );
+}
+
+
+bool vector_any( const vector_t mask )
+{
+	return _mm_movemask_ps( mask ) != 0;
+}
+
+
+bool vector_all( const vector_t mask )
+{
+	return (unsigned int)_mm_movemask_ps( mask ) == VECTOR_LANES_ALL;
 }